@@ -0,0 +1,290 @@
+#include "Commands/UnrealMCPActorIndex.h"
+#include "Commands/UnrealMCPLevelEvents.h"
+#include "Algo/BinarySearch.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "UObject/UObjectGlobals.h"
+
+FUnrealMCPActorIndex::FUnrealMCPActorIndex()
+    : bStale(true)
+    , KeyEditsSinceLookup(0)
+    , bKeysDirty(true)
+    , bListening(false)
+{
+}
+
+FUnrealMCPActorIndex::~FUnrealMCPActorIndex()
+{
+    if (bListening)
+    {
+        FUnrealMCPLevelEvents::Get().RemoveListener(this);
+    }
+}
+
+void FUnrealMCPActorIndex::StartListening()
+{
+    if (!bListening)
+    {
+        bListening = FUnrealMCPLevelEvents::Get().AddListener(this);
+    }
+}
+
+AActor* FUnrealMCPActorIndex::FindActor(UWorld* World, const FString& ActorName)
+{
+    check(IsInGameThread());
+    if (!World || ActorName.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    StartListening();
+    if (bStale || IndexedWorld.Get() != World)
+    {
+        Rebuild(World);
+    }
+
+    // A name that was never made into an FName can't belong to any actor
+    const FName Name(*ActorName, FNAME_Find);
+    if (Name.IsNone())
+    {
+        return nullptr;
+    }
+
+    bool bFoundStale = false;
+    AActor* Actor = FindIndexedActor(Name, bFoundStale);
+    if (!Actor && bFoundStale)
+    {
+        // An entry went out of date without a notification, don't trust the rest of the index either
+        Rebuild(World);
+        Actor = FindIndexedActor(Name, bFoundStale);
+    }
+    return Actor;
+}
+
+void FUnrealMCPActorIndex::ForEachWithPrefix(UWorld* World, const FString& Prefix, bool bNames, bool bLabels, TFunctionRef<bool(AActor*)> Visitor)
+{
+    check(IsInGameThread());
+    if (!World)
+    {
+        return;
+    }
+
+    StartListening();
+    if (bStale || IndexedWorld.Get() != World)
+    {
+        Rebuild(World);
+    }
+    if (bKeysDirty)
+    {
+        SortKeys();
+    }
+    KeyEditsSinceLookup = 0;
+
+    const FString LowerPrefix = Prefix.ToLower();
+    int32 Index = Algo::LowerBoundBy(SortedKeys, LowerPrefix, &FSortedKey::Key);
+    for (; Index < SortedKeys.Num() && SortedKeys[Index].Key.StartsWith(LowerPrefix, ESearchCase::CaseSensitive); ++Index)
+    {
+        const FSortedKey& Entry = SortedKeys[Index];
+        if (Entry.bLabel ? !bLabels : !bNames)
+        {
+            continue;
+        }
+
+        // A key may be out of date if a notification was missed, the list is rebuilt on the next lookup
+        AActor* Actor = Entry.Actor.Get();
+        if (!IsValid(Actor) || Actor->GetWorld() != World)
+        {
+            continue;
+        }
+        const FString CurrentKey = Entry.bLabel ? Actor->GetActorLabel() : Actor->GetName();
+        if (!CurrentKey.StartsWith(Prefix, ESearchCase::IgnoreCase))
+        {
+            bKeysDirty = true;
+            continue;
+        }
+
+        if (!Visitor(Actor))
+        {
+            return;
+        }
+    }
+}
+
+namespace UnrealMCPActorIndex
+{
+    /** Lowercase name and label keys of an actor, the label is left empty when it matches the name */
+    static void MakeKeys(const AActor* Actor, FString& OutNameKey, FString& OutLabelKey)
+    {
+        const FString Name = Actor->GetName();
+        OutNameKey = Name.ToLower();
+
+        // Labels default to the name, only list the ones that differ
+        const FString Label = Actor->GetActorLabel();
+        OutLabelKey = !Label.IsEmpty() && !Label.Equals(Name, ESearchCase::IgnoreCase) ? Label.ToLower() : FString();
+    }
+}
+
+void FUnrealMCPActorIndex::SortKeys()
+{
+    SortedKeys.Reset(Actors.Num() * 2);
+    KeysByActor.Reset();
+    for (const TPair<FName, TWeakObjectPtr<AActor>>& Pair : Actors)
+    {
+        AActor* Actor = Pair.Value.Get();
+        if (!IsValid(Actor))
+        {
+            continue;
+        }
+
+        FActorKeys& Keys = KeysByActor.Add(Actor);
+        UnrealMCPActorIndex::MakeKeys(Actor, Keys.NameKey, Keys.LabelKey);
+        SortedKeys.Add({ Keys.NameKey, Actor, false });
+        if (!Keys.LabelKey.IsEmpty())
+        {
+            SortedKeys.Add({ Keys.LabelKey, Actor, true });
+        }
+    }
+    SortedKeys.Sort([](const FSortedKey& A, const FSortedKey& B) { return A.Key < B.Key; });
+    bKeysDirty = false;
+}
+
+bool FUnrealMCPActorIndex::TrackKeyEdit()
+{
+    // Each in-place edit moves the entries after it, a burst of them costs more than one sort
+    static const int32 MaxKeyEditsBetweenLookups = 64;
+    if (++KeyEditsSinceLookup > MaxKeyEditsBetweenLookups)
+    {
+        bKeysDirty = true;
+        SortedKeys.Reset();
+        KeysByActor.Reset();
+        return false;
+    }
+    return true;
+}
+
+void FUnrealMCPActorIndex::AddKeys(AActor* Actor)
+{
+    if (bKeysDirty || !IsValid(Actor) || KeysByActor.Contains(Actor) || !TrackKeyEdit())
+    {
+        return;
+    }
+
+    FActorKeys& Keys = KeysByActor.Add(Actor);
+    UnrealMCPActorIndex::MakeKeys(Actor, Keys.NameKey, Keys.LabelKey);
+    SortedKeys.Insert({ Keys.NameKey, Actor, false }, Algo::UpperBoundBy(SortedKeys, Keys.NameKey, &FSortedKey::Key));
+    if (!Keys.LabelKey.IsEmpty())
+    {
+        SortedKeys.Insert({ Keys.LabelKey, Actor, true }, Algo::UpperBoundBy(SortedKeys, Keys.LabelKey, &FSortedKey::Key));
+    }
+}
+
+void FUnrealMCPActorIndex::RemoveKeys(AActor* Actor)
+{
+    FActorKeys Keys;
+    if (bKeysDirty || !KeysByActor.RemoveAndCopyValue(Actor, Keys) || !TrackKeyEdit())
+    {
+        return;
+    }
+
+    auto RemoveKey = [this, Actor](const FString& Key)
+    {
+        // Several actors can share a key, search just the run of entries that have it
+        const int32 End = Algo::UpperBoundBy(SortedKeys, Key, &FSortedKey::Key);
+        for (int32 Index = Algo::LowerBoundBy(SortedKeys, Key, &FSortedKey::Key); Index < End; ++Index)
+        {
+            if (SortedKeys[Index].Actor == Actor)
+            {
+                SortedKeys.RemoveAt(Index, 1, EAllowShrinking::No);
+                return;
+            }
+        }
+    };
+    RemoveKey(Keys.NameKey);
+    if (!Keys.LabelKey.IsEmpty())
+    {
+        RemoveKey(Keys.LabelKey);
+    }
+}
+
+AActor* FUnrealMCPActorIndex::FindIndexedActor(FName Name, bool& bOutFoundStale) const
+{
+    bOutFoundStale = false;
+    for (auto It = Actors.CreateConstKeyIterator(Name); It; ++It)
+    {
+        AActor* Actor = It.Value().Get();
+        if (IsValid(Actor) && Actor->GetFName() == Name && Actor->GetWorld() == IndexedWorld.Get())
+        {
+            return Actor;
+        }
+        bOutFoundStale = true;
+    }
+    return nullptr;
+}
+
+void FUnrealMCPActorIndex::Rebuild(UWorld* World)
+{
+    Actors.Reset();
+    IndexedWorld = World;
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        Actors.Add(It->GetFName(), *It);
+    }
+    bStale = false;
+    bKeysDirty = true;
+    UE_LOG(LogTemp, Verbose, TEXT("UnrealMCPActorIndex: Indexed %d actors"), Actors.Num());
+}
+
+void FUnrealMCPActorIndex::OnActorAdded(AActor* Actor)
+{
+    if (!bStale && Actor && Actor->GetWorld() == IndexedWorld.Get())
+    {
+        Actors.AddUnique(Actor->GetFName(), Actor);
+        AddKeys(Actor);
+    }
+}
+
+void FUnrealMCPActorIndex::OnActorDeleted(AActor* Actor)
+{
+    if (!bStale && Actor)
+    {
+        Actors.RemoveSingle(Actor->GetFName(), Actor);
+        RemoveKeys(Actor);
+    }
+}
+
+void FUnrealMCPActorIndex::OnObjectRenamed(UObject* Object, UObject* OldOuter, FName OldName)
+{
+    AActor* Actor = Cast<AActor>(Object);
+    if (bStale || !Actor)
+    {
+        return;
+    }
+
+    Actors.RemoveSingle(OldName, Actor);
+    RemoveKeys(Actor);
+    if (Actor->GetWorld() == IndexedWorld.Get())
+    {
+        Actors.AddUnique(Actor->GetFName(), Actor);
+        AddKeys(Actor);
+    }
+}
+
+void FUnrealMCPActorIndex::OnActorLabelChanged(AActor* Actor)
+{
+    if (bStale || !Actor)
+    {
+        return;
+    }
+
+    RemoveKeys(Actor);
+    if (Actor->GetWorld() == IndexedWorld.Get())
+    {
+        AddKeys(Actor);
+    }
+}
+
+void FUnrealMCPActorIndex::OnLevelReset()
+{
+    bStale = true;
+}
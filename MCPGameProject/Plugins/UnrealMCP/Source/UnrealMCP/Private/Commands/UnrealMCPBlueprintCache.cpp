@@ -0,0 +1,275 @@
+#include "Commands/UnrealMCPBlueprintCache.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "EdGraph/EdGraph.h"
+#include "Engine/Blueprint.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/PackageReload.h"
+#include "UObject/UObjectGlobals.h"
+
+FUnrealMCPBlueprintCache& FUnrealMCPBlueprintCache::Get()
+{
+    static FUnrealMCPBlueprintCache Instance;
+    return Instance;
+}
+
+FUnrealMCPBlueprintCache::FUnrealMCPBlueprintCache()
+    : NextHandle(1)
+    , bDelegatesBound(false)
+{
+}
+
+void FUnrealMCPBlueprintCache::BindDelegates()
+{
+    if (bDelegatesBound)
+    {
+        return;
+    }
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FUnrealMCPBlueprintCache::HandleAssetAdded);
+    AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FUnrealMCPBlueprintCache::HandleAssetRemoved);
+    AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FUnrealMCPBlueprintCache::HandleAssetRenamed);
+    PackageReloadedHandle = FCoreUObjectDelegates::OnPackageReloaded.AddRaw(this, &FUnrealMCPBlueprintCache::HandlePackageReloaded);
+    bDelegatesBound = true;
+}
+
+void FUnrealMCPBlueprintCache::UnbindDelegates()
+{
+    if (!bDelegatesBound)
+    {
+        return;
+    }
+
+    if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+    {
+        AssetRegistryModule->Get().OnAssetAdded().Remove(AssetAddedHandle);
+        AssetRegistryModule->Get().OnAssetRemoved().Remove(AssetRemovedHandle);
+        AssetRegistryModule->Get().OnAssetRenamed().Remove(AssetRenamedHandle);
+    }
+    FCoreUObjectDelegates::OnPackageReloaded.Remove(PackageReloadedHandle);
+    bDelegatesBound = false;
+}
+
+void FUnrealMCPBlueprintCache::Reset()
+{
+    UnbindDelegates();
+    Names.Reset();
+    Handles.Reset();
+    HandleOf.Reset();
+    Graphs.Reset();
+}
+
+UBlueprint* FUnrealMCPBlueprintCache::FindByHandle(const FString& Handle) const
+{
+    check(IsInGameThread());
+    const TWeakObjectPtr<UBlueprint>* Blueprint = Handles.Find(Handle);
+    return Blueprint ? Blueprint->Get() : nullptr;
+}
+
+FString FUnrealMCPBlueprintCache::GetHandle(UBlueprint* Blueprint)
+{
+    check(IsInGameThread());
+    if (!Blueprint)
+    {
+        return FString();
+    }
+
+    BindDelegates();
+    if (const FString* Existing = HandleOf.Find(Blueprint))
+    {
+        return *Existing;
+    }
+
+    const FString Handle = FString::Printf(TEXT("bp#%d"), NextHandle++);
+    Handles.Add(Handle, Blueprint);
+    HandleOf.Add(Blueprint, Handle);
+    return Handle;
+}
+
+UBlueprint* FUnrealMCPBlueprintCache::FindByName(const FString& Name)
+{
+    check(IsInGameThread());
+    const TWeakObjectPtr<UBlueprint>* Cached = Names.Find(Name);
+    if (!Cached)
+    {
+        return nullptr;
+    }
+
+    UBlueprint* Blueprint = Cached->Get();
+    if (!Blueprint)
+    {
+        Names.Remove(Name);
+    }
+    return Blueprint;
+}
+
+void FUnrealMCPBlueprintCache::AddName(const FString& Name, UBlueprint* Blueprint)
+{
+    check(IsInGameThread());
+    if (!Blueprint)
+    {
+        return;
+    }
+
+    BindDelegates();
+    Names.Add(Name, Blueprint);
+}
+
+UEdGraph* FUnrealMCPBlueprintCache::FindGraph(UBlueprint* Blueprint, const FString& GraphName)
+{
+    check(IsInGameThread());
+    TMap<FString, TWeakObjectPtr<UEdGraph>>* BlueprintGraphs = Graphs.Find(Blueprint);
+    const TWeakObjectPtr<UEdGraph>* Cached = BlueprintGraphs ? BlueprintGraphs->Find(GraphName) : nullptr;
+    if (!Cached)
+    {
+        return nullptr;
+    }
+
+    // Graphs are renamed and removed without an asset notification, so check the entry still holds
+    UEdGraph* Graph = Cached->Get();
+    if (!Graph || Graph->GetName() != GraphName || Graph->GetTypedOuter<UBlueprint>() != Blueprint)
+    {
+        BlueprintGraphs->Remove(GraphName);
+        return nullptr;
+    }
+    return Graph;
+}
+
+void FUnrealMCPBlueprintCache::AddGraph(UBlueprint* Blueprint, const FString& GraphName, UEdGraph* Graph)
+{
+    check(IsInGameThread());
+    if (!Blueprint || !Graph)
+    {
+        return;
+    }
+
+    BindDelegates();
+    Graphs.FindOrAdd(Blueprint).Add(GraphName, Graph);
+}
+
+void FUnrealMCPBlueprintCache::Forget(const FString& ObjectPath)
+{
+    for (auto It = Names.CreateIterator(); It; ++It)
+    {
+        const UBlueprint* Blueprint = It.Value().Get();
+        if (!Blueprint || Blueprint->GetPathName() == ObjectPath)
+        {
+            It.RemoveCurrent();
+        }
+    }
+    for (auto It = Graphs.CreateIterator(); It; ++It)
+    {
+        const UBlueprint* Blueprint = It.Key().Get();
+        if (!Blueprint || Blueprint->GetPathName() == ObjectPath)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+namespace UnrealMCPBlueprintCache
+{
+    /** Asset name a cached name, path or object path refers to, e.g. BP_Door for /Game/Doors/BP_Door.BP_Door */
+    static FStringView GetAssetNamePart(const FString& Name)
+    {
+        FStringView View(Name);
+        int32 SlashIndex = INDEX_NONE;
+        if (View.FindLastChar(TEXT('/'), SlashIndex))
+        {
+            View.RightChopInline(SlashIndex + 1);
+        }
+        int32 DotIndex = INDEX_NONE;
+        if (View.FindChar(TEXT('.'), DotIndex))
+        {
+            View.LeftInline(DotIndex);
+        }
+        return View;
+    }
+}
+
+void FUnrealMCPBlueprintCache::HandleAssetAdded(const FAssetData& AssetData)
+{
+    // Only another Blueprint can take a name, and the registry adds every asset it scans
+    if (Names.IsEmpty() || !AssetData.IsInstanceOf(UBlueprint::StaticClass()))
+    {
+        return;
+    }
+
+    // A second Blueprint with a remembered name may make that name ambiguous, so let it be resolved again
+    const FString AssetName = AssetData.AssetName.ToString();
+    for (auto It = Names.CreateIterator(); It; ++It)
+    {
+        if (UnrealMCPBlueprintCache::GetAssetNamePart(It.Key()).Equals(AssetName, ESearchCase::IgnoreCase))
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void FUnrealMCPBlueprintCache::HandleAssetRemoved(const FAssetData& AssetData)
+{
+    const FString ObjectPath = AssetData.GetObjectPathString();
+    Forget(ObjectPath);
+
+    // A deleted Blueprint's handle must not come back to life if an asset of the same name is created
+    if (UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.FastGetAsset(false)))
+    {
+        FString Handle;
+        if (HandleOf.RemoveAndCopyValue(Blueprint, Handle))
+        {
+            Handles.Remove(Handle);
+        }
+    }
+}
+
+void FUnrealMCPBlueprintCache::HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+    // The Blueprint object is already renamed, so its name entries now point at a different path than their key.
+    // Handles follow the object and stay valid.
+    Forget(AssetData.GetObjectPathString());
+    Forget(OldObjectPath);
+}
+
+void FUnrealMCPBlueprintCache::HandlePackageReloaded(EPackageReloadPhase Phase, FPackageReloadedEvent* Event)
+{
+    if (Phase != EPackageReloadPhase::PostPackageFixup || !Event)
+    {
+        return;
+    }
+
+    // Point names and handles at the reloaded Blueprints, the graphs are new objects and are looked up again
+    for (const TPair<UObject*, UObject*>& Repointed : Event->GetRepointedObjects())
+    {
+        UBlueprint* OldBlueprint = Cast<UBlueprint>(Repointed.Key);
+        if (!OldBlueprint)
+        {
+            continue;
+        }
+        UBlueprint* NewBlueprint = Cast<UBlueprint>(Repointed.Value);
+
+        for (TPair<FString, TWeakObjectPtr<UBlueprint>>& Entry : Names)
+        {
+            if (Entry.Value.Get(true) == OldBlueprint)
+            {
+                Entry.Value = NewBlueprint;
+            }
+        }
+
+        FString Handle;
+        if (HandleOf.RemoveAndCopyValue(OldBlueprint, Handle))
+        {
+            if (NewBlueprint)
+            {
+                Handles.Add(Handle, NewBlueprint);
+                HandleOf.Add(NewBlueprint, Handle);
+            }
+            else
+            {
+                Handles.Remove(Handle);
+            }
+        }
+
+        Graphs.Remove(OldBlueprint);
+    }
+}
@@ -1,5 +1,8 @@
 #include "Commands/UnrealMCPBlueprintCommands.h"
+#include "Commands/UnrealMCPBlueprintCache.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "Commands/UnrealMCPCompileScheduler.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
 #include "Factories/BlueprintFactory.h"
@@ -18,6 +21,10 @@
 #include "UObject/FieldPath.h"
 #include "EditorAssetLibrary.h"
 #include "AssetRegistry/AssetRegistryModule.h"
+#include "BlueprintCompilationManager.h"
+#include "Kismet2/CompilerResultsLog.h"
+#include "Logging/TokenizedMessage.h"
+#include "HAL/PlatformTime.h"
 #include "GameFramework/Actor.h"
 #include "GameFramework/Pawn.h"
 
@@ -25,46 +32,20 @@ FUnrealMCPBlueprintCommands::FUnrealMCPBlueprintCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+void FUnrealMCPBlueprintCommands::RegisterCommands(FUnrealMCPCommandRegistry& Registry)
 {
-    if (CommandType == TEXT("create_blueprint"))
-    {
-        return HandleCreateBlueprint(Params);
-    }
-    else if (CommandType == TEXT("add_component_to_blueprint"))
-    {
-        return HandleAddComponentToBlueprint(Params);
-    }
-    else if (CommandType == TEXT("set_component_property"))
-    {
-        return HandleSetComponentProperty(Params);
-    }
-    else if (CommandType == TEXT("set_physics_properties"))
-    {
-        return HandleSetPhysicsProperties(Params);
-    }
-    else if (CommandType == TEXT("compile_blueprint"))
-    {
-        return HandleCompileBlueprint(Params);
-    }
-    else if (CommandType == TEXT("set_blueprint_property"))
-    {
-        return HandleSetBlueprintProperty(Params);
-    }
-    else if (CommandType == TEXT("set_static_mesh_properties"))
-    {
-        return HandleSetStaticMeshProperties(Params);
-    }
-    else if (CommandType == TEXT("set_pawn_properties"))
-    {
-        return HandleSetPawnProperties(Params);
-    }
-    else if (CommandType == TEXT("add_function_to_blueprint"))
-    {
-        return HandleAddFunctionToBlueprint(Params);
-    }
-    
-    return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown blueprint command: %s"), *CommandType));
+    const FString Category = TEXT("blueprint");
+
+    Registry.Register(TEXT("create_blueprint"), Category, TEXT("Create a new Blueprint class"), this, &FUnrealMCPBlueprintCommands::HandleCreateBlueprint);
+    Registry.Register(TEXT("add_component_to_blueprint"), Category, TEXT("Add a component to a Blueprint"), this, &FUnrealMCPBlueprintCommands::HandleAddComponentToBlueprint);
+    Registry.Register(TEXT("set_component_property"), Category, TEXT("Set a property on a Blueprint component"), this, &FUnrealMCPBlueprintCommands::HandleSetComponentProperty);
+    Registry.Register(TEXT("set_physics_properties"), Category, TEXT("Configure physics on a Blueprint component"), this, &FUnrealMCPBlueprintCommands::HandleSetPhysicsProperties);
+    Registry.Register(TEXT("compile_blueprint"), Category, TEXT("Compile a Blueprint"), this, &FUnrealMCPBlueprintCommands::HandleCompileBlueprint);
+    Registry.Register(TEXT("compile_blueprints"), Category, TEXT("Compile a list or path pattern of Blueprints in dependency order"), this, &FUnrealMCPBlueprintCommands::HandleCompileBlueprints);
+    Registry.Register(TEXT("set_blueprint_property"), Category, TEXT("Set a property on a Blueprint class default object"), this, &FUnrealMCPBlueprintCommands::HandleSetBlueprintProperty);
+    Registry.Register(TEXT("set_static_mesh_properties"), Category, TEXT("Set the mesh and material of a static mesh component"), this, &FUnrealMCPBlueprintCommands::HandleSetStaticMeshProperties);
+    Registry.Register(TEXT("set_pawn_properties"), Category, TEXT("Configure Pawn settings on a Blueprint"), this, &FUnrealMCPBlueprintCommands::HandleSetPawnProperties);
+    Registry.Register(TEXT("add_function_to_blueprint"), Category, TEXT("Add a function graph with inputs and outputs to a Blueprint"), this, &FUnrealMCPBlueprintCommands::HandleAddFunctionToBlueprint);
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleCreateBlueprint(const TSharedPtr<FJsonObject>& Params)
@@ -161,6 +142,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleCreateBlueprint(const
         TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
         ResultObj->SetStringField(TEXT("name"), AssetName);
         ResultObj->SetStringField(TEXT("path"), PackagePath + AssetName);
+        ResultObj->SetStringField(TEXT("handle"), FUnrealMCPBlueprintCache::Get().GetHandle(NewBlueprint));
         return ResultObj;
     }
 
@@ -189,10 +171,11 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleAddComponentToBluepri
     }
 
     // Find the blueprint
-    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
+    FString FindError;
+    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName, FindError);
     if (!Blueprint)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FindError);
     }
 
     // Create the component - dynamically find the component class by name
@@ -253,8 +236,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleAddComponentToBluepri
         // Add to root if no parent specified
         Blueprint->SimpleConstructionScript->AddNode(NewNode);
 
-        // Compile the blueprint
-        FKismetEditorUtilities::CompileBlueprint(Blueprint);
+        FUnrealMCPCompileScheduler::Get().RequestCompile(Blueprint);
 
         TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
         ResultObj->SetStringField(TEXT("component_name"), ComponentName);
@@ -314,11 +296,12 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetComponentProperty(
     }
 
     // Find the blueprint
-    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
+    FString FindError;
+    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName, FindError);
     if (!Blueprint)
     {
         UE_LOG(LogTemp, Error, TEXT("SetComponentProperty - Blueprint not found: %s"), *BlueprintName);
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FindError);
     }
     else
     {
@@ -770,10 +753,11 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetPhysicsProperties(
     }
 
     // Find the blueprint
-    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
+    FString FindError;
+    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName, FindError);
     if (!Blueprint)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FindError);
     }
 
     // Find the component
@@ -840,14 +824,15 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleCompileBlueprint(cons
     }
 
     // Find the blueprint
-    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
+    FString FindError;
+    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName, FindError);
     if (!Blueprint)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FindError);
     }
 
-    // Compile the blueprint
-    FKismetEditorUtilities::CompileBlueprint(Blueprint);
+    // Compile the blueprint, whether or not earlier edits left it pending
+    FUnrealMCPCompileScheduler::Get().CompileNow(Blueprint);
 
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetStringField(TEXT("name"), BlueprintName);
@@ -871,13 +856,15 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetBlueprintProperty(
     }
 
     // Find the blueprint
-    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
+    FString FindError;
+    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName, FindError);
     if (!Blueprint)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FindError);
     }
 
     // Get the default object
+    FUnrealMCPCompileScheduler::Get().EnsureCompiled(Blueprint);
     UObject* DefaultObject = Blueprint->GeneratedClass->GetDefaultObject();
     if (!DefaultObject)
     {
@@ -925,10 +912,11 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetStaticMeshProperti
     }
 
     // Find the blueprint
-    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
+    FString FindError;
+    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName, FindError);
     if (!Blueprint)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FindError);
     }
 
     // Find the component
@@ -992,13 +980,15 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleSetPawnProperties(con
     }
 
     // Find the blueprint
-    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
+    FString FindError;
+    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName, FindError);
     if (!Blueprint)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FindError);
     }
 
     // Get the default object
+    FUnrealMCPCompileScheduler::Get().EnsureCompiled(Blueprint);
     UObject* DefaultObject = Blueprint->GeneratedClass->GetDefaultObject();
     if (!DefaultObject)
     {
@@ -1118,10 +1108,11 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleAddFunctionToBlueprin
         return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'blueprint_name' parameter"));
     }
     // Find the blueprint
-    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
+    FString FindError;
+    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName, FindError);
     if (!Blueprint)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FindError);
     }
     if (!Params->TryGetStringField(TEXT("function_name"), FunctionName))
     {
@@ -1223,8 +1214,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleAddFunctionToBlueprin
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Failed to create function %s in blueprint %s"), *FunctionName, *BlueprintName));
     }
 
-    // Compile the blueprint
-    FKismetEditorUtilities::CompileBlueprint(Blueprint);
+    FUnrealMCPCompileScheduler::Get().RequestCompile(Blueprint);
 
     // Mark the blueprint as modified
     FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
@@ -1234,3 +1224,323 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleAddFunctionToBlueprin
     ResultObj->SetBoolField(TEXT("success"), true);
     return ResultObj;
 }
+
+namespace UnrealMCPBlueprintCompile
+{
+    /** Most Blueprints one compile_blueprints request may select */
+    static const int32 MaxBlueprints = 2000;
+
+    /**
+     * Load the Blueprints whose package path matches a pattern such as /Game/Generated/BP_*, or everything under a folder
+     * Nothing is loaded and false is returned when the matches would take OutBlueprints past MaxBlueprints.
+     */
+    static bool FindBlueprintsByPath(const FString& Pattern, TArray<UBlueprint*>& OutBlueprints, int32& OutNumMatched)
+    {
+        int32 WildcardIndex = INDEX_NONE;
+        for (int32 Index = 0; Index < Pattern.Len(); ++Index)
+        {
+            if (Pattern[Index] == TEXT('*') || Pattern[Index] == TEXT('?'))
+            {
+                WildcardIndex = Index;
+                break;
+            }
+        }
+
+        // Only search below the folder the pattern's fixed part names
+        FString Root = Pattern;
+        FString Wildcard = Pattern;
+        if (WildcardIndex == INDEX_NONE)
+        {
+            Root.RemoveFromEnd(TEXT("/"));
+            Wildcard = Root + TEXT("/*");
+        }
+        else
+        {
+            Root = Pattern.Left(WildcardIndex);
+            int32 SlashIndex = INDEX_NONE;
+            Root.FindLastChar(TEXT('/'), SlashIndex);
+            Root = SlashIndex > 0 ? Root.Left(SlashIndex) : TEXT("/Game");
+        }
+
+        FARFilter Filter;
+        Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+        Filter.bRecursiveClasses = true;
+        Filter.PackagePaths.Add(FName(*Root));
+        Filter.bRecursivePaths = true;
+
+        TArray<FAssetData> Assets;
+        FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry"));
+        AssetRegistryModule.Get().GetAssets(Filter, Assets);
+
+        // Match and count on the registry data, loading is what costs
+        Assets.RemoveAll([&Wildcard](const FAssetData& Asset) { return !Asset.PackageName.ToString().MatchesWildcard(Wildcard); });
+        OutNumMatched = Assets.Num();
+        if (OutBlueprints.Num() + Assets.Num() > MaxBlueprints)
+        {
+            return false;
+        }
+
+        Assets.Sort([](const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); });
+        for (const FAssetData& Asset : Assets)
+        {
+            if (UBlueprint* Blueprint = Cast<UBlueprint>(Asset.GetAsset()))
+            {
+                OutBlueprints.AddUnique(Blueprint);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Order Blueprints so each comes after the selected Blueprints it depends on
+     * Blueprints caught in a reference cycle keep their relative order and are returned in OutCycle.
+     */
+    static TArray<UBlueprint*> SortByDependencies(const TArray<UBlueprint*>& Blueprints, TArray<UBlueprint*>& OutCycle)
+    {
+        TMap<const UBlueprint*, int32> IndexOf;
+        for (int32 Index = 0; Index < Blueprints.Num(); ++Index)
+        {
+            IndexOf.Add(Blueprints[Index], Index);
+        }
+
+        TArray<TArray<int32>> Dependents;
+        Dependents.SetNum(Blueprints.Num());
+        TArray<int32> UnmetDependencies;
+        UnmetDependencies.SetNumZeroed(Blueprints.Num());
+
+        for (int32 Index = 0; Index < Blueprints.Num(); ++Index)
+        {
+            UBlueprint* Blueprint = Blueprints[Index];
+            TSet<TWeakObjectPtr<UBlueprint>> Dependencies;
+            TSet<TWeakObjectPtr<UStruct>> StructDependencies;
+            FBlueprintEditorUtils::GatherDependencies(Blueprint, Dependencies, StructDependencies);
+            if (UBlueprint* ParentBlueprint = UBlueprint::GetBlueprintFromClass(Blueprint->ParentClass))
+            {
+                Dependencies.Add(ParentBlueprint);
+            }
+
+            for (const TWeakObjectPtr<UBlueprint>& Dependency : Dependencies)
+            {
+                const int32* DependencyIndex = IndexOf.Find(Dependency.Get());
+                if (DependencyIndex && *DependencyIndex != Index)
+                {
+                    Dependents[*DependencyIndex].Add(Index);
+                    ++UnmetDependencies[Index];
+                }
+            }
+        }
+
+        // Kahn's algorithm, taking ready Blueprints in selection order
+        TArray<UBlueprint*> Order;
+        Order.Reserve(Blueprints.Num());
+        TArray<int32> Ready;
+        for (int32 Index = 0; Index < Blueprints.Num(); ++Index)
+        {
+            if (UnmetDependencies[Index] == 0)
+            {
+                Ready.Add(Index);
+            }
+        }
+        for (int32 Next = 0; Next < Ready.Num(); ++Next)
+        {
+            const int32 Index = Ready[Next];
+            Order.Add(Blueprints[Index]);
+            for (int32 Dependent : Dependents[Index])
+            {
+                if (--UnmetDependencies[Dependent] == 0)
+                {
+                    Ready.Add(Dependent);
+                }
+            }
+        }
+
+        for (int32 Index = 0; Index < Blueprints.Num(); ++Index)
+        {
+            if (UnmetDependencies[Index] > 0)
+            {
+                OutCycle.Add(Blueprints[Index]);
+                Order.Add(Blueprints[Index]);
+            }
+        }
+        return Order;
+    }
+
+    /** Messages the last compile left on the Blueprint's nodes */
+    static void CollectNodeMessages(UBlueprint* Blueprint, TArray<TSharedPtr<FJsonValue>>& OutErrors, TArray<TSharedPtr<FJsonValue>>& OutWarnings)
+    {
+        TArray<UEdGraph*> Graphs;
+        Blueprint->GetAllGraphs(Graphs);
+        for (const UEdGraph* Graph : Graphs)
+        {
+            for (const UEdGraphNode* Node : Graph->Nodes)
+            {
+                if (!Node || !Node->bHasCompilerMessage)
+                {
+                    continue;
+                }
+
+                const FString Message = FString::Printf(TEXT("%s: %s"), *Node->GetNodeTitle(ENodeTitleType::ListView).ToString(), *Node->ErrorMsg);
+                if (Node->ErrorType <= EMessageSeverity::Error)
+                {
+                    OutErrors.Add(MakeShared<FJsonValueString>(Message));
+                }
+                else if (Node->ErrorType <= EMessageSeverity::Warning)
+                {
+                    OutWarnings.Add(MakeShared<FJsonValueString>(Message));
+                }
+            }
+        }
+    }
+
+    /** Messages of a compile that was given its own results log */
+    static void CollectLogMessages(const FCompilerResultsLog& Log, TArray<TSharedPtr<FJsonValue>>& OutErrors, TArray<TSharedPtr<FJsonValue>>& OutWarnings)
+    {
+        for (const TSharedRef<FTokenizedMessage>& Message : Log.Messages)
+        {
+            if (Message->GetSeverity() <= EMessageSeverity::Error)
+            {
+                OutErrors.Add(MakeShared<FJsonValueString>(Message->ToText().ToString()));
+            }
+            else if (Message->GetSeverity() <= EMessageSeverity::Warning)
+            {
+                OutWarnings.Add(MakeShared<FJsonValueString>(Message->ToText().ToString()));
+            }
+        }
+    }
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPBlueprintCommands::HandleCompileBlueprints(const TSharedPtr<FJsonObject>& Params)
+{
+    const TArray<TSharedPtr<FJsonValue>>* NameValues = nullptr;
+    const bool bHasNames = Params->TryGetArrayField(TEXT("blueprints"), NameValues);
+    FString PathPattern;
+    const bool bHasPath = Params->TryGetStringField(TEXT("path"), PathPattern) && !PathPattern.IsEmpty();
+    if (!bHasNames && !bHasPath)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'blueprints' array or 'path' pattern"));
+    }
+
+    FString Mode = TEXT("batched");
+    Params->TryGetStringField(TEXT("mode"), Mode);
+    if (Mode != TEXT("batched") && Mode != TEXT("sequential"))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown mode '%s', expected 'batched' or 'sequential'"), *Mode));
+    }
+
+    TArray<UBlueprint*> Blueprints;
+    TArray<TSharedPtr<FJsonValue>> NotFound;
+    if (bHasNames)
+    {
+        for (const TSharedPtr<FJsonValue>& NameValue : *NameValues)
+        {
+            const FString Name = NameValue->AsString();
+            if (UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(Name))
+            {
+                Blueprints.AddUnique(Blueprint);
+            }
+            else
+            {
+                NotFound.Add(MakeShared<FJsonValueString>(Name));
+            }
+        }
+    }
+    int32 NumMatched = 0;
+    if (bHasPath && !UnrealMCPBlueprintCompile::FindBlueprintsByPath(PathPattern, Blueprints, NumMatched))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Selected %d Blueprints, more than the %d one request may compile"),
+                                                                          Blueprints.Num() + NumMatched, UnrealMCPBlueprintCompile::MaxBlueprints));
+    }
+
+    if (Blueprints.Num() > UnrealMCPBlueprintCompile::MaxBlueprints)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Selected %d Blueprints, more than the %d one request may compile"),
+                                                                          Blueprints.Num(), UnrealMCPBlueprintCompile::MaxBlueprints));
+    }
+
+    TArray<UBlueprint*> Cycle;
+    const TArray<UBlueprint*> Order = UnrealMCPBlueprintCompile::SortByDependencies(Blueprints, Cycle);
+
+    // Batched compiles share one reinstancing pass, so they can only be timed as a whole
+    const bool bBatched = Mode == TEXT("batched");
+    TArray<double> CompileMs;
+    CompileMs.SetNumZeroed(Order.Num());
+    TArray<FCompilerResultsLog> Logs;
+    const double StartTime = FPlatformTime::Seconds();
+    if (bBatched)
+    {
+        for (UBlueprint* Blueprint : Order)
+        {
+            FBlueprintCompilationManager::QueueForCompilation(Blueprint);
+        }
+        FBlueprintCompilationManager::FlushCompilationQueueAndReinstance();
+    }
+    else
+    {
+        Logs.SetNum(Order.Num());
+        for (int32 Index = 0; Index < Order.Num(); ++Index)
+        {
+            Logs[Index].bSilentMode = true;
+            const double BlueprintStart = FPlatformTime::Seconds();
+            FKismetEditorUtilities::CompileBlueprint(Order[Index], EBlueprintCompileOptions::None, &Logs[Index]);
+            CompileMs[Index] = (FPlatformTime::Seconds() - BlueprintStart) * 1000.0;
+        }
+    }
+    const double TotalMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    TArray<TSharedPtr<FJsonValue>> Results;
+    int32 FailedCount = 0;
+    for (int32 Index = 0; Index < Order.Num(); ++Index)
+    {
+        UBlueprint* Blueprint = Order[Index];
+        FUnrealMCPCompileScheduler::Get().MarkCompiled(Blueprint);
+
+        TArray<TSharedPtr<FJsonValue>> Errors;
+        TArray<TSharedPtr<FJsonValue>> Warnings;
+        if (bBatched)
+        {
+            UnrealMCPBlueprintCompile::CollectNodeMessages(Blueprint, Errors, Warnings);
+        }
+        else
+        {
+            UnrealMCPBlueprintCompile::CollectLogMessages(Logs[Index], Errors, Warnings);
+        }
+
+        if (Blueprint->Status == BS_Error)
+        {
+            ++FailedCount;
+        }
+
+        TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+        ResultObj->SetStringField(TEXT("name"), Blueprint->GetName());
+        ResultObj->SetStringField(TEXT("path"), Blueprint->GetPathName());
+        ResultObj->SetStringField(TEXT("status"), FUnrealMCPCommonUtils::BlueprintStatusToString(Blueprint));
+        if (!bBatched)
+        {
+            ResultObj->SetNumberField(TEXT("time_ms"), CompileMs[Index]);
+        }
+        ResultObj->SetArrayField(TEXT("errors"), Errors);
+        ResultObj->SetArrayField(TEXT("warnings"), Warnings);
+        Results.Add(MakeShared<FJsonValueObject>(ResultObj));
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetArrayField(TEXT("blueprints"), Results);
+    ResultObj->SetNumberField(TEXT("compiled"), Order.Num());
+    ResultObj->SetNumberField(TEXT("failed"), FailedCount);
+    ResultObj->SetStringField(TEXT("mode"), Mode);
+    ResultObj->SetNumberField(TEXT("total_ms"), TotalMs);
+    if (NotFound.Num() > 0)
+    {
+        ResultObj->SetArrayField(TEXT("not_found"), NotFound);
+    }
+    if (Cycle.Num() > 0)
+    {
+        TArray<TSharedPtr<FJsonValue>> CycleNames;
+        for (UBlueprint* Blueprint : Cycle)
+        {
+            CycleNames.Add(MakeShared<FJsonValueString>(Blueprint->GetName()));
+        }
+        ResultObj->SetArrayField(TEXT("dependency_cycle"), CycleNames);
+    }
+    return ResultObj;
+}
@@ -0,0 +1,245 @@
+#include "Commands/UnrealMCPBlueprintIndex.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "Misc/PackageName.h"
+#include "Modules/ModuleManager.h"
+
+/** Most candidates listed in an ambiguous name error */
+static const int32 MCPMaxAmbiguousCandidates = 10;
+
+FUnrealMCPBlueprintIndex& FUnrealMCPBlueprintIndex::Get()
+{
+    static FUnrealMCPBlueprintIndex Instance;
+    return Instance;
+}
+
+FUnrealMCPBlueprintIndex::FUnrealMCPBlueprintIndex()
+    : NumAssets(0)
+    , bBuilt(false)
+{
+}
+
+void FUnrealMCPBlueprintIndex::BindDelegates()
+{
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FUnrealMCPBlueprintIndex::HandleAssetAdded);
+    AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FUnrealMCPBlueprintIndex::HandleAssetRemoved);
+    AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FUnrealMCPBlueprintIndex::HandleAssetRenamed);
+}
+
+void FUnrealMCPBlueprintIndex::UnbindDelegates()
+{
+    if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>(TEXT("AssetRegistry")))
+    {
+        AssetRegistryModule->Get().OnAssetAdded().Remove(AssetAddedHandle);
+        AssetRegistryModule->Get().OnAssetRemoved().Remove(AssetRemovedHandle);
+        AssetRegistryModule->Get().OnAssetRenamed().Remove(AssetRenamedHandle);
+    }
+    AssetAddedHandle.Reset();
+    AssetRemovedHandle.Reset();
+    AssetRenamedHandle.Reset();
+}
+
+void FUnrealMCPBlueprintIndex::Build()
+{
+    // Listen first so nothing added while the initial query runs is missed, AddAsset ignores duplicates
+    BindDelegates();
+
+    FARFilter Filter;
+    Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+    Filter.bRecursiveClasses = true;
+
+    TArray<FAssetData> Assets;
+    FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get().GetAssets(Filter, Assets);
+    ByName.Reserve(Assets.Num());
+    for (const FAssetData& Asset : Assets)
+    {
+        AddAsset(Asset);
+    }
+    bBuilt = true;
+
+    UE_LOG(LogTemp, Log, TEXT("UnrealMCP: Indexed %d Blueprint assets"), NumAssets);
+}
+
+void FUnrealMCPBlueprintIndex::Reset()
+{
+    if (bBuilt)
+    {
+        UnbindDelegates();
+    }
+    ByName.Reset();
+    NumAssets = 0;
+    bBuilt = false;
+}
+
+void FUnrealMCPBlueprintIndex::AddAsset(const FAssetData& AssetData)
+{
+    TArray<FEntry, TInlineAllocator<1>>& Entries = ByName.FindOrAdd(AssetData.AssetName);
+    const FSoftObjectPath Path = AssetData.GetSoftObjectPath();
+    if (Entries.ContainsByPredicate([&Path](const FEntry& Entry) { return Entry.Path == Path; }))
+    {
+        return;
+    }
+
+    Entries.Add({ Path, AssetData.AssetClassPath });
+    ++NumAssets;
+}
+
+void FUnrealMCPBlueprintIndex::RemoveAsset(const FSoftObjectPath& Path)
+{
+    const FName AssetName(*Path.GetAssetName());
+    TArray<FEntry, TInlineAllocator<1>>* Entries = ByName.Find(AssetName);
+    if (!Entries)
+    {
+        return;
+    }
+
+    NumAssets -= Entries->RemoveAll([&Path](const FEntry& Entry) { return Entry.Path == Path; });
+    if (Entries->IsEmpty())
+    {
+        ByName.Remove(AssetName);
+    }
+}
+
+bool FUnrealMCPBlueprintIndex::IsBlueprintAsset(const FAssetData& AssetData)
+{
+    return AssetData.IsInstanceOf(UBlueprint::StaticClass());
+}
+
+bool FUnrealMCPBlueprintIndex::MatchesClass(const FEntry& Entry, const UClass* RequiredClass)
+{
+    if (!RequiredClass || RequiredClass == UBlueprint::StaticClass())
+    {
+        return true;
+    }
+    const UClass* AssetClass = FindObject<UClass>(Entry.ClassPath);
+    return AssetClass && AssetClass->IsChildOf(RequiredClass);
+}
+
+void FUnrealMCPBlueprintIndex::HandleAssetAdded(const FAssetData& AssetData)
+{
+    if (IsBlueprintAsset(AssetData))
+    {
+        AddAsset(AssetData);
+    }
+}
+
+void FUnrealMCPBlueprintIndex::HandleAssetRemoved(const FAssetData& AssetData)
+{
+    RemoveAsset(AssetData.GetSoftObjectPath());
+}
+
+void FUnrealMCPBlueprintIndex::HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+    RemoveAsset(FSoftObjectPath(OldObjectPath));
+    if (IsBlueprintAsset(AssetData))
+    {
+        AddAsset(AssetData);
+    }
+}
+
+UBlueprint* FUnrealMCPBlueprintIndex::ResolvePath(const FString& PathName, const FString& Name, const UClass* RequiredClass, FString& OutError)
+{
+    // A package path names the asset of the same name inside it
+    FString ObjectPath = PathName;
+    if (!ObjectPath.Contains(TEXT(".")))
+    {
+        ObjectPath = FString::Printf(TEXT("%s.%s"), *PathName, *FPackageName::GetShortName(PathName));
+    }
+
+    const FSoftObjectPath Path(ObjectPath);
+    const TArray<FEntry, TInlineAllocator<1>>* Entries = ByName.Find(FName(*Path.GetAssetName()));
+    const FEntry* Entry = Entries ? Entries->FindByPredicate([&Path](const FEntry& Candidate) { return Candidate.Path == Path; }) : nullptr;
+    if (Entry && !MatchesClass(*Entry, RequiredClass))
+    {
+        OutError = FString::Printf(TEXT("'%s' is not a %s"), *Name, *RequiredClass->GetName());
+        return nullptr;
+    }
+
+    // The registry may still be discovering assets, so a path it doesn't know yet is loaded directly
+    UBlueprint* Blueprint = Cast<UBlueprint>(Path.TryLoad());
+    if (Blueprint && RequiredClass && !Blueprint->IsA(RequiredClass))
+    {
+        OutError = FString::Printf(TEXT("'%s' is not a %s"), *Name, *RequiredClass->GetName());
+        return nullptr;
+    }
+    if (!Blueprint)
+    {
+        OutError = FString::Printf(TEXT("Blueprint not found: %s"), *Name);
+    }
+    return Blueprint;
+}
+
+UBlueprint* FUnrealMCPBlueprintIndex::Resolve(const FString& Name, const FString& DefaultFolder, const UClass* RequiredClass, FString& OutError)
+{
+    check(IsInGameThread());
+    if (Name.IsEmpty())
+    {
+        OutError = TEXT("Blueprint name is empty");
+        return nullptr;
+    }
+
+    if (!bBuilt)
+    {
+        Build();
+    }
+
+    FString Folder = DefaultFolder;
+    Folder.RemoveFromEnd(TEXT("/"));
+    if (Name.StartsWith(TEXT("/")))
+    {
+        return ResolvePath(Name, Name, RequiredClass, OutError);
+    }
+    if (Name.Contains(TEXT("/")))
+    {
+        return ResolvePath(Folder / Name, Name, RequiredClass, OutError);
+    }
+
+    TArray<const FEntry*, TInlineAllocator<4>> Candidates;
+    if (const TArray<FEntry, TInlineAllocator<1>>* Entries = ByName.Find(FName(*Name, FNAME_Find)))
+    {
+        for (const FEntry& Entry : *Entries)
+        {
+            if (MatchesClass(Entry, RequiredClass))
+            {
+                Candidates.Add(&Entry);
+            }
+        }
+    }
+
+    if (Candidates.Num() == 0)
+    {
+        return ResolvePath(Folder / Name, Name, RequiredClass, OutError);
+    }
+    if (Candidates.Num() == 1)
+    {
+        return ResolvePath(Candidates[0]->Path.ToString(), Name, RequiredClass, OutError);
+    }
+
+    // Several Blueprints share the name. The one in the default folder is what earlier versions found, so it wins.
+    const FString DefaultPackage = Folder / Name;
+    for (const FEntry* Candidate : Candidates)
+    {
+        if (Candidate->Path.GetLongPackageName().Equals(DefaultPackage, ESearchCase::IgnoreCase))
+        {
+            return ResolvePath(Candidate->Path.ToString(), Name, RequiredClass, OutError);
+        }
+    }
+
+    TArray<FString> Paths;
+    for (const FEntry* Candidate : Candidates)
+    {
+        Paths.Add(Candidate->Path.ToString());
+    }
+    Paths.Sort();
+    const int32 Listed = FMath::Min(Paths.Num(), MCPMaxAmbiguousCandidates);
+    FString List = FString::Join(TArrayView<const FString>(Paths.GetData(), Listed), TEXT(", "));
+    if (Paths.Num() > Listed)
+    {
+        List += FString::Printf(TEXT(" and %d more"), Paths.Num() - Listed);
+    }
+    OutError = FString::Printf(TEXT("Blueprint name '%s' matches %d Blueprints, pass the full path of one of: %s"), *Name, Paths.Num(), *List);
+    return nullptr;
+}
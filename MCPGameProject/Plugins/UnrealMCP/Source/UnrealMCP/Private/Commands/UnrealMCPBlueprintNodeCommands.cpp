@@ -1,5 +1,7 @@
 #include "Commands/UnrealMCPBlueprintNodeCommands.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "Commands/UnrealMCPGraphIndex.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
 #include "EdGraph/EdGraph.h"
@@ -47,102 +49,33 @@ FUnrealMCPBlueprintNodeCommands::FUnrealMCPBlueprintNodeCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+void FUnrealMCPBlueprintNodeCommands::RegisterCommands(FUnrealMCPCommandRegistry& Registry)
 {
-    if (CommandType == TEXT("connect_blueprint_nodes"))
-    {
-        return HandleConnectBlueprintNodes(Params);
-    }
-    else if (CommandType == TEXT("add_blueprint_get_self_component_reference"))
-    {
-        return HandleAddBlueprintGetSelfComponentReference(Params);
-    }
-    else if (CommandType == TEXT("add_event_node"))
-    {
-        return HandleAddEventNode(Params);
-    }
-    else if (CommandType == TEXT("add_blueprint_member_variable"))
-    {
-        return HandleAddBlueprintMemberVariable(Params);
-    }
-    else if (CommandType == TEXT("add_blueprint_local_variable"))
-    {
-        return HandleAddBlueprintLocalVariable(Params);
-    }
-    else if (CommandType == TEXT("add_blueprint_input_action_node"))
-    {
-        return HandleAddBlueprintInputActionNode(Params);
-    }
-    else if (CommandType == TEXT("add_blueprint_self_reference"))
-    {
-        return HandleAddBlueprintSelfReference(Params);
-    }
-    else if (CommandType == TEXT("find_blueprint_nodes"))
-    {
-        return HandleFindBlueprintNodes(Params);
-    }
-    else if (CommandType == TEXT("add_function_call_node"))
-    {
-        return HandleAddFunctionCallNode(Params);
-    }
-    else if (CommandType == TEXT("add_math_node"))
-    {
-        return HandleAddMathNode(Params);
-    }
-    else if (CommandType == TEXT("add_control_node"))
-    {
-        return HandleAddControlNode(Params);
-    }
-    else if (CommandType == TEXT("add_sequence_node"))
-    {
-        return HandleAddSequenceNode(Params);
-    }
-    else if (CommandType == TEXT("add_select_node"))
-    {
-        return HandleAddSelectNode(Params);
-    }
-    else if (CommandType == TEXT("add_enum_switch_node"))
-    {
-        return HandleAddEnumSwitchNode(Params);
-    }
-    else if (CommandType == TEXT("add_make_struct_node"))
-    {
-        return HandleAddMakeStructNode(Params);
-    }
-    else if (CommandType == TEXT("add_break_struct_node"))
-    {
-        return HandleAddBreakStructNode(Params);
-    }
-    else if (CommandType == TEXT("find_event_node_by_name"))
-    {
-        return HandleFindEventNodeByName(Params);
-    }
-    else if (CommandType == TEXT("get_node_pins"))
-    {
-        return HandleGetNodePins(Params);
-    }
-    else if (CommandType == TEXT("set_node_pin_default_value"))
-    {
-        return HandleSetNodePinDefaultValue(Params);
-    }
-    else if (CommandType == TEXT("get_all_nodes"))
-    {
-        return HandleGetAllNodes(Params);
-    }
-    else if (CommandType == TEXT("add_variable_get_node"))
-    {
-        return HandleAddVariableGetNode(Params);
-    }
-    else if (CommandType == TEXT("add_variable_set_node"))
-    {
-        return HandleAddVariableSetNode(Params);
-    }
-    else if (CommandType == TEXT("add_component_node"))
-    {
-        return HandleAddComponentNode(Params);
-    }
-    
-    return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown blueprint node command: %s"), *CommandType));
+    const FString Category = TEXT("blueprint_node");
+
+    Registry.Register(TEXT("connect_blueprint_nodes"), Category, TEXT("Connect a pin on one node to a pin on another"), this, &FUnrealMCPBlueprintNodeCommands::HandleConnectBlueprintNodes);
+    Registry.Register(TEXT("add_blueprint_get_self_component_reference"), Category, TEXT("Add a node referencing one of the Blueprint's own components"), this, &FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintGetSelfComponentReference);
+    Registry.Register(TEXT("add_event_node"), Category, TEXT("Add an event node such as ReceiveBeginPlay"), this, &FUnrealMCPBlueprintNodeCommands::HandleAddEventNode);
+    Registry.Register(TEXT("add_blueprint_member_variable"), Category, TEXT("Add a member variable to a Blueprint"), this, &FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintMemberVariable);
+    Registry.Register(TEXT("add_blueprint_local_variable"), Category, TEXT("Add a local variable to a function graph"), this, &FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintLocalVariable);
+    Registry.Register(TEXT("add_blueprint_input_action_node"), Category, TEXT("Add an input action event node"), this, &FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintInputActionNode);
+    Registry.Register(TEXT("add_blueprint_self_reference"), Category, TEXT("Add a Self reference node"), this, &FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintSelfReference);
+    Registry.Register(TEXT("find_blueprint_nodes"), Category, TEXT("Find nodes in a Blueprint event graph"), this, &FUnrealMCPBlueprintNodeCommands::HandleFindBlueprintNodes);
+    Registry.Register(TEXT("add_function_call_node"), Category, TEXT("Add a node calling a library function"), this, &FUnrealMCPBlueprintNodeCommands::HandleAddFunctionCallNode);
+    Registry.Register(TEXT("add_math_node"), Category, TEXT("Add an arithmetic node"), this, &FUnrealMCPBlueprintNodeCommands::HandleAddMathNode);
+    Registry.Register(TEXT("add_control_node"), Category, TEXT("Add a flow control node (branch, loops, switches)"), this, &FUnrealMCPBlueprintNodeCommands::HandleAddControlNode);
+    Registry.Register(TEXT("add_sequence_node"), Category, TEXT("Add a Sequence node"), this, &FUnrealMCPBlueprintNodeCommands::HandleAddSequenceNode);
+    Registry.Register(TEXT("add_select_node"), Category, TEXT("Add a Select node"), this, &FUnrealMCPBlueprintNodeCommands::HandleAddSelectNode);
+    Registry.Register(TEXT("add_enum_switch_node"), Category, TEXT("Add a Switch on Enum node"), this, &FUnrealMCPBlueprintNodeCommands::HandleAddEnumSwitchNode);
+    Registry.Register(TEXT("add_make_struct_node"), Category, TEXT("Add a Make Struct node"), this, &FUnrealMCPBlueprintNodeCommands::HandleAddMakeStructNode);
+    Registry.Register(TEXT("add_break_struct_node"), Category, TEXT("Add a Break Struct node"), this, &FUnrealMCPBlueprintNodeCommands::HandleAddBreakStructNode);
+    Registry.Register(TEXT("find_event_node_by_name"), Category, TEXT("Find an event node by event name"), this, &FUnrealMCPBlueprintNodeCommands::HandleFindEventNodeByName, EMCPCommandFlags::ReadOnly);
+    Registry.Register(TEXT("get_node_pins"), Category, TEXT("List the pins of a node"), this, &FUnrealMCPBlueprintNodeCommands::HandleGetNodePins, EMCPCommandFlags::ReadOnly);
+    Registry.Register(TEXT("set_node_pin_default_value"), Category, TEXT("Set the default value of an input pin"), this, &FUnrealMCPBlueprintNodeCommands::HandleSetNodePinDefaultValue);
+    Registry.RegisterStreaming(TEXT("get_all_nodes"), Category, TEXT("List every node in a graph"), this, &FUnrealMCPBlueprintNodeCommands::HandleGetAllNodes, EMCPCommandFlags::ReadOnly);
+    Registry.Register(TEXT("add_variable_get_node"), Category, TEXT("Add a variable Get node"), this, &FUnrealMCPBlueprintNodeCommands::HandleAddVariableGetNode);
+    Registry.Register(TEXT("add_variable_set_node"), Category, TEXT("Add a variable Set node"), this, &FUnrealMCPBlueprintNodeCommands::HandleAddVariableSetNode);
+    Registry.Register(TEXT("add_component_node"), Category, TEXT("Add an Add Component node"), this, &FUnrealMCPBlueprintNodeCommands::HandleAddComponentNode);
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintGetSelfComponentReference(const TSharedPtr<FJsonObject>& Params)
@@ -270,10 +203,11 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintMembe
     }    
 
     // Find the blueprint
-    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
+    FString FindError;
+    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName, FindError);
     if (!Blueprint)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FindError);
     }
 
     FKB_FunctionPinInformations VariableInfo;
@@ -376,10 +310,11 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintInput
     }
 
     // Find the blueprint
-    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
+    FString FindError;
+    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName, FindError);
     if (!Blueprint)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FindError);
     }
 
     // Get the event graph
@@ -421,10 +356,11 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleAddBlueprintSelfR
     }
 
     // Find the blueprint
-    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
+    FString FindError;
+    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName, FindError);
     if (!Blueprint)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FindError);
     }
 
     // Get the event graph
@@ -465,10 +401,11 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleFindBlueprintNode
     }
 
     // Find the blueprint
-    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
+    FString FindError;
+    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName, FindError);
     if (!Blueprint)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FindError);
     }
 
     // Get the event graph
@@ -1065,12 +1002,11 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleGetNodePins(const
     {
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Invalid node ID format: %s"), *NodeIdStr));
     }
-    TObjectPtr<UEdGraphNode>* NodePtr = EventGraph->Nodes.FindByPredicate([&NodeId](const UEdGraphNode* N) { return N->NodeGuid == NodeId; });
-    if (!NodePtr || !(*NodePtr))
+    UEdGraphNode* Node = FUnrealMCPGraphIndex::Get().FindNode(EventGraph, NodeId);
+    if (!Node)
     {
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Node with ID '%s' not found"), *NodeIdStr));
     }
-    UEdGraphNode* Node = NodePtr->Get();
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     TArray<TSharedPtr<FJsonValue>> PinArray;
     for (UEdGraphPin* Pin : Node->Pins)
@@ -1129,19 +1065,11 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleConnectBlueprintN
     }
 
     // Find the nodes
-    UEdGraphNode* SourceNode = nullptr;
-    UEdGraphNode* TargetNode = nullptr;
-    for (UEdGraphNode* Node : EventGraph->Nodes)
-    {
-        if (Node->NodeGuid.ToString() == SourceNodeId)
-        {
-            SourceNode = Node;
-        }
-        else if (Node->NodeGuid.ToString() == TargetNodeId)
-        {
-            TargetNode = Node;
-        }
-    }
+    FGuid SourceGuid;
+    FGuid TargetGuid;
+    FUnrealMCPGraphIndex& GraphIndex = FUnrealMCPGraphIndex::Get();
+    UEdGraphNode* SourceNode = FGuid::Parse(SourceNodeId, SourceGuid) ? GraphIndex.FindNode(EventGraph, SourceGuid) : nullptr;
+    UEdGraphNode* TargetNode = FGuid::Parse(TargetNodeId, TargetGuid) ? GraphIndex.FindNode(EventGraph, TargetGuid) : nullptr;
 
     if (!SourceNode || !TargetNode)
     {
@@ -1182,12 +1110,11 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleSetNodePinDefault
     {
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Invalid node ID format: %s"), *NodeIdStr));
     }
-    TObjectPtr<UEdGraphNode>* NodePtr = EventGraph->Nodes.FindByPredicate([&NodeId](const UEdGraphNode* N) { return N->NodeGuid == NodeId; });
-    if (!NodePtr || !(*NodePtr))
+    UEdGraphNode* Node = FUnrealMCPGraphIndex::Get().FindNode(EventGraph, NodeId);
+    if (!Node)
     {
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Node with ID '%s' not found"), *NodeIdStr));
     }
-    UEdGraphNode* Node = NodePtr->Get();
     FString PinName;
     if (!Params->TryGetStringField(TEXT("pin_name"), PinName))
     {
@@ -1198,7 +1125,7 @@ TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleSetNodePinDefault
     {
         return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'default_value' parameter"));
     }
-    UEdGraphPin* Pin = Node->FindPin(PinName);
+    UEdGraphPin* Pin = FUnrealMCPCommonUtils::FindPin(Node, PinName);
     if (!Pin)
     {
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Pin '%s' not found in node '%s'"), *PinName, *NodeIdStr));
@@ -1231,10 +1158,11 @@ bool FUnrealMCPBlueprintNodeCommands::GetEventGraphFromParams(const TSharedPtr<F
     }
 
     // Find the blueprint
-    Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
+    FString FindError;
+    Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName, FindError);
     if (!Blueprint)
     {
-        ErrorResponse = FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
+        ErrorResponse = FUnrealMCPCommonUtils::CreateErrorResponse(FindError);
         return false;
     }
     EventGraph = FUnrealMCPCommonUtils::FindBlueprintGraphByName(Blueprint, GraphName);
@@ -1246,153 +1174,142 @@ bool FUnrealMCPBlueprintNodeCommands::GetEventGraphFromParams(const TSharedPtr<F
     return true;
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleGetAllNodes(const TSharedPtr<FJsonObject>& Params)
+namespace UnrealMCPGraphJson
 {
-    UEdGraph* EventGraph;
-    UBlueprint* Blueprint;
-    TSharedPtr<FJsonObject> ErrorResponse;
-    if (!GetEventGraphFromParams(Params, Blueprint, EventGraph, ErrorResponse))
+    template<typename WriterType>
+    static void WritePin(WriterType& Writer, const UEdGraphPin* Pin, bool bWithSubPins)
     {
-        return ErrorResponse;
+        Writer.WriteObjectStart();
+        Writer.WriteValue(TEXT("pin_id"), Pin->PinId.ToString());
+        Writer.WriteValue(TEXT("pin_name"), Pin->PinName.ToString());
+        Writer.WriteValue(TEXT("pin_type"), Pin->PinType.PinCategory.ToString());
+        if (!Pin->PinType.PinSubCategory.IsNone())
+        {
+            Writer.WriteValue(TEXT("pin_sub_category"), Pin->PinType.PinSubCategory.ToString());
+        }
+        Writer.WriteValue(TEXT("pin_direction"), Pin->Direction == EGPD_Input ? TEXT("input") : TEXT("output"));
+        if (!Pin->DefaultValue.IsEmpty())
+        {
+            Writer.WriteValue(TEXT("default_value"), Pin->DefaultValue);
+        }
+        if (Pin->DefaultObject)
+        {
+            Writer.WriteValue(TEXT("default_object"), Pin->DefaultObject->GetPathName());
+        }
+
+        Writer.WriteArrayStart(TEXT("linked_pins"));
+        for (const UEdGraphPin* Link : Pin->LinkedTo)
+        {
+            Writer.WriteObjectStart();
+            Writer.WriteValue(TEXT("pin_id"), Link->PinId.ToString());
+            Writer.WriteObjectEnd();
+        }
+        Writer.WriteArrayEnd();
+
+        if (bWithSubPins)
+        {
+            Writer.WriteArrayStart(TEXT("sub_pins"));
+            for (const UEdGraphPin* SubPin : Pin->SubPins)
+            {
+                WritePin(Writer, SubPin, false);
+            }
+            Writer.WriteArrayEnd();
+        }
+        Writer.WriteObjectEnd();
     }
-    TArray<TObjectPtr<UEdGraphNode>> AllNodes = EventGraph->Nodes;
-    TArray<TSharedPtr<FJsonValue>> NodeArray;
-    for (TObjectPtr<UEdGraphNode> Node : AllNodes)
+
+    template<typename WriterType>
+    static void WriteNode(WriterType& Writer, UEdGraphNode* Node)
     {
-        TSharedPtr<FJsonObject> NodeObj = MakeShared<FJsonObject>();
-        NodeObj->SetStringField(TEXT("node_id"), Node->NodeGuid.ToString());
+        Writer.WriteObjectStart();
+        Writer.WriteValue(TEXT("node_id"), Node->NodeGuid.ToString());
         if (UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
         {
-            NodeObj->SetStringField(TEXT("node_type"), TEXT("Event"));
-            NodeObj->SetStringField(TEXT("event_name"), EventNode->EventReference.GetMemberName().ToString());
+            Writer.WriteValue(TEXT("node_type"), TEXT("Event"));
+            Writer.WriteValue(TEXT("event_name"), EventNode->EventReference.GetMemberName().ToString());
         }
         else if (UK2Node_CallFunction* CallFunctionNode = Cast<UK2Node_CallFunction>(Node))
         {
-            NodeObj->SetStringField(TEXT("node_type"), TEXT("CallFunction"));
-            NodeObj->SetStringField(TEXT("function_name"), CallFunctionNode->FunctionReference.GetMemberName().ToString());
-            NodeObj->SetStringField(TEXT("target_class"), CallFunctionNode->FunctionReference.GetMemberParentClass()->GetPathName());
+            Writer.WriteValue(TEXT("node_type"), TEXT("CallFunction"));
+            Writer.WriteValue(TEXT("function_name"), CallFunctionNode->FunctionReference.GetMemberName().ToString());
+            Writer.WriteValue(TEXT("target_class"), CallFunctionNode->FunctionReference.GetMemberParentClass()->GetPathName());
         }
-        else if (UK2Node_MacroInstance* FunctionResultNode = Cast<UK2Node_MacroInstance>(Node))
+        else if (UK2Node_MacroInstance* MacroNode = Cast<UK2Node_MacroInstance>(Node))
         {
-            NodeObj->SetStringField(TEXT("node_type"), TEXT("MacroInstance"));
-            NodeObj->SetStringField(TEXT("macro_name"), FunctionResultNode->GetMacroGraph()->GetFName().ToString());
+            Writer.WriteValue(TEXT("node_type"), TEXT("MacroInstance"));
+            Writer.WriteValue(TEXT("macro_name"), MacroNode->GetMacroGraph()->GetFName().ToString());
         }
         else if (UK2Node_VariableGet* VariableGetNode = Cast<UK2Node_VariableGet>(Node))
         {
-            NodeObj->SetStringField(TEXT("node_type"), TEXT("VariableGet"));
-            NodeObj->SetStringField(TEXT("variable_name"), VariableGetNode->VariableReference.GetMemberName().ToString());
+            Writer.WriteValue(TEXT("node_type"), TEXT("VariableGet"));
+            Writer.WriteValue(TEXT("variable_name"), VariableGetNode->VariableReference.GetMemberName().ToString());
         }
         else if (UK2Node_VariableSet* VariableSetNode = Cast<UK2Node_VariableSet>(Node))
         {
-            NodeObj->SetStringField(TEXT("node_type"), TEXT("VariableSet"));
-            NodeObj->SetStringField(TEXT("variable_name"), VariableSetNode->VariableReference.GetMemberName().ToString());
+            Writer.WriteValue(TEXT("node_type"), TEXT("VariableSet"));
+            Writer.WriteValue(TEXT("variable_name"), VariableSetNode->VariableReference.GetMemberName().ToString());
         }
-        else if (UK2Node_IfThenElse* IfThenElseNode = Cast<UK2Node_IfThenElse>(Node))
+        else if (Cast<UK2Node_IfThenElse>(Node))
         {
-            NodeObj->SetStringField(TEXT("node_type"), TEXT("IfThenElse"));
+            Writer.WriteValue(TEXT("node_type"), TEXT("IfThenElse"));
         }
-        else if (UK2Node_ExecutionSequence* SequenceNode = Cast<UK2Node_ExecutionSequence>(Node))
+        else if (Cast<UK2Node_ExecutionSequence>(Node))
         {
-            NodeObj->SetStringField(TEXT("node_type"), TEXT("Sequence"));
+            Writer.WriteValue(TEXT("node_type"), TEXT("Sequence"));
         }
-        else if (UK2Node_Select* SelectNode = Cast<UK2Node_Select>(Node))
+        else if (Cast<UK2Node_Select>(Node))
         {
-            NodeObj->SetStringField(TEXT("node_type"), TEXT("Select"));
+            Writer.WriteValue(TEXT("node_type"), TEXT("Select"));
         }
         else if (UK2Node_SwitchEnum* SwitchEnumNode = Cast<UK2Node_SwitchEnum>(Node))
         {
-            NodeObj->SetStringField(TEXT("node_type"), TEXT("SwitchEnum"));
-            NodeObj->SetStringField(TEXT("enum_path"), SwitchEnumNode->GetEnum()->GetPathName());
+            Writer.WriteValue(TEXT("node_type"), TEXT("SwitchEnum"));
+            Writer.WriteValue(TEXT("enum_path"), SwitchEnumNode->GetEnum()->GetPathName());
         }
         else if (UK2Node_MakeStruct* MakeStructNode = Cast<UK2Node_MakeStruct>(Node))
         {
-            NodeObj->SetStringField(TEXT("node_type"), TEXT("MakeStruct"));
-            NodeObj->SetStringField(TEXT("struct_path"), MakeStructNode->StructType.GetPathName());
+            Writer.WriteValue(TEXT("node_type"), TEXT("MakeStruct"));
+            Writer.WriteValue(TEXT("struct_path"), MakeStructNode->StructType.GetPathName());
         }
         else if (UK2Node_BreakStruct* BreakStructNode = Cast<UK2Node_BreakStruct>(Node))
         {
-            NodeObj->SetStringField(TEXT("node_type"), TEXT("BreakStruct"));
-            NodeObj->SetStringField(TEXT("struct_path"), BreakStructNode->StructType.GetPathName());
+            Writer.WriteValue(TEXT("node_type"), TEXT("BreakStruct"));
+            Writer.WriteValue(TEXT("struct_path"), BreakStructNode->StructType.GetPathName());
         }
         else
         {
-            NodeObj->SetStringField(TEXT("node_type"), TEXT("Unknown"));
+            Writer.WriteValue(TEXT("node_type"), TEXT("Unknown"));
         }
 
-        TArray<UEdGraphPin*> Pins = Node->Pins;
-        TArray<TSharedPtr<FJsonValue>> PinArray;
-        for (UEdGraphPin* Pin : Pins)
+        Writer.WriteArrayStart(TEXT("pins"));
+        for (const UEdGraphPin* Pin : Node->Pins)
         {
-            TSharedPtr<FJsonObject> PinObj = MakeShared<FJsonObject>();
-            PinObj->SetStringField(TEXT("pin_id"), Pin->PinId.ToString());
-            PinObj->SetStringField(TEXT("pin_name"), Pin->PinName.ToString());
-            PinObj->SetStringField(TEXT("pin_type"), Pin->PinType.PinCategory.ToString());
-            if (!Pin->PinType.PinSubCategory.IsNone())
-            {
-                PinObj->SetStringField(TEXT("pin_sub_category"), Pin->PinType.PinSubCategory.ToString());
-            }
-            PinObj->SetStringField(TEXT("pin_direction"), Pin->Direction == EGPD_Input ? TEXT("input") : TEXT("output"));
-            if (!Pin->DefaultValue.IsEmpty())
-            {
-                PinObj->SetStringField(TEXT("default_value"), Pin->DefaultValue);
-            }
-            if (Pin->DefaultObject)
-            {
-                PinObj->SetStringField(TEXT("default_object"), Pin->DefaultObject->GetPathName());
-            }
+            WritePin(Writer, Pin, true);
+        }
+        Writer.WriteArrayEnd();
+        Writer.WriteObjectEnd();
+    }
+}
 
-            TArray<UEdGraphPin*> Links =  Pin->LinkedTo;            
-            TArray<TSharedPtr<FJsonValue>> LinkArray;
-            for (UEdGraphPin* Link : Links)
-            {
-                TSharedPtr<FJsonObject> LinkObj = MakeShared<FJsonObject>();
-                LinkObj->SetStringField(TEXT("pin_id"), Link->PinId.ToString());
-                LinkArray.Add(MakeShared<FJsonValueObject>(LinkObj));
-            }
-            PinObj->SetArrayField(TEXT("linked_pins"), LinkArray);
+TSharedPtr<FJsonObject> FUnrealMCPBlueprintNodeCommands::HandleGetAllNodes(const TSharedPtr<FJsonObject>& Params, FMCPResultWriter& OutWriteResult)
+{
+    UEdGraph* EventGraph;
+    UBlueprint* Blueprint;
+    TSharedPtr<FJsonObject> ErrorResponse;
+    if (!GetEventGraphFromParams(Params, Blueprint, EventGraph, ErrorResponse))
+    {
+        return ErrorResponse;
+    }
 
-            TArray<UEdGraphPin*> SubPins = Pin->SubPins;
-            TArray<TSharedPtr<FJsonValue>> SubPinArray;
-            for (UEdGraphPin* SubPin : SubPins)
-            {
-                TSharedPtr<FJsonObject> SubPinObj = MakeShared<FJsonObject>();
-                SubPinObj->SetStringField(TEXT("pin_id"), SubPin->PinId.ToString());
-                SubPinObj->SetStringField(TEXT("pin_name"), SubPin->PinName.ToString());
-                SubPinObj->SetStringField(TEXT("pin_type"), SubPin->PinType.PinCategory.ToString());
-                if (!SubPin->PinType.PinSubCategory.IsNone())
-                {
-                    SubPinObj->SetStringField(TEXT("pin_sub_category"), SubPin->PinType.PinSubCategory.ToString());
-                }
-                SubPinObj->SetStringField(TEXT("pin_direction"), SubPin->Direction == EGPD_Input ? TEXT("input") : TEXT("output"));
-                if (!SubPin->DefaultValue.IsEmpty())
-                {
-                    SubPinObj->SetStringField(TEXT("default_value"), SubPin->DefaultValue);
-                }
-                if (SubPin->DefaultObject)
-                {
-                    SubPinObj->SetStringField(TEXT("default_object"), SubPin->DefaultObject->GetPathName());
-                }
-                TArray<UEdGraphPin*> SubLinks = SubPin->LinkedTo;
-                TArray<TSharedPtr<FJsonValue>> SubLinkArray;
-                for (UEdGraphPin* SubLink : SubLinks)
-                {
-                    TSharedPtr<FJsonObject> SubLinkObj = MakeShared<FJsonObject>();
-                    SubLinkObj->SetStringField(TEXT("pin_id"), SubLink->PinId.ToString());
-                    SubLinkArray.Add(MakeShared<FJsonValueObject>(SubLinkObj));
-                }
-                SubPinObj->SetArrayField(TEXT("linked_pins"), SubLinkArray);
-                // Add sub pin to the array
-                SubPinArray.Add(MakeShared<FJsonValueObject>(SubPinObj));
-            }// end sub pins
-            PinObj->SetArrayField(TEXT("sub_pins"), SubPinArray);
-            
-            PinArray.Add(MakeShared<FJsonValueObject>(PinObj));
-        } // end pins
-        NodeObj->SetArrayField(TEXT("pins"), PinArray);
-        NodeArray.Add(MakeShared<FJsonValueObject>(NodeObj));
-    } // end nodes
-    
-    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-    ResultObj->SetArrayField(TEXT("nodes"), NodeArray);
-    return ResultObj;
+    // Every pin of every node adds up quickly in big graphs, so the nodes are written straight out
+    OutWriteResult = FMCPResultWriter::Make([EventGraph](auto& Writer)
+    {
+        Writer.WriteArrayStart(TEXT("nodes"));
+        for (UEdGraphNode* Node : EventGraph->Nodes)
+        {
+            UnrealMCPGraphJson::WriteNode(Writer, Node);
+        }
+        Writer.WriteArrayEnd();
+    });
+    return nullptr;
 }
@@ -0,0 +1,107 @@
+#include "Commands/UnrealMCPCommandRegistry.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+FMCPJsonObjectBuilder::FMCPJsonObjectBuilder()
+    : Root(MakeShared<FJsonObject>())
+{
+    Objects.Add(Root);
+}
+
+void FMCPJsonObjectBuilder::WriteObjectStart(const FString& Key)
+{
+    TSharedPtr<FJsonObject> Child = MakeShared<FJsonObject>();
+    Objects.Last()->SetObjectField(Key, Child);
+    Objects.Add(Child);
+}
+
+void FMCPJsonObjectBuilder::WriteObjectStart()
+{
+    TSharedPtr<FJsonObject> Child = MakeShared<FJsonObject>();
+    Arrays.Last().Values.Add(MakeShared<FJsonValueObject>(Child));
+    Objects.Add(Child);
+}
+
+void FMCPJsonObjectBuilder::WriteObjectEnd()
+{
+    Objects.Pop(EAllowShrinking::No);
+}
+
+void FMCPJsonObjectBuilder::WriteArrayStart(const FString& Key)
+{
+    FArrayFrame& Frame = Arrays.AddDefaulted_GetRef();
+    Frame.Key = Key;
+}
+
+void FMCPJsonObjectBuilder::WriteArrayEnd()
+{
+    FArrayFrame Frame = Arrays.Pop(EAllowShrinking::No);
+    Objects.Last()->SetArrayField(Frame.Key, MoveTemp(Frame.Values));
+}
+
+void FUnrealMCPCommandRegistry::Register(FName Name, const FString& Category, const FString& Description, FMCPCommandHandler Handler,
+                                         EMCPCommandFlags Flags)
+{
+    if (Commands.Contains(Name))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UnrealMCPCommandRegistry: Command '%s' registered twice, replacing the earlier handler"), *Name.ToString());
+    }
+
+    FMCPCommandInfo& Info = Commands.FindOrAdd(Name);
+    Info.Name = Name;
+    Info.Category = Category;
+    Info.Description = Description;
+    Info.Handler = MoveTemp(Handler);
+    Info.Flags = Flags;
+}
+
+void FUnrealMCPCommandRegistry::RegisterStreaming(FName Name, const FString& Category, const FString& Description, FMCPStreamingHandler Handler,
+                                                  EMCPCommandFlags Flags)
+{
+    // Batches, the binary wire format and in-editor callers need the result as an object
+    Register(Name, Category, Description, [Handler](const TSharedPtr<FJsonObject>& Params)
+    {
+        FMCPResultWriter WriteResult;
+        TSharedPtr<FJsonObject> Result = Handler(Params, WriteResult);
+        return Result.IsValid() ? Result : WriteResultToObject(WriteResult);
+    }, Flags);
+
+    Commands[Name].StreamingHandler = MoveTemp(Handler);
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPCommandRegistry::WriteResultToObject(const FMCPResultWriter& WriteResult)
+{
+    FMCPJsonObjectBuilder Builder;
+    if (WriteResult)
+    {
+        WriteResult.WriteObject(Builder);
+    }
+    return Builder.GetRoot();
+}
+
+const FMCPCommandInfo* FUnrealMCPCommandRegistry::Find(const FString& CommandType) const
+{
+    // Only look up existing names so arbitrary client input doesn't grow the name table
+    const FName Name(*CommandType, FNAME_Find);
+    if (Name.IsNone())
+    {
+        return nullptr;
+    }
+    return Commands.Find(Name);
+}
+
+TArray<const FMCPCommandInfo*> FUnrealMCPCommandRegistry::GetCommands() const
+{
+    TArray<const FMCPCommandInfo*> Result;
+    Result.Reserve(Commands.Num());
+    for (const TPair<FName, FMCPCommandInfo>& Pair : Commands)
+    {
+        Result.Add(&Pair.Value);
+    }
+
+    Result.Sort([](const FMCPCommandInfo& A, const FMCPCommandInfo& B)
+    {
+        return A.Category != B.Category ? A.Category < B.Category : A.Name.LexicalLess(B.Name);
+    });
+    return Result;
+}
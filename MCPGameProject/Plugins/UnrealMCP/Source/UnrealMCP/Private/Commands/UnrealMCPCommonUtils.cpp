@@ -1,4 +1,8 @@
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "Commands/UnrealMCPBlueprintCache.h"
+#include "Commands/UnrealMCPBlueprintIndex.h"
+#include "Commands/UnrealMCPCompileScheduler.h"
+#include "Commands/UnrealMCPGraphIndex.h"
 #include "GameFramework/Actor.h"
 #include "Engine/Blueprint.h"
 #include "EdGraph/EdGraph.h"
@@ -15,6 +19,8 @@
 #include "Components/StaticMeshComponent.h"
 #include "Components/PrimitiveComponent.h"
 #include "Components/SceneComponent.h"
+#include "Components/ActorComponent.h"
+#include "UObject/UnrealType.h"
 #include "UObject/UObjectIterator.h"
 #include "Engine/BlueprintGeneratedClass.h"
 #include "BlueprintFunctionNodeSpawner.h"
@@ -161,13 +167,52 @@ FRotator FUnrealMCPCommonUtils::GetRotatorFromJson(const TSharedPtr<FJsonObject>
 // Blueprint Utilities
 UBlueprint* FUnrealMCPCommonUtils::FindBlueprint(const FString& BlueprintName)
 {
-    return FindBlueprintByName(BlueprintName);
+    FString Error;
+    return FindBlueprint(BlueprintName, Error);
 }
 
-UBlueprint* FUnrealMCPCommonUtils::FindBlueprintByName(const FString& BlueprintName)
+UBlueprint* FUnrealMCPCommonUtils::FindBlueprint(const FString& BlueprintName, FString& OutError)
 {
-    FString AssetPath = TEXT("/Game/Blueprints/") + BlueprintName;
-    return LoadObject<UBlueprint>(nullptr, *AssetPath);
+    FUnrealMCPBlueprintCache& Cache = FUnrealMCPBlueprintCache::Get();
+    if (FUnrealMCPBlueprintCache::IsHandle(BlueprintName))
+    {
+        UBlueprint* Blueprint = Cache.FindByHandle(BlueprintName);
+        if (!Blueprint)
+        {
+            OutError = FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName);
+        }
+        return Blueprint;
+    }
+
+    if (UBlueprint* Cached = Cache.FindByName(BlueprintName))
+    {
+        return Cached;
+    }
+
+    UBlueprint* Blueprint = FindBlueprintByName(BlueprintName, OutError);
+    Cache.AddName(BlueprintName, Blueprint);
+    return Blueprint;
+}
+
+UBlueprint* FUnrealMCPCommonUtils::FindBlueprintByName(const FString& BlueprintName, FString& OutError)
+{
+    // Short names not found elsewhere, and relative paths, are looked for in /Game/Blueprints/ as they always were
+    return FUnrealMCPBlueprintIndex::Get().Resolve(BlueprintName, TEXT("/Game/Blueprints/"), UBlueprint::StaticClass(), OutError);
+}
+
+const TCHAR* FUnrealMCPCommonUtils::BlueprintStatusToString(const UBlueprint* Blueprint)
+{
+    switch (Blueprint->Status)
+    {
+    case BS_UpToDate:
+        return TEXT("up_to_date");
+    case BS_UpToDateWithWarnings:
+        return TEXT("warnings");
+    case BS_Error:
+        return TEXT("error");
+    default:
+        return TEXT("dirty");
+    }
 }
 
 UEdGraph* FUnrealMCPCommonUtils::FindOrCreateEventGraph(UBlueprint* Blueprint)
@@ -197,13 +242,21 @@ UEdGraph* FUnrealMCPCommonUtils::FindBlueprintGraphByName(UBlueprint* Blueprint,
     if (!Blueprint)
     {
         return nullptr;
-    }    
+    }
+
+    FUnrealMCPBlueprintCache& Cache = FUnrealMCPBlueprintCache::Get();
+    if (UEdGraph* Cached = Cache.FindGraph(Blueprint, GraphName))
+    {
+        return Cached;
+    }
+
     TArray<UEdGraph*> AllGraphs;
     Blueprint->GetAllGraphs(AllGraphs);
     for (UEdGraph* Graph : AllGraphs)
     {
         if (Graph->GetName() == GraphName)
         {
+            Cache.AddGraph(Blueprint, GraphName, Graph);
             return Graph;
         }
     }
@@ -291,6 +344,8 @@ UK2Node_VariableGet* FUnrealMCPCommonUtils::CreateVariableGetNode(UEdGraph* Grap
     
     UK2Node_VariableGet* VariableGetNode = NewObject<UK2Node_VariableGet>(Graph);
     
+    // A variable added earlier in this run only exists on the generated class once it's compiled
+    FUnrealMCPCompileScheduler::Get().EnsureCompiled(Blueprint);
     FName VarName(*VariableName);
     FProperty* Property = FindFProperty<FProperty>(Blueprint->GeneratedClass, VarName);
     
@@ -318,6 +373,8 @@ UK2Node_VariableSet* FUnrealMCPCommonUtils::CreateVariableSetNode(UEdGraph* Grap
     
     UK2Node_VariableSet* VariableSetNode = NewObject<UK2Node_VariableSet>(Graph);
     
+    // A variable added earlier in this run only exists on the generated class once it's compiled
+    FUnrealMCPCompileScheduler::Get().EnsureCompiled(Blueprint);
     FName VarName(*VariableName);
     FProperty* Property = FindFProperty<FProperty>(Blueprint->GeneratedClass, VarName);
     
@@ -398,14 +455,20 @@ UEdGraphPin* FUnrealMCPCommonUtils::FindPin(UEdGraphNode* Node, const FString& P
     {
         return nullptr;
     }
+
+    FUnrealMCPGraphIndex& GraphIndex = FUnrealMCPGraphIndex::Get();
+    if (UEdGraphPin* Indexed = GraphIndex.FindPin(Node, PinName, Direction))
+    {
+        return Indexed;
+    }
     
     // Log all pins for debugging
-    UE_LOG(LogTemp, Display, TEXT("FindPin: Looking for pin '%s' (Direction: %d) in node '%s'"), 
+    UE_LOG(LogTemp, Verbose, TEXT("FindPin: Looking for pin '%s' (Direction: %d) in node '%s'"), 
            *PinName, (int32)Direction, *Node->GetName());
     
     for (UEdGraphPin* Pin : Node->Pins)
     {
-        UE_LOG(LogTemp, Display, TEXT("  - Available pin: '%s', Direction: %d, Category: %s"), 
+        UE_LOG(LogTemp, Verbose, TEXT("  - Available pin: '%s', Direction: %d, Category: %s"), 
                *Pin->PinName.ToString(), (int32)Pin->Direction, *Pin->PinType.PinCategory.ToString());
     }
     
@@ -414,7 +477,8 @@ UEdGraphPin* FUnrealMCPCommonUtils::FindPin(UEdGraphNode* Node, const FString& P
     {
         if (Pin->PinName.ToString() == PinName && (Direction == EGPD_MAX || Pin->Direction == Direction))
         {
-            UE_LOG(LogTemp, Display, TEXT("  - Found exact matching pin: '%s'"), *Pin->PinName.ToString());
+            UE_LOG(LogTemp, Verbose, TEXT("  - Found exact matching pin: '%s'"), *Pin->PinName.ToString());
+            GraphIndex.AddPin(Node, PinName, Direction, Pin);
             return Pin;
         }
     }
@@ -425,7 +489,8 @@ UEdGraphPin* FUnrealMCPCommonUtils::FindPin(UEdGraphNode* Node, const FString& P
         if (Pin->PinName.ToString().Equals(PinName, ESearchCase::IgnoreCase) && 
             (Direction == EGPD_MAX || Pin->Direction == Direction))
         {
-            UE_LOG(LogTemp, Display, TEXT("  - Found case-insensitive matching pin: '%s'"), *Pin->PinName.ToString());
+            UE_LOG(LogTemp, Verbose, TEXT("  - Found case-insensitive matching pin: '%s'"), *Pin->PinName.ToString());
+            GraphIndex.AddPin(Node, PinName, Direction, Pin);
             return Pin;
         }
     }
@@ -437,7 +502,8 @@ UEdGraphPin* FUnrealMCPCommonUtils::FindPin(UEdGraphNode* Node, const FString& P
         {
             if (Pin->Direction == EGPD_Output && Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec)
             {
-                UE_LOG(LogTemp, Display, TEXT("  - Found fallback data output pin: '%s'"), *Pin->PinName.ToString());
+                UE_LOG(LogTemp, Verbose, TEXT("  - Found fallback data output pin: '%s'"), *Pin->PinName.ToString());
+                GraphIndex.AddPin(Node, PinName, Direction, Pin);
                 return Pin;
             }
         }
@@ -448,74 +514,177 @@ UEdGraphPin* FUnrealMCPCommonUtils::FindPin(UEdGraphNode* Node, const FString& P
 }
 
 // Actor utilities
-TSharedPtr<FJsonValue> FUnrealMCPCommonUtils::ActorToJson(AActor* Actor)
+namespace UnrealMCPActorJson
 {
-    if (!Actor)
+    template<typename WriterType>
+    static void WriteTriple(WriterType& Writer, const TCHAR* Key, double X, double Y, double Z)
     {
-        return MakeShared<FJsonValueNull>();
+        Writer.WriteArrayStart(Key);
+        Writer.WriteValue(X);
+        Writer.WriteValue(Y);
+        Writer.WriteValue(Z);
+        Writer.WriteArrayEnd();
+    }
+
+    /** Write the requested fields into the object the writer is in */
+    template<typename WriterType>
+    static void WriteActorFields(WriterType& Writer, AActor* Actor, EMCPActorFields Fields)
+    {
+        if (EnumHasAnyFlags(Fields, EMCPActorFields::Name))
+        {
+            Writer.WriteValue(TEXT("name"), Actor->GetName());
+        }
+        if (EnumHasAnyFlags(Fields, EMCPActorFields::Class))
+        {
+            Writer.WriteValue(TEXT("class"), Actor->GetClass()->GetName());
+        }
+        if (EnumHasAnyFlags(Fields, EMCPActorFields::Location))
+        {
+            const FVector Location = Actor->GetActorLocation();
+            WriteTriple(Writer, TEXT("location"), Location.X, Location.Y, Location.Z);
+        }
+        if (EnumHasAnyFlags(Fields, EMCPActorFields::Rotation))
+        {
+            const FRotator Rotation = Actor->GetActorRotation();
+            WriteTriple(Writer, TEXT("rotation"), Rotation.Pitch, Rotation.Yaw, Rotation.Roll);
+        }
+        if (EnumHasAnyFlags(Fields, EMCPActorFields::Scale))
+        {
+            const FVector Scale = Actor->GetActorScale3D();
+            WriteTriple(Writer, TEXT("scale"), Scale.X, Scale.Y, Scale.Z);
+        }
+        if (EnumHasAnyFlags(Fields, EMCPActorFields::Label))
+        {
+            Writer.WriteValue(TEXT("label"), Actor->GetActorLabel());
+        }
+        if (EnumHasAnyFlags(Fields, EMCPActorFields::Folder))
+        {
+            Writer.WriteValue(TEXT("folder"), Actor->GetFolderPath().ToString());
+        }
+        if (EnumHasAnyFlags(Fields, EMCPActorFields::Tags))
+        {
+            Writer.WriteArrayStart(TEXT("tags"));
+            for (const FName& Tag : Actor->Tags)
+            {
+                Writer.WriteValue(Tag.ToString());
+            }
+            Writer.WriteArrayEnd();
+        }
+        if (EnumHasAnyFlags(Fields, EMCPActorFields::Components))
+        {
+            TInlineComponentArray<UActorComponent*> Components(Actor);
+            Writer.WriteArrayStart(TEXT("components"));
+            for (const UActorComponent* Component : Components)
+            {
+                Writer.WriteObjectStart();
+                Writer.WriteValue(TEXT("name"), Component->GetName());
+                Writer.WriteValue(TEXT("class"), Component->GetClass()->GetName());
+                Writer.WriteObjectEnd();
+            }
+            Writer.WriteArrayEnd();
+        }
+        if (EnumHasAnyFlags(Fields, EMCPActorFields::Properties))
+        {
+            // Exported as text, the same form the Details panel copies and pastes
+            Writer.WriteObjectStart(TEXT("properties"));
+            FString ValueText;
+            for (TFieldIterator<FProperty> It(Actor->GetClass()); It; ++It)
+            {
+                const FProperty* Property = *It;
+                if (!Property->HasAnyPropertyFlags(CPF_Edit) || Property->HasAnyPropertyFlags(CPF_Deprecated))
+                {
+                    continue;
+                }
+
+                ValueText.Reset();
+                Property->ExportTextItem_Direct(ValueText, Property->ContainerPtrToValuePtr<void>(Actor), nullptr, Actor, PPF_None);
+                const FString PropertyName = Property->GetName();
+                Writer.WriteValue(*PropertyName, ValueText);
+            }
+            Writer.WriteObjectEnd();
+        }
     }
-    
-    TSharedPtr<FJsonObject> ActorObject = MakeShared<FJsonObject>();
-    ActorObject->SetStringField(TEXT("name"), Actor->GetName());
-    ActorObject->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
-    
-    FVector Location = Actor->GetActorLocation();
-    TArray<TSharedPtr<FJsonValue>> LocationArray;
-    LocationArray.Add(MakeShared<FJsonValueNumber>(Location.X));
-    LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Y));
-    LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Z));
-    ActorObject->SetArrayField(TEXT("location"), LocationArray);
-    
-    FRotator Rotation = Actor->GetActorRotation();
-    TArray<TSharedPtr<FJsonValue>> RotationArray;
-    RotationArray.Add(MakeShared<FJsonValueNumber>(Rotation.Pitch));
-    RotationArray.Add(MakeShared<FJsonValueNumber>(Rotation.Yaw));
-    RotationArray.Add(MakeShared<FJsonValueNumber>(Rotation.Roll));
-    ActorObject->SetArrayField(TEXT("rotation"), RotationArray);
-    
-    FVector Scale = Actor->GetActorScale3D();
-    TArray<TSharedPtr<FJsonValue>> ScaleArray;
-    ScaleArray.Add(MakeShared<FJsonValueNumber>(Scale.X));
-    ScaleArray.Add(MakeShared<FJsonValueNumber>(Scale.Y));
-    ScaleArray.Add(MakeShared<FJsonValueNumber>(Scale.Z));
-    ActorObject->SetArrayField(TEXT("scale"), ScaleArray);
-    
-    return MakeShared<FJsonValueObject>(ActorObject);
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPCommonUtils::ActorToJsonObject(AActor* Actor, bool bDetailed)
+// Serialize only the requested fields of an actor
+TSharedPtr<FJsonObject> FUnrealMCPCommonUtils::ActorToJsonObject(AActor* Actor, EMCPActorFields Fields)
 {
     if (!Actor)
     {
         return nullptr;
     }
-    
-    TSharedPtr<FJsonObject> ActorObject = MakeShared<FJsonObject>();
-    ActorObject->SetStringField(TEXT("name"), Actor->GetName());
-    ActorObject->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
-    
-    FVector Location = Actor->GetActorLocation();
-    TArray<TSharedPtr<FJsonValue>> LocationArray;
-    LocationArray.Add(MakeShared<FJsonValueNumber>(Location.X));
-    LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Y));
-    LocationArray.Add(MakeShared<FJsonValueNumber>(Location.Z));
-    ActorObject->SetArrayField(TEXT("location"), LocationArray);
-    
-    FRotator Rotation = Actor->GetActorRotation();
-    TArray<TSharedPtr<FJsonValue>> RotationArray;
-    RotationArray.Add(MakeShared<FJsonValueNumber>(Rotation.Pitch));
-    RotationArray.Add(MakeShared<FJsonValueNumber>(Rotation.Yaw));
-    RotationArray.Add(MakeShared<FJsonValueNumber>(Rotation.Roll));
-    ActorObject->SetArrayField(TEXT("rotation"), RotationArray);
-    
-    FVector Scale = Actor->GetActorScale3D();
-    TArray<TSharedPtr<FJsonValue>> ScaleArray;
-    ScaleArray.Add(MakeShared<FJsonValueNumber>(Scale.X));
-    ScaleArray.Add(MakeShared<FJsonValueNumber>(Scale.Y));
-    ScaleArray.Add(MakeShared<FJsonValueNumber>(Scale.Z));
-    ActorObject->SetArrayField(TEXT("scale"), ScaleArray);
-    
-    return ActorObject;
+
+    FMCPJsonObjectBuilder Builder;
+    UnrealMCPActorJson::WriteActorFields(Builder, Actor, Fields);
+    return Builder.GetRoot();
+}
+
+namespace UnrealMCPActorJson
+{
+    template<typename WriterType>
+    static void WriteActor(WriterType& Writer, AActor* Actor, EMCPActorFields Fields)
+    {
+        if (!Actor)
+        {
+            Writer.WriteNull();
+            return;
+        }
+
+        Writer.WriteObjectStart();
+        WriteActorFields(Writer, Actor, Fields);
+        Writer.WriteObjectEnd();
+    }
+}
+
+void FUnrealMCPCommonUtils::WriteActorJson(FMCPJsonWriter& Writer, AActor* Actor, EMCPActorFields Fields)
+{
+    UnrealMCPActorJson::WriteActor(Writer, Actor, Fields);
+}
+
+void FUnrealMCPCommonUtils::WriteActorJson(FMCPJsonObjectBuilder& Writer, AActor* Actor, EMCPActorFields Fields)
+{
+    UnrealMCPActorJson::WriteActor(Writer, Actor, Fields);
+}
+
+// Read an optional "fields" array such as ["name", "transform"] into a field mask
+bool FUnrealMCPCommonUtils::ParseActorFields(const TSharedPtr<FJsonObject>& Params, EMCPActorFields& OutFields, FString& OutError,
+                                             EMCPActorFields DefaultFields)
+{
+    OutFields = DefaultFields;
+
+    const TArray<TSharedPtr<FJsonValue>>* FieldArray = nullptr;
+    if (!Params->TryGetArrayField(TEXT("fields"), FieldArray))
+    {
+        return true;
+    }
+
+    static const TMap<FString, EMCPActorFields> FieldNames = {
+        { TEXT("name"), EMCPActorFields::Name },
+        { TEXT("class"), EMCPActorFields::Class },
+        { TEXT("location"), EMCPActorFields::Location },
+        { TEXT("rotation"), EMCPActorFields::Rotation },
+        { TEXT("scale"), EMCPActorFields::Scale },
+        { TEXT("transform"), EMCPActorFields::Transform },
+        { TEXT("label"), EMCPActorFields::Label },
+        { TEXT("folder"), EMCPActorFields::Folder },
+        { TEXT("tags"), EMCPActorFields::Tags },
+        { TEXT("components"), EMCPActorFields::Components },
+        { TEXT("properties"), EMCPActorFields::Properties },
+        { TEXT("all"), EMCPActorFields::All },
+    };
+
+    OutFields = EMCPActorFields::None;
+    for (const TSharedPtr<FJsonValue>& FieldValue : *FieldArray)
+    {
+        const EMCPActorFields* Field = FieldNames.Find(FieldValue->AsString());
+        if (!Field)
+        {
+            OutError = FString::Printf(TEXT("Unknown actor field '%s'"), *FieldValue->AsString());
+            return false;
+        }
+        OutFields |= *Field;
+    }
+    return true;
 }
 
 UK2Node_Event* FUnrealMCPCommonUtils::FindExistingEventNode(UEdGraph* Graph, const FString& EventName)
@@ -2060,7 +2229,7 @@ bool FUnrealMCPCommonUtils::CreateLocalVariable(UBlueprint* Blueprint, UEdGraph*
 
     FBlueprintEditorUtils::AddLocalVariable(LocalBlueprint, LocalGraph, Var.Name, MyPinType, FString());
     FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(LocalBlueprint);
-    FKismetEditorUtilities::CompileBlueprint(LocalBlueprint);
+    FUnrealMCPCompileScheduler::Get().RequestCompile(LocalBlueprint);
     return true;
 }
 
@@ -2144,7 +2313,7 @@ bool FUnrealMCPCommonUtils::CreateMemberVariable(UBlueprint* Blueprint, FKB_Func
     }
     FBlueprintEditorUtils::AddMemberVariable(LocalBlueprint, Var.Name, MyPinType, FString());
     FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(LocalBlueprint);
-    FKismetEditorUtilities::CompileBlueprint(LocalBlueprint);
+    FUnrealMCPCompileScheduler::Get().RequestCompile(LocalBlueprint);
     return true;
 }
 
@@ -2169,8 +2338,9 @@ bool FUnrealMCPCommonUtils::SpawnAddComponentNode(UEdGraph* LocalGraph, UClass*
     AddComponentNode->NodePosX = NodePosition.X;
     AddComponentNode->NodePosY = NodePosition.Y;
     NewNode = AddComponentNode;
-    FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(FBlueprintEditorUtils::FindBlueprintForGraph(LocalGraph));
-    FKismetEditorUtilities::CompileBlueprint(FBlueprintEditorUtils::FindBlueprintForGraph(LocalGraph));
+    UBlueprint* GraphBlueprint = FBlueprintEditorUtils::FindBlueprintForGraph(LocalGraph);
+    FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GraphBlueprint);
+    FUnrealMCPCompileScheduler::Get().RequestCompile(GraphBlueprint);
 
     return true;
 }
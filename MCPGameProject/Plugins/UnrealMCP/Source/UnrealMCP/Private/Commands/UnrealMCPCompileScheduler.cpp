@@ -0,0 +1,144 @@
+#include "Commands/UnrealMCPCompileScheduler.h"
+#include "Engine/Blueprint.h"
+#include "HAL/PlatformTime.h"
+#include "Kismet2/KismetEditorUtilities.h"
+
+FUnrealMCPCompileScheduler& FUnrealMCPCompileScheduler::Get()
+{
+    static FUnrealMCPCompileScheduler Instance;
+    return Instance;
+}
+
+FUnrealMCPCompileScheduler::FUnrealMCPCompileScheduler()
+    : LastRequestTime(0.0)
+    , IdleDelaySeconds(1.0f)
+    , ImmediateCount(0)
+    , HoldCount(0)
+    , Record(nullptr)
+{
+}
+
+void FUnrealMCPCompileScheduler::RequestCompile(UBlueprint* Blueprint)
+{
+    check(IsInGameThread());
+    if (!Blueprint)
+    {
+        return;
+    }
+
+    if (ImmediateCount > 0)
+    {
+        CompileNow(Blueprint);
+        return;
+    }
+
+    Pending.AddUnique(Blueprint);
+    if (Record)
+    {
+        Record->AddUnique(Blueprint);
+    }
+    LastRequestTime = FPlatformTime::Seconds();
+    if (!TickerHandle.IsValid())
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FUnrealMCPCompileScheduler::Tick));
+    }
+}
+
+void FUnrealMCPCompileScheduler::EnsureCompiled(UBlueprint* Blueprint)
+{
+    if (IsPending(Blueprint))
+    {
+        CompileNow(Blueprint);
+    }
+}
+
+void FUnrealMCPCompileScheduler::CompileNow(UBlueprint* Blueprint)
+{
+    check(IsInGameThread());
+    if (!Blueprint)
+    {
+        return;
+    }
+
+    Pending.Remove(Blueprint);
+    FKismetEditorUtilities::CompileBlueprint(Blueprint);
+}
+
+void FUnrealMCPCompileScheduler::MarkCompiled(UBlueprint* Blueprint)
+{
+    Pending.Remove(Blueprint);
+}
+
+int32 FUnrealMCPCompileScheduler::FlushAll()
+{
+    const int32 Compiled = CompilePending([](const TWeakObjectPtr<UBlueprint>&) { return true; });
+    StopTickerIfIdle();
+    return Compiled;
+}
+
+int32 FUnrealMCPCompileScheduler::Flush(const TArray<TWeakObjectPtr<UBlueprint>>& Blueprints)
+{
+    const int32 Compiled = CompilePending([&Blueprints](const TWeakObjectPtr<UBlueprint>& Blueprint) { return Blueprints.Contains(Blueprint); });
+    StopTickerIfIdle();
+    return Compiled;
+}
+
+void FUnrealMCPCompileScheduler::StopTickerIfIdle()
+{
+    if (Pending.IsEmpty() && TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+}
+
+bool FUnrealMCPCompileScheduler::IsPending(const UBlueprint* Blueprint) const
+{
+    return Blueprint && Pending.Contains(Blueprint);
+}
+
+int32 FUnrealMCPCompileScheduler::CompilePending(TFunctionRef<bool(const TWeakObjectPtr<UBlueprint>&)> Filter)
+{
+    check(IsInGameThread());
+
+    // Compiling can reach back into the scheduler, so work from a copy
+    TArray<TWeakObjectPtr<UBlueprint>> ToCompile;
+    for (int32 Index = 0; Index < Pending.Num();)
+    {
+        if (Filter(Pending[Index]))
+        {
+            ToCompile.Add(Pending[Index]);
+            Pending.RemoveAt(Index);
+        }
+        else
+        {
+            ++Index;
+        }
+    }
+
+    int32 Compiled = 0;
+    for (const TWeakObjectPtr<UBlueprint>& Blueprint : ToCompile)
+    {
+        if (Blueprint.IsValid())
+        {
+            FKismetEditorUtilities::CompileBlueprint(Blueprint.Get());
+            ++Compiled;
+        }
+    }
+    return Compiled;
+}
+
+bool FUnrealMCPCompileScheduler::Tick(float DeltaTime)
+{
+    if (HoldCount == 0 && FPlatformTime::Seconds() - LastRequestTime >= IdleDelaySeconds)
+    {
+        CompilePending([](const TWeakObjectPtr<UBlueprint>&) { return true; });
+    }
+
+    if (Pending.IsEmpty())
+    {
+        TickerHandle.Reset();
+        return false;
+    }
+    return true;
+}
@@ -1,5 +1,10 @@
 #include "Commands/UnrealMCPEditorCommands.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "Commands/UnrealMCPCompileScheduler.h"
+#include "Commands/UnrealMCPActorIndex.h"
+#include "Commands/UnrealMCPSpatialIndex.h"
+#include "Commands/UnrealMCPLevelJournal.h"
 #include "Editor.h"
 #include "EditorViewportClient.h"
 #include "LevelEditorViewport.h"
@@ -16,111 +21,1044 @@
 #include "Engine/SpotLight.h"
 #include "Camera/CameraActor.h"
 #include "Components/StaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "EditorAssetLibrary.h"
 #include "EditorSubsystem.h"
 #include "Subsystems/EditorActorSubsystem.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
+#include "EngineUtils.h"
+#include "ScopedTransaction.h"
+#include "Internationalization/Regex.h"
 
-FUnrealMCPEditorCommands::FUnrealMCPEditorCommands()
+#define LOCTEXT_NAMESPACE "FUnrealMCPModule"
+
+// Page size limits for get_actors_in_level
+static const int32 DefaultActorPageSize = 1000;
+static const int32 MaxActorPageSize = 10000;
+
+// Property reported to the level journal when mesh instances change
+static const FName InstancesPropertyName(TEXT("PerInstanceSMData"));
+
+// Default reach of find_actors_on_ray, in world units
+static const double DefaultRayDistance = 1000000.0;
+
+/** Actor classes spawn_actor and spawn_actors accept by name */
+static UClass* FindSpawnableActorClass(const FString& ActorType)
+{
+    if (ActorType == TEXT("StaticMeshActor"))
+    {
+        return AStaticMeshActor::StaticClass();
+    }
+    if (ActorType == TEXT("PointLight"))
+    {
+        return APointLight::StaticClass();
+    }
+    if (ActorType == TEXT("SpotLight"))
+    {
+        return ASpotLight::StaticClass();
+    }
+    if (ActorType == TEXT("DirectionalLight"))
+    {
+        return ADirectionalLight::StaticClass();
+    }
+    if (ActorType == TEXT("CameraActor"))
+    {
+        return ACameraActor::StaticClass();
+    }
+    return nullptr;
+}
+
+/** One entry of a spawn_actors or set_actor_transforms request, transform parts left unset weren't given */
+struct FBulkActorItem
+{
+    FString Name;
+    FString Type;
+    TOptional<FVector> Location;
+    TOptional<FRotator> Rotation;
+    TOptional<FVector> Scale;
+};
+
+/** Read an array of {name, type, location, rotation, scale} objects */
+static bool ParseBulkItemObjects(const TArray<TSharedPtr<FJsonValue>>& ItemArray, const TCHAR* FieldName, TArray<FBulkActorItem>& OutItems, FString& OutError)
 {
+    OutItems.Reserve(ItemArray.Num());
+    for (int32 Index = 0; Index < ItemArray.Num(); ++Index)
+    {
+        const TSharedPtr<FJsonObject>* ItemObject = nullptr;
+        if (!ItemArray[Index]->TryGetObject(ItemObject))
+        {
+            OutError = FString::Printf(TEXT("%s[%d] is not an object"), FieldName, Index);
+            return false;
+        }
+
+        FBulkActorItem& Item = OutItems.AddDefaulted_GetRef();
+        (*ItemObject)->TryGetStringField(TEXT("name"), Item.Name);
+        (*ItemObject)->TryGetStringField(TEXT("type"), Item.Type);
+        if ((*ItemObject)->HasField(TEXT("location")))
+        {
+            Item.Location = FUnrealMCPCommonUtils::GetVectorFromJson(*ItemObject, TEXT("location"));
+        }
+        if ((*ItemObject)->HasField(TEXT("rotation")))
+        {
+            Item.Rotation = FUnrealMCPCommonUtils::GetRotatorFromJson(*ItemObject, TEXT("rotation"));
+        }
+        if ((*ItemObject)->HasField(TEXT("scale")))
+        {
+            Item.Scale = FUnrealMCPCommonUtils::GetVectorFromJson(*ItemObject, TEXT("scale"));
+        }
+    }
+    return true;
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+/**
+ * Fill the transforms of InOutItems from packed 'transforms' (9 numbers per item: location, rotation, scale)
+ * or 'locations' (3 per item). With bSizeFromPacked the items are created to match the packed data,
+ * otherwise the packed data must match the existing items and may be left out.
+ */
+static bool ParsePackedTransforms(const TSharedPtr<FJsonObject>& Params, bool bSizeFromPacked, TArray<FBulkActorItem>& InOutItems, FString& OutError)
 {
-    // Actor manipulation commands
-    if (CommandType == TEXT("get_actors_in_level"))
+    // Packed numbers avoid an object and three arrays per item, which dominate parsing for large requests
+    const TArray<TSharedPtr<FJsonValue>>* Packed = nullptr;
+    int32 Stride = 0;
+    if (Params->TryGetArrayField(TEXT("transforms"), Packed))
     {
-        return HandleGetActorsInLevel(Params);
+        Stride = 9;
     }
-    else if (CommandType == TEXT("find_actors_by_name"))
+    else if (Params->TryGetArrayField(TEXT("locations"), Packed))
     {
-        return HandleFindActorsByName(Params);
+        Stride = 3;
     }
-    else if (CommandType == TEXT("spawn_actor") || CommandType == TEXT("create_actor"))
+    if (!Packed)
     {
-        if (CommandType == TEXT("create_actor"))
+        if (bSizeFromPacked)
         {
-            UE_LOG(LogTemp, Warning, TEXT("'create_actor' command is deprecated and will be removed in a future version. Please use 'spawn_actor' instead."));
+            OutError = TEXT("Missing 'transforms' or 'locations' parameter");
+            return false;
         }
-        return HandleSpawnActor(Params);
+        return true;
+    }
+
+    const TCHAR* PackedName = Stride == 9 ? TEXT("transforms") : TEXT("locations");
+    if (bSizeFromPacked)
+    {
+        if (Packed->Num() % Stride != 0)
+        {
+            OutError = FString::Printf(TEXT("'%s' needs %d numbers per entry, got %d"), PackedName, Stride, Packed->Num());
+            return false;
+        }
+        InOutItems.SetNum(Packed->Num() / Stride);
+    }
+    else if (Packed->Num() != InOutItems.Num() * Stride)
+    {
+        OutError = FString::Printf(TEXT("'%s' needs %d numbers per entry, got %d for %d entries"), PackedName, Stride, Packed->Num(), InOutItems.Num());
+        return false;
+    }
+
+    auto PackedNumber = [Packed](int32 Offset) { return (*Packed)[Offset]->AsNumber(); };
+
+    for (int32 Index = 0; Index < InOutItems.Num(); ++Index)
+    {
+        FBulkActorItem& Item = InOutItems[Index];
+        const int32 Offset = Index * Stride;
+        Item.Location = FVector(PackedNumber(Offset), PackedNumber(Offset + 1), PackedNumber(Offset + 2));
+        if (Stride == 9)
+        {
+            Item.Rotation = FRotator(PackedNumber(Offset + 3), PackedNumber(Offset + 4), PackedNumber(Offset + 5));
+            Item.Scale = FVector(PackedNumber(Offset + 6), PackedNumber(Offset + 7), PackedNumber(Offset + 8));
+        }
+    }
+    return true;
+}
+
+/** Read the entries of a bulk actor request, either an 'actors' array of objects or a 'names' array with packed transforms */
+static bool ParseBulkActorItems(const TSharedPtr<FJsonObject>& Params, TArray<FBulkActorItem>& OutItems, FString& OutError)
+{
+    const TArray<TSharedPtr<FJsonValue>>* ActorArray = nullptr;
+    if (Params->TryGetArrayField(TEXT("actors"), ActorArray))
+    {
+        return ParseBulkItemObjects(*ActorArray, TEXT("actors"), OutItems, OutError);
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* NameArray = nullptr;
+    if (!Params->TryGetArrayField(TEXT("names"), NameArray))
+    {
+        OutError = TEXT("Missing 'actors' or 'names' parameter");
+        return false;
+    }
+
+    OutItems.SetNum(NameArray->Num());
+    for (int32 Index = 0; Index < NameArray->Num(); ++Index)
+    {
+        OutItems[Index].Name = (*NameArray)[Index]->AsString();
+    }
+    return ParsePackedTransforms(Params, false, OutItems, OutError);
+}
+
+/** Read the transforms of a mesh instance request, an 'instances' array of objects or packed transforms */
+static bool ParseInstanceItems(const TSharedPtr<FJsonObject>& Params, TArray<FBulkActorItem>& OutItems, FString& OutError)
+{
+    const TArray<TSharedPtr<FJsonValue>>* InstanceArray = nullptr;
+    if (Params->TryGetArrayField(TEXT("instances"), InstanceArray))
+    {
+        return ParseBulkItemObjects(*InstanceArray, TEXT("instances"), OutItems, OutError);
     }
-    else if (CommandType == TEXT("delete_actor"))
+    return ParsePackedTransforms(Params, true, OutItems, OutError);
+}
+
+/** World every actor command spawns into and looks actors up in, the editor's own world even while PIE runs */
+static UWorld* GetTargetWorld()
+{
+    return GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+}
+
+/** Record a failed entry of a bulk actor request */
+static void AddBulkError(TArray<TSharedPtr<FJsonValue>>& Errors, int32 Index, const FString& Name, const FString& Message)
+{
+    TSharedPtr<FJsonObject> ErrorObject = MakeShared<FJsonObject>();
+    ErrorObject->SetNumberField(TEXT("index"), Index);
+    ErrorObject->SetStringField(TEXT("name"), Name);
+    ErrorObject->SetStringField(TEXT("error"), Message);
+    Errors.Add(MakeShared<FJsonValueObject>(ErrorObject));
+}
+
+/** Record a failed entry of a mesh instance request */
+static void AddInstanceError(TArray<TSharedPtr<FJsonValue>>& Errors, int32 Index, int32 InstanceIndex, const FString& Message)
+{
+    TSharedPtr<FJsonObject> ErrorObject = MakeShared<FJsonObject>();
+    ErrorObject->SetNumberField(TEXT("index"), Index);
+    ErrorObject->SetNumberField(TEXT("instance"), InstanceIndex);
+    ErrorObject->SetStringField(TEXT("error"), Message);
+    Errors.Add(MakeShared<FJsonValueObject>(ErrorObject));
+}
+
+/** Read the instance indices a mesh instance request targets */
+static bool ParseInstanceIndices(const TSharedPtr<FJsonObject>& Params, TArray<int32>& OutIndices, FString& OutError)
+{
+    const TArray<TSharedPtr<FJsonValue>>* IndexArray = nullptr;
+    if (!Params->TryGetArrayField(TEXT("indices"), IndexArray))
     {
-        return HandleDeleteActor(Params);
+        OutError = TEXT("Missing 'indices' parameter");
+        return false;
     }
-    else if (CommandType == TEXT("set_actor_transform"))
+    OutIndices.Reserve(IndexArray->Num());
+    for (const TSharedPtr<FJsonValue>& Value : *IndexArray)
     {
-        return HandleSetActorTransform(Params);
+        OutIndices.Add((int32)Value->AsNumber());
     }
-    else if (CommandType == TEXT("get_actor_properties"))
+    return true;
+}
+
+/**
+ * The instanced mesh component of an actor that draws the 'static_mesh' parameter,
+ * or the actor's only one when the parameter is absent
+ */
+static UHierarchicalInstancedStaticMeshComponent* FindInstanceComponent(FUnrealMCPActorIndex& ActorIndex, const TSharedPtr<FJsonObject>& Params, FString& OutError)
+{
+    FString ActorName;
+    if (!Params->TryGetStringField(TEXT("actor_name"), ActorName))
     {
-        return HandleGetActorProperties(Params);
+        OutError = TEXT("Missing 'actor_name' parameter");
+        return nullptr;
     }
-    else if (CommandType == TEXT("set_actor_property"))
+
+    AActor* Host = ActorIndex.FindActor(GetTargetWorld(), ActorName);
+    if (!Host)
     {
-        return HandleSetActorProperty(Params);
+        OutError = FString::Printf(TEXT("Actor not found: %s"), *ActorName);
+        return nullptr;
     }
-    // Blueprint actor spawning
-    else if (CommandType == TEXT("spawn_blueprint_actor"))
+
+    TInlineComponentArray<UHierarchicalInstancedStaticMeshComponent*> Components(Host);
+    FString MeshPath;
+    if (Params->TryGetStringField(TEXT("static_mesh"), MeshPath) && !MeshPath.IsEmpty())
     {
-        return HandleSpawnBlueprintActor(Params);
+        for (UHierarchicalInstancedStaticMeshComponent* Component : Components)
+        {
+            const UStaticMesh* Mesh = Component->GetStaticMesh();
+            if (Mesh && (Mesh->GetPathName() == MeshPath || Mesh->GetOutermost()->GetName() == MeshPath))
+            {
+                return Component;
+            }
+        }
+        OutError = FString::Printf(TEXT("Actor '%s' has no instances of %s"), *ActorName, *MeshPath);
+        return nullptr;
     }
-    // Editor viewport commands
-    else if (CommandType == TEXT("focus_viewport"))
+
+    if (Components.Num() == 1)
     {
-        return HandleFocusViewport(Params);
+        return Components[0];
     }
-    else if (CommandType == TEXT("take_screenshot"))
+    OutError = Components.Num() == 0
+        ? FString::Printf(TEXT("Actor '%s' has no instanced meshes"), *ActorName)
+        : FString::Printf(TEXT("Actor '%s' has instances of several meshes, pass 'static_mesh'"), *ActorName);
+    return nullptr;
+}
+
+/** Read the optional 'class' parameter, AActor when absent */
+static bool ParseActorClassFilter(const TSharedPtr<FJsonObject>& Params, UClass*& OutClass, FString& OutError)
+{
+    OutClass = AActor::StaticClass();
+    FString ClassName;
+    if (Params->TryGetStringField(TEXT("class"), ClassName) && !ClassName.IsEmpty())
     {
-        return HandleTakeScreenshot(Params);
+        OutClass = FindFirstObject<UClass>(*ClassName, EFindFirstObjectOptions::NativeFirst);
+        if (!OutClass || !OutClass->IsChildOf(AActor::StaticClass()))
+        {
+            OutError = FString::Printf(TEXT("Unknown actor class: %s"), *ClassName);
+            return false;
+        }
     }
-    
-    return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown editor command: %s"), *CommandType));
+    return true;
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetActorsInLevel(const TSharedPtr<FJsonObject>& Params)
+/** Build the actor list of a spatial query response, adding each hit's distance to the requested fields */
+static TArray<TSharedPtr<FJsonValue>> SpatialHitsToJson(const TArray<FUnrealMCPSpatialHit>& Hits, EMCPActorFields Fields)
 {
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
     TArray<TSharedPtr<FJsonValue>> ActorArray;
-    for (AActor* Actor : AllActors)
+    ActorArray.Reserve(Hits.Num());
+    for (const FUnrealMCPSpatialHit& Hit : Hits)
     {
-        if (Actor)
+        TSharedPtr<FJsonObject> ActorObject = FUnrealMCPCommonUtils::ActorToJsonObject(Hit.Actor, Fields);
+        ActorObject->SetNumberField(TEXT("distance"), Hit.Distance);
+        ActorArray.Add(MakeShared<FJsonValueObject>(ActorObject));
+    }
+    return ActorArray;
+}
+
+/** Sort key for paging through actors in a stable order that survives edits between pages */
+struct FActorPageKey
+{
+    FName Name;
+    uint32 UniqueId = 0;
+
+    explicit FActorPageKey(const AActor* Actor)
+        : Name(Actor->GetFName())
+        , UniqueId(Actor->GetUniqueID())
+    {
+    }
+
+    FActorPageKey(FName InName, uint32 InUniqueId)
+        : Name(InName)
+        , UniqueId(InUniqueId)
+    {
+    }
+
+    bool operator<(const FActorPageKey& Other) const
+    {
+        // Names are only unique per level, the object id breaks ties between sublevels
+        const int32 NameOrder = Name.Compare(Other.Name);
+        return NameOrder != 0 ? NameOrder < 0 : UniqueId < Other.UniqueId;
+    }
+
+    FString ToCursor() const
+    {
+        return FString::Printf(TEXT("%s:%u"), *Name.ToString(), UniqueId);
+    }
+
+    static bool FromCursor(const FString& Cursor, FActorPageKey& OutKey)
+    {
+        // Object names can't contain ':', so the last one separates the id
+        FString NamePart, IdPart;
+        if (!Cursor.Split(TEXT(":"), &NamePart, &IdPart, ESearchCase::CaseSensitive, ESearchDir::FromEnd) ||
+            NamePart.IsEmpty() || !IdPart.IsNumeric())
         {
-            ActorArray.Add(FUnrealMCPCommonUtils::ActorToJson(Actor));
+            return false;
         }
+        OutKey = FActorPageKey(FName(*NamePart), (uint32)FCString::Strtoui64(*IdPart, nullptr, 10));
+        return true;
     }
-    
+};
+
+FUnrealMCPEditorCommands::FUnrealMCPEditorCommands()
+    : ActorIndex(MakeShared<FUnrealMCPActorIndex>())
+    , SpatialIndex(MakeShared<FUnrealMCPSpatialIndex>())
+    , LevelJournal(MakeShared<FUnrealMCPLevelJournal>())
+{
+}
+
+void FUnrealMCPEditorCommands::RegisterCommands(FUnrealMCPCommandRegistry& Registry)
+{
+    const FString Category = TEXT("editor");
+
+    Registry.RegisterStreaming(TEXT("get_actors_in_level"), Category, TEXT("List actors in the current level a page at a time, with class, tag, folder and bounds filters"), this, &FUnrealMCPEditorCommands::HandleGetActorsInLevel, EMCPCommandFlags::ReadOnly);
+    Registry.Register(TEXT("get_level_changes_since"), Category, TEXT("List the actors added, removed or changed since a level version"), this, &FUnrealMCPEditorCommands::HandleGetLevelChangesSince, EMCPCommandFlags::ReadOnly);
+    Registry.Register(TEXT("find_actors_by_name"), Category, TEXT("Find actors by name, label, folder or tag with contains, prefix, exact, glob or regex matching"), this, &FUnrealMCPEditorCommands::HandleFindActorsByName, EMCPCommandFlags::ReadOnly);
+    Registry.Register(TEXT("find_actors_in_radius"), Category, TEXT("Find actors whose bounds come within a radius of a point, nearest first"), this, &FUnrealMCPEditorCommands::HandleFindActorsInRadius, EMCPCommandFlags::ReadOnly);
+    Registry.Register(TEXT("find_actors_in_box"), Category, TEXT("Find actors whose bounds overlap or lie inside a box"), this, &FUnrealMCPEditorCommands::HandleFindActorsInBox, EMCPCommandFlags::ReadOnly);
+    Registry.Register(TEXT("find_nearest_actors"), Category, TEXT("Find the actors nearest to a point"), this, &FUnrealMCPEditorCommands::HandleFindNearestActors, EMCPCommandFlags::ReadOnly);
+    Registry.Register(TEXT("find_actors_on_ray"), Category, TEXT("Find the actors whose bounds a ray passes through, in the order it enters them"), this, &FUnrealMCPEditorCommands::HandleFindActorsOnRay, EMCPCommandFlags::ReadOnly);
+    Registry.Register(TEXT("spawn_actor"), Category, TEXT("Spawn a basic actor (static mesh, light, camera) in the level"), this, &FUnrealMCPEditorCommands::HandleSpawnActor);
+    Registry.Register(TEXT("spawn_actors"), Category, TEXT("Spawn many basic actors in one undoable step, reporting errors per actor"), this, &FUnrealMCPEditorCommands::HandleSpawnActors);
+    Registry.Register(TEXT("delete_actor"), Category, TEXT("Delete an actor by name"), this, &FUnrealMCPEditorCommands::HandleDeleteActor);
+    Registry.Register(TEXT("set_actor_transform"), Category, TEXT("Set the location, rotation and scale of an actor"), this, &FUnrealMCPEditorCommands::HandleSetActorTransform);
+    Registry.Register(TEXT("set_actor_transforms"), Category, TEXT("Move many actors in one undoable step, reporting errors per actor"), this, &FUnrealMCPEditorCommands::HandleSetActorTransforms);
+    Registry.Register(TEXT("add_mesh_instances"), Category, TEXT("Place copies of a static mesh as instances on one actor, creating the actor if needed"), this, &FUnrealMCPEditorCommands::HandleAddMeshInstances);
+    Registry.Register(TEXT("update_mesh_instances"), Category, TEXT("Set the transforms of mesh instances by index"), this, &FUnrealMCPEditorCommands::HandleUpdateMeshInstances);
+    Registry.Register(TEXT("remove_mesh_instances"), Category, TEXT("Remove mesh instances by index"), this, &FUnrealMCPEditorCommands::HandleRemoveMeshInstances);
+    Registry.Register(TEXT("get_mesh_instances"), Category, TEXT("List the mesh instances of an actor a page at a time"), this, &FUnrealMCPEditorCommands::HandleGetMeshInstances, EMCPCommandFlags::ReadOnly);
+    Registry.Register(TEXT("get_actor_properties"), Category, TEXT("Get the properties of an actor"), this, &FUnrealMCPEditorCommands::HandleGetActorProperties, EMCPCommandFlags::ReadOnly);
+    Registry.Register(TEXT("set_actor_property"), Category, TEXT("Set a property on an actor"), this, &FUnrealMCPEditorCommands::HandleSetActorProperty);
+    Registry.Register(TEXT("spawn_blueprint_actor"), Category, TEXT("Spawn an actor from a Blueprint class"), this, &FUnrealMCPEditorCommands::HandleSpawnBlueprintActor);
+    Registry.Register(TEXT("focus_viewport"), Category, TEXT("Focus the editor viewport on an actor or location"), this, &FUnrealMCPEditorCommands::HandleFocusViewport);
+    Registry.Register(TEXT("take_screenshot"), Category, TEXT("Capture a screenshot of the editor viewport"), this, &FUnrealMCPEditorCommands::HandleTakeScreenshot);
+
+    // Deprecated alias kept for older clients
+    Registry.Register(TEXT("create_actor"), Category, TEXT("Deprecated alias for spawn_actor"), [this](const TSharedPtr<FJsonObject>& Params)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("'create_actor' command is deprecated and will be removed in a future version. Please use 'spawn_actor' instead."));
+        return HandleSpawnActor(Params);
+    });
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetActorsInLevel(const TSharedPtr<FJsonObject>& Params, FMCPResultWriter& OutWriteResult)
+{
+    EMCPActorFields Fields;
+    FString FieldsError;
+    if (!FUnrealMCPCommonUtils::ParseActorFields(Params, Fields, FieldsError))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FieldsError);
+    }
+
+    // Paging
+    int32 Limit = DefaultActorPageSize;
+    if (Params->TryGetNumberField(TEXT("limit"), Limit))
+    {
+        Limit = FMath::Clamp(Limit, 1, MaxActorPageSize);
+    }
+
+    FString Cursor;
+    FActorPageKey CursorKey(NAME_None, 0);
+    const bool bHasCursor = Params->TryGetStringField(TEXT("cursor"), Cursor) && !Cursor.IsEmpty();
+    if (bHasCursor && !FActorPageKey::FromCursor(Cursor, CursorKey))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Invalid cursor: %s"), *Cursor));
+    }
+
+    // Filters
+    UClass* FilterClass = nullptr;
+    FString ClassError;
+    if (!ParseActorClassFilter(Params, FilterClass, ClassError))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(ClassError);
+    }
+
+    FString TagString;
+    Params->TryGetStringField(TEXT("tag"), TagString);
+    const FName Tag = TagString.IsEmpty() ? NAME_None : FName(*TagString);
+
+    FString Folder;
+    Params->TryGetStringField(TEXT("folder"), Folder);
+
+    const TSharedPtr<FJsonObject>* BoundsObject = nullptr;
+    FBox Bounds(ForceInit);
+    const bool bHasBounds = Params->TryGetObjectField(TEXT("bounds"), BoundsObject);
+    if (bHasBounds)
+    {
+        if (!(*BoundsObject)->HasField(TEXT("min")) || !(*BoundsObject)->HasField(TEXT("max")))
+        {
+            return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("'bounds' needs 'min' and 'max' arrays"));
+        }
+        Bounds = FBox(FUnrealMCPCommonUtils::GetVectorFromJson(*BoundsObject, TEXT("min")),
+                      FUnrealMCPCommonUtils::GetVectorFromJson(*BoundsObject, TEXT("max")));
+    }
+
+    // Changes after this point are journalled, so the returned version is a safe starting point for get_level_changes_since
+    LevelJournal->Prepare(GetTargetWorld());
+
+    // Keep only the first Limit + 1 actors after the cursor, so memory is bounded by the page size
+    // rather than the level size. The extra one tells us whether another page follows.
+    auto LaterFirst = [](const AActor& A, const AActor& B) { return FActorPageKey(&B) < FActorPageKey(&A); };
+    TArray<AActor*> Page;
+    Page.Reserve(Limit + 1);
+    int32 TotalMatching = 0;
+
+    // The class filter narrows the iteration itself, not just the results
+    for (TActorIterator<AActor> It(GetTargetWorld(), FilterClass); It; ++It)
+    {
+        AActor* Actor = *It;
+        if (!Tag.IsNone() && !Actor->ActorHasTag(Tag))
+        {
+            continue;
+        }
+        if (!Folder.IsEmpty())
+        {
+            const FString ActorFolder = Actor->GetFolderPath().ToString();
+            if (!(ActorFolder == Folder || ActorFolder.StartsWith(Folder + TEXT("/"))))
+            {
+                continue;
+            }
+        }
+        if (bHasBounds && !Bounds.IsInsideOrOn(Actor->GetActorLocation()))
+        {
+            continue;
+        }
+
+        ++TotalMatching;
+        if (bHasCursor && !(CursorKey < FActorPageKey(Actor)))
+        {
+            continue;
+        }
+
+        Page.HeapPush(Actor, LaterFirst);
+        if (Page.Num() > Limit + 1)
+        {
+            Page.HeapPopDiscard(LaterFirst);
+        }
+    }
+
+    Page.Sort([](const AActor& A, const AActor& B) { return FActorPageKey(&A) < FActorPageKey(&B); });
+    const bool bHasMore = Page.Num() > Limit;
+    if (bHasMore)
+    {
+        Page.SetNum(Limit);
+    }
+
+    // A page of actors with all fields runs to megabytes, so it's written straight out rather than built as objects
+    const FString NextCursor = bHasMore ? FActorPageKey(Page.Last()).ToCursor() : FString();
+    OutWriteResult = FMCPResultWriter::Make([Page = MoveTemp(Page), Fields, TotalMatching, NextCursor, JournalId = LevelJournal->GetJournalId(),
+                                             Version = LevelJournal->GetVersion()](auto& Writer)
+    {
+        Writer.WriteArrayStart(TEXT("actors"));
+        for (AActor* Actor : Page)
+        {
+            FUnrealMCPCommonUtils::WriteActorJson(Writer, Actor, Fields);
+        }
+        Writer.WriteArrayEnd();
+        Writer.WriteValue(TEXT("total"), TotalMatching);
+        if (!NextCursor.IsEmpty())
+        {
+            Writer.WriteValue(TEXT("next_cursor"), NextCursor);
+        }
+        Writer.WriteValue(TEXT("journal"), JournalId);
+        Writer.WriteValue(TEXT("version"), (double)Version);
+    });
+    return nullptr;
+}
+
+FUnrealMCPLevelJournal& FUnrealMCPEditorCommands::GetLevelJournal()
+{
+    LevelJournal->Prepare(GetTargetWorld());
+    return *LevelJournal;
+}
+
+void FUnrealMCPEditorCommands::NoteActorEdited(AActor* Actor, FName PropertyName)
+{
+    SpatialIndex->UpdateActor(Actor);
+    if (PropertyName.IsNone())
+    {
+        LevelJournal->RecordTransformed(Actor);
+    }
+    else
+    {
+        LevelJournal->RecordPropertyChanged(Actor, PropertyName);
+    }
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetLevelChangesSince(const TSharedPtr<FJsonObject>& Params)
+{
+    double SinceNumber = 0.0;
+    if (!Params->TryGetNumberField(TEXT("version"), SinceNumber) || SinceNumber < 0.0)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing or negative 'version' parameter"));
+    }
+    const uint64 SinceVersion = (uint64)SinceNumber;
+
+    EMCPActorFields Fields;
+    FString Error;
+    if (!FUnrealMCPCommonUtils::ParseActorFields(Params, Fields, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+
+    // A version from another journal means nothing here, e.g. one handed out before the editor restarted
+    FString JournalId;
+    const bool bOtherJournal = Params->TryGetStringField(TEXT("journal"), JournalId) && !JournalId.IsEmpty() && JournalId != GetLevelJournal().GetJournalId();
+
+    return MakeLevelChanges(SinceVersion, !bOtherJournal, Fields);
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::MakeLevelChanges(uint64 SinceVersion, bool bSameJournal, EMCPActorFields Fields)
+{
+    LevelJournal->Prepare(GetTargetWorld());
+
+    TArray<FMCPLevelChange> Changes;
+    const bool bComplete = bSameJournal && LevelJournal->GetChangesSince(SinceVersion, Changes);
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetStringField(TEXT("journal"), LevelJournal->GetJournalId());
+    ResultObj->SetNumberField(TEXT("version"), (double)LevelJournal->GetVersion());
+    ResultObj->SetBoolField(TEXT("resync"), !bComplete);
+    if (!bComplete)
+    {
+        // The caller has to reload the level with get_actors_in_level, which reports the version to continue from
+        ResultObj->SetArrayField(TEXT("changes"), TArray<TSharedPtr<FJsonValue>>());
+        return ResultObj;
+    }
+
+    // Fold the entries into one change per actor, so the result grows with the number of actors touched
+    struct FActorDelta
+    {
+        TWeakObjectPtr<AActor> Actor;
+        FName KnownName;
+        FName CurrentName;
+        bool bAdded = false;
+        bool bRemoved = false;
+        bool bTransformed = false;
+        bool bRenamed = false;
+        TArray<FName> Properties;
+        uint64 LastVersion = 0;
+    };
+    TMap<FObjectKey, FActorDelta> Deltas;
+    for (const FMCPLevelChange& Change : Changes)
+    {
+        FActorDelta* Delta = Deltas.Find(Change.ActorKey);
+        if (!Delta)
+        {
+            Delta = &Deltas.Add(Change.ActorKey);
+            Delta->Actor = Change.Actor;
+            // The name the caller knows the actor by, from before any rename
+            Delta->KnownName = Change.Kind == EMCPLevelChange::Renamed ? Change.Detail : Change.ActorName;
+        }
+
+        Delta->CurrentName = Change.ActorName;
+        Delta->LastVersion = Change.Version;
+        switch (Change.Kind)
+        {
+        case EMCPLevelChange::Added:
+            Delta->bAdded = true;
+            Delta->bRemoved = false;
+            break;
+        case EMCPLevelChange::Removed:
+            Delta->bRemoved = true;
+            break;
+        case EMCPLevelChange::Transformed:
+            Delta->bTransformed = true;
+            break;
+        case EMCPLevelChange::PropertyChanged:
+            if (!Change.Detail.IsNone())
+            {
+                Delta->Properties.AddUnique(Change.Detail);
+            }
+            break;
+        case EMCPLevelChange::Renamed:
+            Delta->bRenamed = true;
+            break;
+        }
+    }
+
+    TArray<FActorDelta*> Ordered;
+    Ordered.Reserve(Deltas.Num());
+    for (TPair<FObjectKey, FActorDelta>& Pair : Deltas)
+    {
+        Ordered.Add(&Pair.Value);
+    }
+    Ordered.Sort([](const FActorDelta& A, const FActorDelta& B) { return A.LastVersion < B.LastVersion; });
+
+    TArray<TSharedPtr<FJsonValue>> ChangeArray;
+    ChangeArray.Reserve(Ordered.Num());
+    for (const FActorDelta* Delta : Ordered)
+    {
+        AActor* Actor = Delta->Actor.Get();
+        const bool bGone = Delta->bRemoved || !IsValid(Actor);
+        if (Delta->bAdded && bGone)
+        {
+            // Came and went since the caller last looked
+            continue;
+        }
+
+        TSharedPtr<FJsonObject> ChangeObject = MakeShared<FJsonObject>();
+        if (bGone)
+        {
+            ChangeObject->SetStringField(TEXT("change"), TEXT("removed"));
+            ChangeObject->SetStringField(TEXT("name"), Delta->KnownName.ToString());
+        }
+        else
+        {
+            ChangeObject->SetStringField(TEXT("change"), Delta->bAdded ? TEXT("added") : TEXT("modified"));
+            ChangeObject->SetStringField(TEXT("name"), Delta->CurrentName.ToString());
+            if (!Delta->bAdded)
+            {
+                if (Delta->bRenamed && Delta->KnownName != Delta->CurrentName)
+                {
+                    ChangeObject->SetStringField(TEXT("old_name"), Delta->KnownName.ToString());
+                }
+                ChangeObject->SetBoolField(TEXT("transformed"), Delta->bTransformed);
+
+                TArray<TSharedPtr<FJsonValue>> PropertyArray;
+                for (const FName& Property : Delta->Properties)
+                {
+                    PropertyArray.Add(MakeShared<FJsonValueString>(Property.ToString()));
+                }
+                ChangeObject->SetArrayField(TEXT("properties"), PropertyArray);
+            }
+            ChangeObject->SetObjectField(TEXT("actor"), FUnrealMCPCommonUtils::ActorToJsonObject(Actor, Fields));
+        }
+        ChangeArray.Add(MakeShared<FJsonValueObject>(ChangeObject));
+    }
+
+    ResultObj->SetArrayField(TEXT("changes"), ChangeArray);
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFindActorsByName(const TSharedPtr<FJsonObject>& Params)
+{
+    FString Pattern;
+    if (!Params->TryGetStringField(TEXT("pattern"), Pattern))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'pattern' parameter"));
+    }
+
+    FString Mode = TEXT("contains");
+    Params->TryGetStringField(TEXT("mode"), Mode);
+    Mode.ToLowerInline();
+    if (Mode != TEXT("contains") && Mode != TEXT("prefix") && Mode != TEXT("exact") && Mode != TEXT("glob") && Mode != TEXT("regex"))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown mode '%s', expected contains, prefix, exact, glob or regex"), *Mode));
+    }
+
+    bool bCaseSensitive = false;
+    Params->TryGetBoolField(TEXT("case_sensitive"), bCaseSensitive);
+    const ESearchCase::Type SearchCase = bCaseSensitive ? ESearchCase::CaseSensitive : ESearchCase::IgnoreCase;
+
+    // What to match the pattern against, the object name unless told otherwise
+    bool bMatchName = true;
+    bool bMatchLabel = false;
+    bool bMatchFolder = false;
+    bool bMatchTag = false;
+    const TArray<TSharedPtr<FJsonValue>>* MatchArray = nullptr;
+    if (Params->TryGetArrayField(TEXT("match"), MatchArray))
+    {
+        bMatchName = false;
+        for (const TSharedPtr<FJsonValue>& Value : *MatchArray)
+        {
+            const FString Key = Value->AsString().ToLower();
+            if (Key == TEXT("name"))
+            {
+                bMatchName = true;
+            }
+            else if (Key == TEXT("label"))
+            {
+                bMatchLabel = true;
+            }
+            else if (Key == TEXT("folder"))
+            {
+                bMatchFolder = true;
+            }
+            else if (Key == TEXT("tag"))
+            {
+                bMatchTag = true;
+            }
+            else
+            {
+                return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown match key '%s', expected name, label, folder or tag"), *Key));
+            }
+        }
+    }
+
+    EMCPActorFields Fields;
+    UClass* FilterClass = nullptr;
+    FString Error;
+    if (!FUnrealMCPCommonUtils::ParseActorFields(Params, Fields, Error) || !ParseActorClassFilter(Params, FilterClass, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+
+    int32 Limit = DefaultActorPageSize;
+    if (Params->TryGetNumberField(TEXT("limit"), Limit))
+    {
+        Limit = FMath::Clamp(Limit, 1, MaxActorPageSize);
+    }
+
+    // Collect one more than the limit to know whether the results were cut off
+    TArray<AActor*> Matches;
+    TSet<AActor*> Seen;
+    auto AddMatch = [&Matches, &Seen, Limit](AActor* Actor)
+    {
+        bool bAlreadyMatched = false;
+        Seen.Add(Actor, &bAlreadyMatched);
+        if (!bAlreadyMatched)
+        {
+            Matches.Add(Actor);
+        }
+        return Matches.Num() <= Limit;
+    };
+
+    if (Mode == TEXT("prefix") && !bMatchFolder && !bMatchTag)
+    {
+        // Served from the sorted name index, so the cost depends on the matches rather than the level size
+        ActorIndex->ForEachWithPrefix(GetTargetWorld(), Pattern, bMatchName, bMatchLabel, [&](AActor* Actor)
+        {
+            if (!Actor->IsA(FilterClass))
+            {
+                return true;
+            }
+            if (bCaseSensitive &&
+                !(bMatchName && Actor->GetName().StartsWith(Pattern, ESearchCase::CaseSensitive)) &&
+                !(bMatchLabel && Actor->GetActorLabel().StartsWith(Pattern, ESearchCase::CaseSensitive)))
+            {
+                return true;
+            }
+            return AddMatch(Actor);
+        });
+    }
+    else
+    {
+        TOptional<FRegexPattern> Regex;
+        if (Mode == TEXT("regex"))
+        {
+            Regex.Emplace(Pattern, bCaseSensitive ? ERegexPatternFlags::None : ERegexPatternFlags::CaseInsensitive);
+        }
+
+        auto MatchesPattern = [&](const FString& Candidate)
+        {
+            if (Mode == TEXT("contains"))
+            {
+                return Candidate.Contains(Pattern, SearchCase);
+            }
+            if (Mode == TEXT("prefix"))
+            {
+                return Candidate.StartsWith(Pattern, SearchCase);
+            }
+            if (Mode == TEXT("exact"))
+            {
+                return Candidate.Equals(Pattern, SearchCase);
+            }
+            if (Mode == TEXT("glob"))
+            {
+                return Candidate.MatchesWildcard(Pattern, SearchCase);
+            }
+            FRegexMatcher Matcher(Regex.GetValue(), Candidate);
+            return Matcher.FindNext();
+        };
+
+        for (TActorIterator<AActor> It(GetTargetWorld(), FilterClass); It; ++It)
+        {
+            AActor* Actor = *It;
+            bool bMatched = (bMatchName && MatchesPattern(Actor->GetName())) ||
+                            (bMatchLabel && MatchesPattern(Actor->GetActorLabel())) ||
+                            (bMatchFolder && MatchesPattern(Actor->GetFolderPath().ToString()));
+            if (!bMatched && bMatchTag)
+            {
+                for (const FName& Tag : Actor->Tags)
+                {
+                    if (MatchesPattern(Tag.ToString()))
+                    {
+                        bMatched = true;
+                        break;
+                    }
+                }
+            }
+            if (bMatched && !AddMatch(Actor))
+            {
+                break;
+            }
+        }
+    }
+
+    const bool bTruncated = Matches.Num() > Limit;
+    if (bTruncated)
+    {
+        Matches.SetNum(Limit);
+    }
+
+    TArray<TSharedPtr<FJsonValue>> ActorArray;
+    ActorArray.Reserve(Matches.Num());
+    for (AActor* Actor : Matches)
+    {
+        ActorArray.Add(MakeShared<FJsonValueObject>(FUnrealMCPCommonUtils::ActorToJsonObject(Actor, Fields)));
+    }
+
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
     ResultObj->SetArrayField(TEXT("actors"), ActorArray);
-    
+    ResultObj->SetBoolField(TEXT("truncated"), bTruncated);
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFindActorsInRadius(const TSharedPtr<FJsonObject>& Params)
+{
+    if (!Params->HasField(TEXT("center")))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'center' parameter"));
+    }
+    double Radius = 0.0;
+    if (!Params->TryGetNumberField(TEXT("radius"), Radius) || Radius < 0.0)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing or negative 'radius' parameter"));
+    }
+
+    EMCPActorFields Fields;
+    UClass* FilterClass = nullptr;
+    FString Error;
+    if (!FUnrealMCPCommonUtils::ParseActorFields(Params, Fields, Error) || !ParseActorClassFilter(Params, FilterClass, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+
+    int32 Limit = DefaultActorPageSize;
+    if (Params->TryGetNumberField(TEXT("limit"), Limit))
+    {
+        Limit = FMath::Clamp(Limit, 1, MaxActorPageSize);
+    }
+
+    TArray<FUnrealMCPSpatialHit> Hits;
+    SpatialIndex->FindInRadius(GetTargetWorld(), FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("center")), Radius,
+        [FilterClass](const AActor* Actor) { return Actor->IsA(FilterClass); }, Hits);
+
+    const int32 Total = Hits.Num();
+    if (Hits.Num() > Limit)
+    {
+        Hits.SetNum(Limit);
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetArrayField(TEXT("actors"), SpatialHitsToJson(Hits, Fields));
+    ResultObj->SetNumberField(TEXT("total"), Total);
     return ResultObj;
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFindActorsByName(const TSharedPtr<FJsonObject>& Params)
-{
-    FString Pattern;
-    if (!Params->TryGetStringField(TEXT("pattern"), Pattern))
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFindActorsInBox(const TSharedPtr<FJsonObject>& Params)
+{
+    if (!Params->HasField(TEXT("min")) || !Params->HasField(TEXT("max")))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'min' or 'max' parameter"));
+    }
+
+    EMCPActorFields Fields;
+    UClass* FilterClass = nullptr;
+    FString Error;
+    if (!FUnrealMCPCommonUtils::ParseActorFields(Params, Fields, Error) || !ParseActorClassFilter(Params, FilterClass, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+
+    int32 Limit = DefaultActorPageSize;
+    if (Params->TryGetNumberField(TEXT("limit"), Limit))
+    {
+        Limit = FMath::Clamp(Limit, 1, MaxActorPageSize);
+    }
+
+    bool bContained = false;
+    Params->TryGetBoolField(TEXT("contained"), bContained);
+
+    const FVector Min = FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("min"));
+    const FVector Max = FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("max"));
+
+    TArray<FUnrealMCPSpatialHit> Hits;
+    SpatialIndex->FindInBox(GetTargetWorld(), FBox(Min.ComponentMin(Max), Min.ComponentMax(Max)), bContained,
+        [FilterClass](const AActor* Actor) { return Actor->IsA(FilterClass); }, Hits);
+
+    // Name order, so the same box gives the same page however the octree happens to be laid out
+    Hits.Sort([](const FUnrealMCPSpatialHit& A, const FUnrealMCPSpatialHit& B)
+    {
+        return A.Actor->GetFName().Compare(B.Actor->GetFName()) < 0;
+    });
+
+    const int32 Total = Hits.Num();
+    if (Hits.Num() > Limit)
+    {
+        Hits.SetNum(Limit);
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetArrayField(TEXT("actors"), SpatialHitsToJson(Hits, Fields));
+    ResultObj->SetNumberField(TEXT("total"), Total);
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFindNearestActors(const TSharedPtr<FJsonObject>& Params)
+{
+    if (!Params->HasField(TEXT("location")))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'location' parameter"));
+    }
+
+    EMCPActorFields Fields;
+    UClass* FilterClass = nullptr;
+    FString Error;
+    if (!FUnrealMCPCommonUtils::ParseActorFields(Params, Fields, Error) || !ParseActorClassFilter(Params, FilterClass, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+
+    int32 Count = 1;
+    if (Params->TryGetNumberField(TEXT("count"), Count))
+    {
+        Count = FMath::Clamp(Count, 1, MaxActorPageSize);
+    }
+
+    double MaxDistance = 0.0;
+    Params->TryGetNumberField(TEXT("max_distance"), MaxDistance);
+
+    // Lets a caller ask for the neighbours of an actor without getting the actor itself back
+    TSet<FName> Excluded;
+    const TArray<TSharedPtr<FJsonValue>>* ExcludeArray = nullptr;
+    if (Params->TryGetArrayField(TEXT("exclude"), ExcludeArray))
+    {
+        for (const TSharedPtr<FJsonValue>& Value : *ExcludeArray)
+        {
+            Excluded.Add(FName(*Value->AsString()));
+        }
+    }
+
+    TArray<FUnrealMCPSpatialHit> Hits;
+    SpatialIndex->FindNearest(GetTargetWorld(), FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("location")), Count, MaxDistance,
+        [FilterClass, &Excluded](const AActor* Actor) { return Actor->IsA(FilterClass) && !Excluded.Contains(Actor->GetFName()); }, Hits);
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetArrayField(TEXT("actors"), SpatialHitsToJson(Hits, Fields));
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFindActorsOnRay(const TSharedPtr<FJsonObject>& Params)
+{
+    if (!Params->HasField(TEXT("origin")) || !Params->HasField(TEXT("direction")))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'origin' or 'direction' parameter"));
+    }
+
+    const FVector Origin = FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("origin"));
+    const FVector Direction = FUnrealMCPCommonUtils::GetVectorFromJson(Params, TEXT("direction")).GetSafeNormal();
+    if (Direction.IsZero())
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("'direction' must not be zero"));
+    }
+
+    EMCPActorFields Fields;
+    UClass* FilterClass = nullptr;
+    FString Error;
+    if (!FUnrealMCPCommonUtils::ParseActorFields(Params, Fields, Error) || !ParseActorClassFilter(Params, FilterClass, Error))
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'pattern' parameter"));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
     }
-    
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    TArray<TSharedPtr<FJsonValue>> MatchingActors;
-    for (AActor* Actor : AllActors)
+
+    int32 Limit = 1;
+    if (Params->TryGetNumberField(TEXT("limit"), Limit))
     {
-        if (Actor && Actor->GetName().Contains(Pattern))
-        {
-            MatchingActors.Add(FUnrealMCPCommonUtils::ActorToJson(Actor));
-        }
+        Limit = FMath::Clamp(Limit, 1, MaxActorPageSize);
     }
-    
+
+    double MaxDistance = DefaultRayDistance;
+    Params->TryGetNumberField(TEXT("max_distance"), MaxDistance);
+
+    TArray<FUnrealMCPSpatialHit> Hits;
+    SpatialIndex->FindOnRay(GetTargetWorld(), Origin, Direction, MaxDistance, Limit,
+        [FilterClass](const AActor* Actor) { return Actor->IsA(FilterClass); }, Hits);
+
+    TArray<TSharedPtr<FJsonValue>> ActorArray = SpatialHitsToJson(Hits, Fields);
+    for (int32 Index = 0; Index < Hits.Num(); ++Index)
+    {
+        const FVector HitLocation = Origin + Direction * Hits[Index].Distance;
+        TArray<TSharedPtr<FJsonValue>> LocationArray;
+        LocationArray.Add(MakeShared<FJsonValueNumber>(HitLocation.X));
+        LocationArray.Add(MakeShared<FJsonValueNumber>(HitLocation.Y));
+        LocationArray.Add(MakeShared<FJsonValueNumber>(HitLocation.Z));
+        ActorArray[Index]->AsObject()->SetArrayField(TEXT("hit_location"), LocationArray);
+    }
+
     TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-    ResultObj->SetArrayField(TEXT("actors"), MatchingActors);
-    
+    ResultObj->SetArrayField(TEXT("actors"), ActorArray);
     return ResultObj;
 }
 
@@ -160,7 +1098,7 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnActor(const TShared
 
     // Create the actor based on type
     AActor* NewActor = nullptr;
-    UWorld* World = GEditor->GetEditorWorldContext().World();
+    UWorld* World = GetTargetWorld();
 
     if (!World)
     {
@@ -168,43 +1106,20 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnActor(const TShared
     }
 
     // Check if an actor with this name already exists
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(World, AActor::StaticClass(), AllActors);
-    for (AActor* Actor : AllActors)
+    if (ActorIndex->FindActor(World, ActorName))
     {
-        if (Actor && Actor->GetName() == ActorName)
-        {
-            return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor with name '%s' already exists"), *ActorName));
-        }
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor with name '%s' already exists"), *ActorName));
     }
 
     FActorSpawnParameters SpawnParams;
     SpawnParams.Name = *ActorName;
 
-    if (ActorType == TEXT("StaticMeshActor"))
-    {
-        NewActor = World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Location, Rotation, SpawnParams);
-    }
-    else if (ActorType == TEXT("PointLight"))
-    {
-        NewActor = World->SpawnActor<APointLight>(APointLight::StaticClass(), Location, Rotation, SpawnParams);
-    }
-    else if (ActorType == TEXT("SpotLight"))
-    {
-        NewActor = World->SpawnActor<ASpotLight>(ASpotLight::StaticClass(), Location, Rotation, SpawnParams);
-    }
-    else if (ActorType == TEXT("DirectionalLight"))
-    {
-        NewActor = World->SpawnActor<ADirectionalLight>(ADirectionalLight::StaticClass(), Location, Rotation, SpawnParams);
-    }
-    else if (ActorType == TEXT("CameraActor"))
-    {
-        NewActor = World->SpawnActor<ACameraActor>(ACameraActor::StaticClass(), Location, Rotation, SpawnParams);
-    }
-    else
+    UClass* ActorClass = FindSpawnableActorClass(ActorType);
+    if (!ActorClass)
     {
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown actor type: %s"), *ActorType));
     }
+    NewActor = World->SpawnActor<AActor>(ActorClass, Location, Rotation, SpawnParams);
 
     if (NewActor)
     {
@@ -212,14 +1127,96 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnActor(const TShared
         FTransform Transform = NewActor->GetTransform();
         Transform.SetScale3D(Scale);
         NewActor->SetActorTransform(Transform);
+        NoteActorEdited(NewActor);
 
         // Return the created actor's details
-        return FUnrealMCPCommonUtils::ActorToJsonObject(NewActor, true);
+        return FUnrealMCPCommonUtils::ActorToJsonObject(NewActor);
     }
 
     return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to create actor"));
 }
 
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnActors(const TSharedPtr<FJsonObject>& Params)
+{
+    TArray<FBulkActorItem> Items;
+    FString Error;
+    if (!ParseBulkActorItems(Params, Items, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+
+    // Entries without their own type use the request's
+    FString DefaultType;
+    Params->TryGetStringField(TEXT("type"), DefaultType);
+
+    UWorld* World = GetTargetWorld();
+    if (!World)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get editor world"));
+    }
+
+    // One undo step for the whole request
+    const FScopedTransaction Transaction(LOCTEXT("MCPSpawnActors", "Spawn Actors"));
+
+    TSet<FName> RequestedNames;
+    RequestedNames.Reserve(Items.Num());
+    TArray<TSharedPtr<FJsonValue>> Errors;
+    int32 SpawnedCount = 0;
+
+    for (int32 Index = 0; Index < Items.Num(); ++Index)
+    {
+        const FBulkActorItem& Item = Items[Index];
+        if (Item.Name.IsEmpty())
+        {
+            AddBulkError(Errors, Index, Item.Name, TEXT("Missing 'name'"));
+            continue;
+        }
+
+        bool bDuplicate = false;
+        RequestedNames.Add(FName(*Item.Name), &bDuplicate);
+        if (bDuplicate)
+        {
+            AddBulkError(Errors, Index, Item.Name, TEXT("Name appears more than once in the request"));
+            continue;
+        }
+        if (ActorIndex->FindActor(World, Item.Name))
+        {
+            AddBulkError(Errors, Index, Item.Name, FString::Printf(TEXT("Actor with name '%s' already exists"), *Item.Name));
+            continue;
+        }
+
+        const FString& ActorType = Item.Type.IsEmpty() ? DefaultType : Item.Type;
+        UClass* ActorClass = FindSpawnableActorClass(ActorType);
+        if (!ActorClass)
+        {
+            AddBulkError(Errors, Index, Item.Name, FString::Printf(TEXT("Unknown actor type: %s"), *ActorType));
+            continue;
+        }
+
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.Name = *Item.Name;
+        const FTransform SpawnTransform(
+            Item.Rotation.Get(FRotator::ZeroRotator),
+            Item.Location.Get(FVector::ZeroVector),
+            Item.Scale.Get(FVector::OneVector));
+
+        AActor* NewActor = World->SpawnActor<AActor>(ActorClass, SpawnTransform, SpawnParams);
+        if (!NewActor)
+        {
+            AddBulkError(Errors, Index, Item.Name, TEXT("Failed to create actor"));
+            continue;
+        }
+        NoteActorEdited(NewActor);
+        ++SpawnedCount;
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetNumberField(TEXT("spawned"), SpawnedCount);
+    ResultObj->SetNumberField(TEXT("failed"), Errors.Num());
+    ResultObj->SetArrayField(TEXT("errors"), Errors);
+    return ResultObj;
+}
+
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleDeleteActor(const TSharedPtr<FJsonObject>& Params)
 {
     FString ActorName;
@@ -228,26 +1225,21 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleDeleteActor(const TShare
         return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'name' parameter"));
     }
 
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    for (AActor* Actor : AllActors)
+    AActor* Actor = ActorIndex->FindActor(GetTargetWorld(), ActorName);
+    if (!Actor)
     {
-        if (Actor && Actor->GetName() == ActorName)
-        {
-            // Store actor info before deletion for the response
-            TSharedPtr<FJsonObject> ActorInfo = FUnrealMCPCommonUtils::ActorToJsonObject(Actor);
-            
-            // Delete the actor
-            Actor->Destroy();
-            
-            TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
-            ResultObj->SetObjectField(TEXT("deleted_actor"), ActorInfo);
-            return ResultObj;
-        }
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor not found: %s"), *ActorName));
     }
+
+    // Store actor info before deletion for the response
+    TSharedPtr<FJsonObject> ActorInfo = FUnrealMCPCommonUtils::ActorToJsonObject(Actor);
+    
+    // Delete the actor
+    Actor->Destroy();
     
-    return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor not found: %s"), *ActorName));
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetObjectField(TEXT("deleted_actor"), ActorInfo);
+    return ResultObj;
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorTransform(const TSharedPtr<FJsonObject>& Params)
@@ -260,18 +1252,7 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorTransform(const
     }
 
     // Find the actor
-    AActor* TargetActor = nullptr;
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    for (AActor* Actor : AllActors)
-    {
-        if (Actor && Actor->GetName() == ActorName)
-        {
-            TargetActor = Actor;
-            break;
-        }
-    }
+    AActor* TargetActor = ActorIndex->FindActor(GetTargetWorld(), ActorName);
 
     if (!TargetActor)
     {
@@ -296,9 +1277,374 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorTransform(const
 
     // Set the new transform
     TargetActor->SetActorTransform(NewTransform);
+    NoteActorEdited(TargetActor);
 
     // Return updated actor info
-    return FUnrealMCPCommonUtils::ActorToJsonObject(TargetActor, true);
+    return FUnrealMCPCommonUtils::ActorToJsonObject(TargetActor);
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorTransforms(const TSharedPtr<FJsonObject>& Params)
+{
+    TArray<FBulkActorItem> Items;
+    FString Error;
+    if (!ParseBulkActorItems(Params, Items, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+
+    // One undo step for the whole request
+    const FScopedTransaction Transaction(LOCTEXT("MCPSetActorTransforms", "Set Actor Transforms"));
+
+    TArray<TSharedPtr<FJsonValue>> Errors;
+    int32 UpdatedCount = 0;
+    UWorld* World = GetTargetWorld();
+
+    for (int32 Index = 0; Index < Items.Num(); ++Index)
+    {
+        const FBulkActorItem& Item = Items[Index];
+        AActor* TargetActor = ActorIndex->FindActor(World, Item.Name);
+        if (!TargetActor)
+        {
+            AddBulkError(Errors, Index, Item.Name, FString::Printf(TEXT("Actor not found: %s"), *Item.Name));
+            continue;
+        }
+
+        FTransform NewTransform = TargetActor->GetTransform();
+        if (Item.Location.IsSet())
+        {
+            NewTransform.SetLocation(Item.Location.GetValue());
+        }
+        if (Item.Rotation.IsSet())
+        {
+            NewTransform.SetRotation(FQuat(Item.Rotation.GetValue()));
+        }
+        if (Item.Scale.IsSet())
+        {
+            NewTransform.SetScale3D(Item.Scale.GetValue());
+        }
+
+        TargetActor->Modify();
+        TargetActor->SetActorTransform(NewTransform);
+        NoteActorEdited(TargetActor);
+        ++UpdatedCount;
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetNumberField(TEXT("updated"), UpdatedCount);
+    ResultObj->SetNumberField(TEXT("failed"), Errors.Num());
+    ResultObj->SetArrayField(TEXT("errors"), Errors);
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleAddMeshInstances(const TSharedPtr<FJsonObject>& Params)
+{
+    FString ActorName;
+    if (!Params->TryGetStringField(TEXT("actor_name"), ActorName))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'actor_name' parameter"));
+    }
+
+    FString MeshPath;
+    if (!Params->TryGetStringField(TEXT("static_mesh"), MeshPath))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'static_mesh' parameter"));
+    }
+    UStaticMesh* Mesh = Cast<UStaticMesh>(UEditorAssetLibrary::LoadAsset(MeshPath));
+    if (!Mesh)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Static mesh not found: %s"), *MeshPath));
+    }
+
+    TArray<FBulkActorItem> Items;
+    FString Error;
+    if (!ParseInstanceItems(Params, Items, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+
+    bool bWorldSpace = true;
+    Params->TryGetBoolField(TEXT("world_space"), bWorldSpace);
+
+    UWorld* World = GetTargetWorld();
+    if (!World)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get editor world"));
+    }
+
+    const FScopedTransaction Transaction(LOCTEXT("MCPAddMeshInstances", "Add Mesh Instances"));
+
+    // All instances of a mesh on one actor share a component, and so a draw call per cluster rather than per copy
+    AActor* Host = ActorIndex->FindActor(World, ActorName);
+    if (!Host)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.Name = *ActorName;
+        Host = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+        if (!Host)
+        {
+            return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to create instance actor"));
+        }
+    }
+
+    UHierarchicalInstancedStaticMeshComponent* Component = nullptr;
+    TInlineComponentArray<UHierarchicalInstancedStaticMeshComponent*> Components(Host);
+    for (UHierarchicalInstancedStaticMeshComponent* Existing : Components)
+    {
+        if (Existing->GetStaticMesh() == Mesh)
+        {
+            Component = Existing;
+            break;
+        }
+    }
+
+    if (!Component)
+    {
+        Host->Modify();
+        Component = NewObject<UHierarchicalInstancedStaticMeshComponent>(Host, NAME_None, RF_Transactional);
+        Component->SetStaticMesh(Mesh);
+        if (USceneComponent* Root = Host->GetRootComponent())
+        {
+            Component->SetupAttachment(Root);
+        }
+        else
+        {
+            Host->SetRootComponent(Component);
+        }
+        Host->AddInstanceComponent(Component);
+        Component->RegisterComponent();
+    }
+
+    TArray<FTransform> Transforms;
+    Transforms.Reserve(Items.Num());
+    for (const FBulkActorItem& Item : Items)
+    {
+        Transforms.Emplace(Item.Rotation.Get(FRotator::ZeroRotator), Item.Location.Get(FVector::ZeroVector), Item.Scale.Get(FVector::OneVector));
+    }
+
+    Component->Modify();
+    const TArray<int32> NewIndices = Component->AddInstances(Transforms, true, bWorldSpace);
+    NoteActorEdited(Host, InstancesPropertyName);
+
+    TArray<TSharedPtr<FJsonValue>> IndexArray;
+    IndexArray.Reserve(NewIndices.Num());
+    for (int32 NewIndex : NewIndices)
+    {
+        IndexArray.Add(MakeShared<FJsonValueNumber>(NewIndex));
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetStringField(TEXT("actor_name"), Host->GetName());
+    ResultObj->SetStringField(TEXT("static_mesh"), Mesh->GetPathName());
+    ResultObj->SetArrayField(TEXT("indices"), IndexArray);
+    ResultObj->SetNumberField(TEXT("instance_count"), Component->GetInstanceCount());
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleUpdateMeshInstances(const TSharedPtr<FJsonObject>& Params)
+{
+    FString Error;
+    UHierarchicalInstancedStaticMeshComponent* Component = FindInstanceComponent(*ActorIndex, Params, Error);
+    TArray<int32> Indices;
+    TArray<FBulkActorItem> Items;
+    if (!Component || !ParseInstanceIndices(Params, Indices, Error) || !ParseInstanceItems(Params, Items, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+    if (Items.Num() != Indices.Num())
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Got %d transforms for %d indices"), Items.Num(), Indices.Num()));
+    }
+
+    bool bWorldSpace = true;
+    Params->TryGetBoolField(TEXT("world_space"), bWorldSpace);
+
+    const FScopedTransaction Transaction(LOCTEXT("MCPUpdateMeshInstances", "Update Mesh Instances"));
+    Component->Modify();
+
+    TArray<TSharedPtr<FJsonValue>> Errors;
+    int32 UpdatedCount = 0;
+    for (int32 Index = 0; Index < Indices.Num(); ++Index)
+    {
+        const int32 InstanceIndex = Indices[Index];
+        FTransform InstanceTransform;
+        if (!Component->GetInstanceTransform(InstanceIndex, InstanceTransform, bWorldSpace))
+        {
+            AddInstanceError(Errors, Index, InstanceIndex, TEXT("No instance with this index"));
+            continue;
+        }
+
+        // Parts an 'instances' entry leaves out keep their current value
+        const FBulkActorItem& Item = Items[Index];
+        if (Item.Location.IsSet())
+        {
+            InstanceTransform.SetLocation(Item.Location.GetValue());
+        }
+        if (Item.Rotation.IsSet())
+        {
+            InstanceTransform.SetRotation(FQuat(Item.Rotation.GetValue()));
+        }
+        if (Item.Scale.IsSet())
+        {
+            InstanceTransform.SetScale3D(Item.Scale.GetValue());
+        }
+
+        // Render state is refreshed once for the whole request below
+        Component->UpdateInstanceTransform(InstanceIndex, InstanceTransform, bWorldSpace, false, true);
+        ++UpdatedCount;
+    }
+    Component->MarkRenderStateDirty();
+    NoteActorEdited(Component->GetOwner(), InstancesPropertyName);
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetNumberField(TEXT("updated"), UpdatedCount);
+    ResultObj->SetNumberField(TEXT("failed"), Errors.Num());
+    ResultObj->SetArrayField(TEXT("errors"), Errors);
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleRemoveMeshInstances(const TSharedPtr<FJsonObject>& Params)
+{
+    FString Error;
+    UHierarchicalInstancedStaticMeshComponent* Component = FindInstanceComponent(*ActorIndex, Params, Error);
+    TArray<int32> Indices;
+    if (!Component || !ParseInstanceIndices(Params, Indices, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+
+    TArray<TSharedPtr<FJsonValue>> Errors;
+    TSet<int32> Seen;
+    TArray<int32> ToRemove;
+    ToRemove.Reserve(Indices.Num());
+    for (int32 Index = 0; Index < Indices.Num(); ++Index)
+    {
+        const int32 InstanceIndex = Indices[Index];
+        bool bDuplicate = false;
+        Seen.Add(InstanceIndex, &bDuplicate);
+        if (bDuplicate)
+        {
+            AddInstanceError(Errors, Index, InstanceIndex, TEXT("Index appears more than once in the request"));
+        }
+        else if (!Component->IsValidInstance(InstanceIndex))
+        {
+            AddInstanceError(Errors, Index, InstanceIndex, TEXT("No instance with this index"));
+        }
+        else
+        {
+            ToRemove.Add(InstanceIndex);
+        }
+    }
+
+    // Whether the engine shifts or swaps on removal differs between component types, so compact explicitly:
+    // the survivors past the new end move into the holes below it, then only the tail is removed
+    const int32 NewCount = Component->GetInstanceCount() - ToRemove.Num();
+    ToRemove.Sort();
+    TArray<int32> Holes;
+    for (const int32 InstanceIndex : ToRemove)
+    {
+        if (InstanceIndex < NewCount)
+        {
+            Holes.Add(InstanceIndex);
+        }
+    }
+
+    const FScopedTransaction Transaction(LOCTEXT("MCPRemoveMeshInstances", "Remove Mesh Instances"));
+    Component->Modify();
+    TArray<TSharedPtr<FJsonValue>> Moved;
+    const TSet<int32> Removed(ToRemove);
+    int32 From = NewCount;
+    const int32 NumCustomData = Component->NumCustomDataFloats;
+    for (const int32 To : Holes)
+    {
+        while (Removed.Contains(From))
+        {
+            ++From;
+        }
+
+        FTransform InstanceTransform;
+        Component->GetInstanceTransform(From, InstanceTransform, false);
+        Component->UpdateInstanceTransform(To, InstanceTransform, false, false, true);
+        if (NumCustomData > 0)
+        {
+            const TArray<float> CustomData(&Component->PerInstanceSMCustomData[From * NumCustomData], NumCustomData);
+            Component->SetCustomData(To, CustomData, false);
+        }
+
+        TSharedPtr<FJsonObject> MoveObj = MakeShared<FJsonObject>();
+        MoveObj->SetNumberField(TEXT("from"), From);
+        MoveObj->SetNumberField(TEXT("to"), To);
+        Moved.Add(MakeShared<FJsonValueObject>(MoveObj));
+        ++From;
+    }
+
+    if (ToRemove.Num() > 0)
+    {
+        TArray<int32> Tail;
+        Tail.Reserve(ToRemove.Num());
+        for (int32 InstanceIndex = NewCount; InstanceIndex < NewCount + ToRemove.Num(); ++InstanceIndex)
+        {
+            Tail.Add(InstanceIndex);
+        }
+        Component->RemoveInstances(Tail);
+    }
+    NoteActorEdited(Component->GetOwner(), InstancesPropertyName);
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetNumberField(TEXT("removed"), ToRemove.Num());
+    ResultObj->SetNumberField(TEXT("failed"), Errors.Num());
+    ResultObj->SetArrayField(TEXT("errors"), Errors);
+    ResultObj->SetArrayField(TEXT("moved"), Moved);
+    ResultObj->SetNumberField(TEXT("instance_count"), Component->GetInstanceCount());
+    return ResultObj;
+}
+
+TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetMeshInstances(const TSharedPtr<FJsonObject>& Params)
+{
+    FString Error;
+    UHierarchicalInstancedStaticMeshComponent* Component = FindInstanceComponent(*ActorIndex, Params, Error);
+    if (!Component)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+
+    int32 Offset = 0;
+    Params->TryGetNumberField(TEXT("offset"), Offset);
+    Offset = FMath::Max(Offset, 0);
+
+    int32 Limit = DefaultActorPageSize;
+    if (Params->TryGetNumberField(TEXT("limit"), Limit))
+    {
+        Limit = FMath::Clamp(Limit, 1, MaxActorPageSize);
+    }
+
+    bool bWorldSpace = true;
+    Params->TryGetBoolField(TEXT("world_space"), bWorldSpace);
+
+    const int32 InstanceCount = Component->GetInstanceCount();
+    const int32 End = FMath::Min(InstanceCount, Offset + Limit);
+
+    // Packed like the transforms add_mesh_instances takes, so a page can be edited and sent back
+    TArray<TSharedPtr<FJsonValue>> TransformArray;
+    TransformArray.Reserve(FMath::Max(End - Offset, 0) * 9);
+    for (int32 InstanceIndex = Offset; InstanceIndex < End; ++InstanceIndex)
+    {
+        FTransform InstanceTransform;
+        Component->GetInstanceTransform(InstanceIndex, InstanceTransform, bWorldSpace);
+        const FVector Location = InstanceTransform.GetLocation();
+        const FRotator Rotation = InstanceTransform.Rotator();
+        const FVector Scale = InstanceTransform.GetScale3D();
+        for (double Value : { Location.X, Location.Y, Location.Z, Rotation.Pitch, Rotation.Yaw, Rotation.Roll, Scale.X, Scale.Y, Scale.Z })
+        {
+            TransformArray.Add(MakeShared<FJsonValueNumber>(Value));
+        }
+    }
+
+    TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
+    ResultObj->SetStringField(TEXT("static_mesh"), Component->GetStaticMesh() ? Component->GetStaticMesh()->GetPathName() : FString());
+    ResultObj->SetNumberField(TEXT("instance_count"), InstanceCount);
+    ResultObj->SetNumberField(TEXT("offset"), Offset);
+    ResultObj->SetArrayField(TEXT("transforms"), TransformArray);
+    return ResultObj;
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetActorProperties(const TSharedPtr<FJsonObject>& Params)
@@ -310,27 +1656,23 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleGetActorProperties(const
         return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Missing 'name' parameter"));
     }
 
-    // Find the actor
-    AActor* TargetActor = nullptr;
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    for (AActor* Actor : AllActors)
+    // Everything about the actor unless the caller narrows it down
+    EMCPActorFields Fields;
+    FString Error;
+    if (!FUnrealMCPCommonUtils::ParseActorFields(Params, Fields, Error, EMCPActorFields::All))
     {
-        if (Actor && Actor->GetName() == ActorName)
-        {
-            TargetActor = Actor;
-            break;
-        }
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
     }
 
+    // Find the actor
+    AActor* TargetActor = ActorIndex->FindActor(GetTargetWorld(), ActorName);
+
     if (!TargetActor)
     {
         return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Actor not found: %s"), *ActorName));
     }
 
-    // Always return detailed properties for this command
-    return FUnrealMCPCommonUtils::ActorToJsonObject(TargetActor, true);
+    return FUnrealMCPCommonUtils::ActorToJsonObject(TargetActor, Fields);
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorProperty(const TSharedPtr<FJsonObject>& Params)
@@ -343,18 +1685,7 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorProperty(const T
     }
 
     // Find the actor
-    AActor* TargetActor = nullptr;
-    TArray<AActor*> AllActors;
-    UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-    
-    for (AActor* Actor : AllActors)
-    {
-        if (Actor && Actor->GetName() == ActorName)
-        {
-            TargetActor = Actor;
-            break;
-        }
-    }
+    AActor* TargetActor = ActorIndex->FindActor(GetTargetWorld(), ActorName);
 
     if (!TargetActor)
     {
@@ -380,14 +1711,15 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSetActorProperty(const T
     FString ErrorMessage;
     if (FUnrealMCPCommonUtils::SetObjectProperty(TargetActor, PropertyName, PropertyValue, ErrorMessage))
     {
-        // Property set successfully
+        // Property set successfully, it may have moved or resized the actor
+        NoteActorEdited(TargetActor, FName(*PropertyName));
         TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
         ResultObj->SetStringField(TEXT("actor"), ActorName);
         ResultObj->SetStringField(TEXT("property"), PropertyName);
         ResultObj->SetBoolField(TEXT("success"), true);
         
         // Also include the full actor details
-        ResultObj->SetObjectField(TEXT("actor_details"), FUnrealMCPCommonUtils::ActorToJsonObject(TargetActor, true));
+        ResultObj->SetObjectField(TEXT("actor_details"), FUnrealMCPCommonUtils::ActorToJsonObject(TargetActor));
         return ResultObj;
     }
     else
@@ -412,10 +1744,11 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnBlueprintActor(cons
     // }
 
     // Find the blueprint
-    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName);
+    FString FindError;
+    UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName, FindError);
     if (!Blueprint)
     {
-        return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintName));
+        return FUnrealMCPCommonUtils::CreateErrorResponse(FindError);
     }
 
     // Get transform parameters
@@ -437,7 +1770,7 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnBlueprintActor(cons
     }
 
     // Spawn the actor
-    UWorld* World = GEditor->GetEditorWorldContext().World();
+    UWorld* World = GetTargetWorld();
     if (!World)
     {
         return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to get editor world"));
@@ -448,6 +1781,8 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleSpawnBlueprintActor(cons
     SpawnTransform.SetRotation(FQuat(Rotation));
     SpawnTransform.SetScale3D(Scale);
 
+    // Edits still waiting to be compiled would otherwise be missing from the spawned actor
+    FUnrealMCPCompileScheduler::Get().EnsureCompiled(Blueprint);
     AActor* NewActor = World->SpawnActor<AActor>(Blueprint->GeneratedClass, SpawnTransform);
     if (NewActor)
     {
@@ -502,18 +1837,7 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleFocusViewport(const TSha
     if (HasTargetActor)
     {
         // Find the actor
-        AActor* TargetActor = nullptr;
-        TArray<AActor*> AllActors;
-        UGameplayStatics::GetAllActorsOfClass(GWorld, AActor::StaticClass(), AllActors);
-        
-        for (AActor* Actor : AllActors)
-        {
-            if (Actor && Actor->GetName() == TargetActorName)
-            {
-                TargetActor = Actor;
-                break;
-            }
-        }
+        AActor* TargetActor = ActorIndex->FindActor(GetTargetWorld(), TargetActorName);
 
         if (!TargetActor)
         {
@@ -584,4 +1908,6 @@ TSharedPtr<FJsonObject> FUnrealMCPEditorCommands::HandleTakeScreenshot(const TSh
     }
     
     return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Failed to take screenshot"));
-} 
\ No newline at end of file
+}
+
+#undef LOCTEXT_NAMESPACE
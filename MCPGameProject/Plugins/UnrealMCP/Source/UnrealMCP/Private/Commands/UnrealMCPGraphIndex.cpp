@@ -0,0 +1,174 @@
+#include "Commands/UnrealMCPGraphIndex.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+
+FUnrealMCPGraphIndex& FUnrealMCPGraphIndex::Get()
+{
+    static FUnrealMCPGraphIndex Instance;
+    return Instance;
+}
+
+void FUnrealMCPGraphIndex::Reset()
+{
+    for (TPair<TWeakObjectPtr<UEdGraph>, FGraphEntry>& Pair : Graphs)
+    {
+        if (UEdGraph* Graph = Pair.Key.Get())
+        {
+            Graph->RemoveOnGraphChangedHandler(Pair.Value.ChangedHandle);
+        }
+    }
+    Graphs.Reset();
+}
+
+FUnrealMCPGraphIndex::FGraphEntry& FUnrealMCPGraphIndex::FindOrAddEntry(UEdGraph* Graph)
+{
+    if (FGraphEntry* Existing = Graphs.Find(Graph))
+    {
+        return *Existing;
+    }
+
+    // Graphs that are gone can't notify any more, drop them before adding another
+    for (auto It = Graphs.CreateIterator(); It; ++It)
+    {
+        if (!It.Key().IsValid())
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    FGraphEntry& Entry = Graphs.Add(Graph);
+    Entry.ChangedHandle = Graph->AddOnGraphChangedHandler(FOnGraphChanged::FDelegate::CreateRaw(this, &FUnrealMCPGraphIndex::HandleGraphChanged));
+    return Entry;
+}
+
+void FUnrealMCPGraphIndex::Rebuild(UEdGraph* Graph, FGraphEntry& Entry)
+{
+    Entry.Nodes.Reset();
+    Entry.Nodes.Reserve(Graph->Nodes.Num());
+    for (UEdGraphNode* Node : Graph->Nodes)
+    {
+        if (Node)
+        {
+            Entry.Nodes.Add(Node->NodeGuid, Node);
+        }
+    }
+    Entry.Added.Reset();
+    Entry.bStale = false;
+}
+
+UEdGraphNode* FUnrealMCPGraphIndex::FindNode(UEdGraph* Graph, const FGuid& NodeId)
+{
+    check(IsInGameThread());
+    if (!Graph || !NodeId.IsValid())
+    {
+        return nullptr;
+    }
+
+    FGraphEntry& Entry = FindOrAddEntry(Graph);
+    bool bRebuilt = false;
+    if (Entry.bStale)
+    {
+        Rebuild(Graph, Entry);
+        bRebuilt = true;
+    }
+    for (const TWeakObjectPtr<UEdGraphNode>& Added : Entry.Added)
+    {
+        if (UEdGraphNode* Node = Added.Get())
+        {
+            Entry.Nodes.Add(Node->NodeGuid, Node);
+        }
+    }
+    Entry.Added.Reset();
+
+    // A node whose GUID changed without a notification leaves the map behind, so a miss or a mismatch is checked against the graph once
+    const TWeakObjectPtr<UEdGraphNode>* Found = Entry.Nodes.Find(NodeId);
+    UEdGraphNode* Node = Found ? Found->Get() : nullptr;
+    if (Node && Node->NodeGuid == NodeId && Node->GetGraph() == Graph)
+    {
+        return Node;
+    }
+    if (bRebuilt)
+    {
+        return nullptr;
+    }
+
+    Rebuild(Graph, Entry);
+    Found = Entry.Nodes.Find(NodeId);
+    return Found ? Found->Get() : nullptr;
+}
+
+UEdGraphPin* FUnrealMCPGraphIndex::FindPin(UEdGraphNode* Node, const FString& PinName, EEdGraphPinDirection Direction)
+{
+    check(IsInGameThread());
+    UEdGraph* Graph = Node ? Node->GetGraph() : nullptr;
+    FGraphEntry* Entry = Graph ? Graphs.Find(Graph) : nullptr;
+    const FName Name(*PinName, FNAME_Find);
+    if (!Entry || Name.IsNone())
+    {
+        return nullptr;
+    }
+
+    const FPinKey Key{ Node->NodeGuid, Name, Direction };
+    const TPair<int32, FName>* Found = Entry->Pins.Find(Key);
+    if (!Found)
+    {
+        return nullptr;
+    }
+
+    // Reconstructing a node replaces its pins, so only trust the position while it still holds the same pin
+    UEdGraphPin* Pin = Node->Pins.IsValidIndex(Found->Key) ? Node->Pins[Found->Key] : nullptr;
+    if (!Pin || Pin->PinName != Found->Value || (Direction != EGPD_MAX && Pin->Direction != Direction))
+    {
+        Entry->Pins.Remove(Key);
+        return nullptr;
+    }
+    return Pin;
+}
+
+void FUnrealMCPGraphIndex::AddPin(UEdGraphNode* Node, const FString& PinName, EEdGraphPinDirection Direction, const UEdGraphPin* Pin)
+{
+    check(IsInGameThread());
+    UEdGraph* Graph = Node ? Node->GetGraph() : nullptr;
+    const int32 PinIndex = Graph ? Node->Pins.IndexOfByKey(Pin) : INDEX_NONE;
+    if (PinIndex == INDEX_NONE)
+    {
+        return;
+    }
+
+    FGraphEntry& Entry = FindOrAddEntry(Graph);
+    Entry.Pins.Add({ Node->NodeGuid, FName(*PinName), Direction }, TPair<int32, FName>(PinIndex, Pin->PinName));
+}
+
+void FUnrealMCPGraphIndex::HandleGraphChanged(const FEdGraphEditAction& Action)
+{
+    FGraphEntry* Entry = Action.Graph ? Graphs.Find(Action.Graph) : nullptr;
+    if (!Entry)
+    {
+        return;
+    }
+
+    if (Action.Action & GRAPHACTION_AddNode)
+    {
+        for (const UEdGraphNode* Node : Action.Nodes)
+        {
+            Entry->Added.Add(const_cast<UEdGraphNode*>(Node));
+        }
+    }
+    if (Action.Action & GRAPHACTION_RemoveNode)
+    {
+        for (const UEdGraphNode* Node : Action.Nodes)
+        {
+            const TWeakObjectPtr<UEdGraphNode>* Indexed = Node ? Entry->Nodes.Find(Node->NodeGuid) : nullptr;
+            if (Indexed && Indexed->Get() == Node)
+            {
+                Entry->Nodes.Remove(Node->NodeGuid);
+            }
+        }
+    }
+    if (Action.Action == GRAPHACTION_Default)
+    {
+        Entry->bStale = true;
+        Entry->Pins.Reset();
+    }
+}
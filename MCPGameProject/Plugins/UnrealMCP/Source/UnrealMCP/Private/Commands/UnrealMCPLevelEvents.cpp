@@ -0,0 +1,99 @@
+#include "Commands/UnrealMCPLevelEvents.h"
+#include "Editor.h"
+#include "Engine/Engine.h"
+#include "GameFramework/Actor.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/UObjectGlobals.h"
+
+FUnrealMCPLevelEvents& FUnrealMCPLevelEvents::Get()
+{
+    static FUnrealMCPLevelEvents Instance;
+    return Instance;
+}
+
+bool FUnrealMCPLevelEvents::AddListener(IMCPLevelListener* Listener)
+{
+    check(IsInGameThread());
+    BindDelegates();
+    if (!bDelegatesBound || !Listener)
+    {
+        return false;
+    }
+
+    Listeners.AddUnique(Listener);
+    return true;
+}
+
+void FUnrealMCPLevelEvents::RemoveListener(IMCPLevelListener* Listener)
+{
+    Listeners.Remove(Listener);
+    if (Listeners.IsEmpty())
+    {
+        UnbindDelegates();
+    }
+}
+
+void FUnrealMCPLevelEvents::BindDelegates()
+{
+    if (bDelegatesBound || !GEngine)
+    {
+        return;
+    }
+
+    ActorAddedHandle = GEngine->OnLevelActorAdded().AddLambda([this](AActor* Actor)
+    {
+        Broadcast([Actor](IMCPLevelListener& Listener) { Listener.OnActorAdded(Actor); });
+    });
+    ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddLambda([this](AActor* Actor)
+    {
+        Broadcast([Actor](IMCPLevelListener& Listener) { Listener.OnActorDeleted(Actor); });
+    });
+    ActorMovedHandle = GEngine->OnActorMoved().AddLambda([this](AActor* Actor)
+    {
+        Broadcast([Actor](IMCPLevelListener& Listener) { Listener.OnActorMoved(Actor); });
+    });
+    ActorLabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddLambda([this](AActor* Actor)
+    {
+        Broadcast([Actor](IMCPLevelListener& Listener) { Listener.OnActorLabelChanged(Actor); });
+    });
+    ObjectRenamedHandle = FCoreUObjectDelegates::OnObjectRenamed.AddLambda([this](UObject* Object, UObject* OldOuter, FName OldName)
+    {
+        Broadcast([&](IMCPLevelListener& Listener) { Listener.OnObjectRenamed(Object, OldOuter, OldName); });
+    });
+    PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddLambda([this](UObject* Object, FPropertyChangedEvent& Event)
+    {
+        Broadcast([&](IMCPLevelListener& Listener) { Listener.OnObjectPropertyChanged(Object, Event); });
+    });
+
+    // Each of these can change any actor without a per-actor notification
+    auto Reset = [this]()
+    {
+        Broadcast([](IMCPLevelListener& Listener) { Listener.OnLevelReset(); });
+    };
+    ActorListChangedHandle = GEngine->OnLevelActorListChanged().AddLambda(Reset);
+    MapChangeHandle = FEditorDelegates::MapChange.AddLambda([Reset](uint32) { Reset(); });
+    UndoRedoHandle = FEditorDelegates::PostUndoRedo.AddLambda(Reset);
+    bDelegatesBound = true;
+}
+
+void FUnrealMCPLevelEvents::UnbindDelegates()
+{
+    if (!bDelegatesBound)
+    {
+        return;
+    }
+
+    if (GEngine)
+    {
+        GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+        GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+        GEngine->OnActorMoved().Remove(ActorMovedHandle);
+        GEngine->OnLevelActorListChanged().Remove(ActorListChangedHandle);
+    }
+    FCoreDelegates::OnActorLabelChanged.Remove(ActorLabelChangedHandle);
+    FCoreUObjectDelegates::OnObjectRenamed.Remove(ObjectRenamedHandle);
+    FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(PropertyChangedHandle);
+    FEditorDelegates::MapChange.Remove(MapChangeHandle);
+    FEditorDelegates::PostUndoRedo.Remove(UndoRedoHandle);
+    bDelegatesBound = false;
+}
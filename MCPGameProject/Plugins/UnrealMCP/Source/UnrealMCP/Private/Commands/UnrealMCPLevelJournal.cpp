@@ -0,0 +1,151 @@
+#include "Commands/UnrealMCPLevelJournal.h"
+#include "Commands/UnrealMCPLevelEvents.h"
+#include "Algo/BinarySearch.h"
+#include "Components/ActorComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/Guid.h"
+#include "UObject/UnrealType.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace UnrealMCPLevelJournal
+{
+    /** Entries kept before the oldest are dropped, clients further behind than this reload the level */
+    static const int32 MaxEntries = 100000;
+}
+
+FUnrealMCPLevelJournal::FUnrealMCPLevelJournal()
+    : JournalId(FGuid::NewGuid().ToString(EGuidFormats::Digits).ToLower())
+    , Version(0)
+    , ForgottenVersion(0)
+    , bListening(false)
+{
+}
+
+FUnrealMCPLevelJournal::~FUnrealMCPLevelJournal()
+{
+    if (bListening)
+    {
+        FUnrealMCPLevelEvents::Get().RemoveListener(this);
+    }
+}
+
+void FUnrealMCPLevelJournal::StartListening()
+{
+    if (!bListening)
+    {
+        bListening = FUnrealMCPLevelEvents::Get().AddListener(this);
+    }
+}
+
+void FUnrealMCPLevelJournal::Prepare(UWorld* World)
+{
+    check(IsInGameThread());
+    StartListening();
+    if (JournalWorld.Get() != World)
+    {
+        // Nothing recorded so far is about this world
+        Reset();
+        JournalWorld = World;
+    }
+}
+
+bool FUnrealMCPLevelJournal::GetChangesSince(uint64 SinceVersion, TArray<FMCPLevelChange>& OutChanges) const
+{
+    if (SinceVersion < ForgottenVersion || SinceVersion > Version)
+    {
+        return false;
+    }
+
+    const int32 First = Algo::UpperBoundBy(Entries, SinceVersion, &FMCPLevelChange::Version);
+    OutChanges.Append(Entries.GetData() + First, Entries.Num() - First);
+    return true;
+}
+
+void FUnrealMCPLevelJournal::RecordTransformed(AActor* Actor)
+{
+    Record(Actor, EMCPLevelChange::Transformed);
+}
+
+void FUnrealMCPLevelJournal::RecordPropertyChanged(AActor* Actor, FName PropertyName)
+{
+    Record(Actor, EMCPLevelChange::PropertyChanged, PropertyName);
+}
+
+void FUnrealMCPLevelJournal::Record(AActor* Actor, EMCPLevelChange Kind, FName Detail)
+{
+    // Actors in blueprint editor previews and other worlds aren't part of the level
+    if (!bListening || !Actor || !JournalWorld.IsValid() || Actor->GetWorld() != JournalWorld.Get())
+    {
+        return;
+    }
+
+    if (Entries.Num() >= UnrealMCPLevelJournal::MaxEntries)
+    {
+        // Drop a quarter at a time so trimming stays cheap per entry
+        const int32 DropCount = UnrealMCPLevelJournal::MaxEntries / 4;
+        ForgottenVersion = Entries[DropCount - 1].Version;
+        Entries.RemoveAt(0, DropCount, EAllowShrinking::No);
+    }
+
+    FMCPLevelChange& Change = Entries.AddDefaulted_GetRef();
+    Change.Version = ++Version;
+    Change.Kind = Kind;
+    Change.ActorKey = FObjectKey(Actor);
+    Change.Actor = Actor;
+    Change.ActorName = Actor->GetFName();
+    Change.Detail = Detail;
+}
+
+void FUnrealMCPLevelJournal::Reset()
+{
+    Entries.Reset();
+    ForgottenVersion = ++Version;
+}
+
+void FUnrealMCPLevelJournal::OnLevelReset()
+{
+    Reset();
+}
+
+void FUnrealMCPLevelJournal::OnActorAdded(AActor* Actor)
+{
+    Record(Actor, EMCPLevelChange::Added);
+}
+
+void FUnrealMCPLevelJournal::OnActorDeleted(AActor* Actor)
+{
+    Record(Actor, EMCPLevelChange::Removed);
+}
+
+void FUnrealMCPLevelJournal::OnActorMoved(AActor* Actor)
+{
+    Record(Actor, EMCPLevelChange::Transformed);
+}
+
+void FUnrealMCPLevelJournal::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+    // Dragging a slider sends a stream of interactive changes followed by a final one, only keep the last
+    if (Event.ChangeType == EPropertyChangeType::Interactive)
+    {
+        return;
+    }
+
+    const FName PropertyName = Event.GetMemberPropertyName();
+    if (AActor* Actor = Cast<AActor>(Object))
+    {
+        Record(Actor, EMCPLevelChange::PropertyChanged, PropertyName);
+    }
+    else if (UActorComponent* Component = Cast<UActorComponent>(Object))
+    {
+        Record(Component->GetOwner(), EMCPLevelChange::PropertyChanged, PropertyName);
+    }
+}
+
+void FUnrealMCPLevelJournal::OnObjectRenamed(UObject* Object, UObject* OldOuter, FName OldName)
+{
+    if (AActor* Actor = Cast<AActor>(Object))
+    {
+        Record(Actor, EMCPLevelChange::Renamed, OldName);
+    }
+}
@@ -1,4 +1,5 @@
 #include "Commands/UnrealMCPProjectCommands.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
 #include "Commands/UnrealMCPCommonUtils.h"
 #include "GameFramework/InputSettings.h"
 
@@ -6,14 +7,11 @@ FUnrealMCPProjectCommands::FUnrealMCPProjectCommands()
 {
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPProjectCommands::HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+void FUnrealMCPProjectCommands::RegisterCommands(FUnrealMCPCommandRegistry& Registry)
 {
-    if (CommandType == TEXT("create_input_mapping"))
-    {
-        return HandleCreateInputMapping(Params);
-    }
-    
-    return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown project command: %s"), *CommandType));
+    const FString Category = TEXT("project");
+
+    Registry.Register(TEXT("create_input_mapping"), Category, TEXT("Create an input action or axis mapping"), this, &FUnrealMCPProjectCommands::HandleCreateInputMapping);
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPProjectCommands::HandleCreateInputMapping(const TSharedPtr<FJsonObject>& Params)
@@ -0,0 +1,419 @@
+#include "Commands/UnrealMCPSpatialIndex.h"
+#include "Commands/UnrealMCPLevelEvents.h"
+#include "Components/ActorComponent.h"
+#include "Engine/World.h"
+#include "EngineDefines.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "Math/GenericOctree.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace UnrealMCPSpatial
+{
+    /** Search radius the nearest query starts at, in world units */
+    static const double InitialNearestRadius = 1000.0;
+
+    /** Beyond this the nearest query stops widening, well past the largest supported world */
+    static const double MaxSearchRadius = 1.0e8;
+
+    /** Ray queries walk the ray in segments no shorter than this, so a long diagonal ray doesn't query one huge box */
+    static const double MinRaySegmentLength = 10000.0;
+    static const int32 MaxRaySegments = 64;
+
+    struct FOctreeElement
+    {
+        FObjectKey Key;
+        TWeakObjectPtr<AActor> Actor;
+        FBox Bounds;
+
+        /** Id table of the owning octree, updated whenever the octree moves the element */
+        TMap<FObjectKey, FOctreeElementId2>* ElementIds;
+    };
+
+    struct FOctreeSemantics
+    {
+        enum { MaxElementsPerLeaf = 16 };
+        enum { MinInclusiveElementsPerNode = 7 };
+        enum { MaxNodeDepth = 12 };
+
+        typedef TInlineAllocator<MaxElementsPerLeaf> ElementAllocator;
+
+        static FBoxCenterAndExtent GetBoundingBox(const FOctreeElement& Element)
+        {
+            return FBoxCenterAndExtent(Element.Bounds);
+        }
+
+        static bool AreElementsEqual(const FOctreeElement& A, const FOctreeElement& B)
+        {
+            return A.Key == B.Key;
+        }
+
+        static void SetElementId(const FOctreeElement& Element, FOctreeElementId2 Id)
+        {
+            Element.ElementIds->Add(Element.Key, Id);
+        }
+    };
+
+    /** The space an actor takes up, a point at its location when it has no bounded components */
+    static FBox GetActorSpatialBounds(const AActor* Actor)
+    {
+        FBox Bounds = Actor->GetComponentsBoundingBox(true);
+        if (!Bounds.IsValid)
+        {
+            const FVector Location = Actor->GetActorLocation();
+            Bounds = FBox(Location, Location);
+        }
+        return Bounds;
+    }
+
+    /** Distance along a normalized ray at which it enters Box, false if it misses within MaxDistance */
+    static bool IntersectRayBox(const FVector& Origin, const FVector& Direction, const FBox& Box, double MaxDistance, double& OutDistance)
+    {
+        double Enter = 0.0;
+        double Exit = MaxDistance;
+        for (int32 Axis = 0; Axis < 3; ++Axis)
+        {
+            if (FMath::IsNearlyZero(Direction[Axis]))
+            {
+                if (Origin[Axis] < Box.Min[Axis] || Origin[Axis] > Box.Max[Axis])
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            const double InvDirection = 1.0 / Direction[Axis];
+            double Near = (Box.Min[Axis] - Origin[Axis]) * InvDirection;
+            double Far = (Box.Max[Axis] - Origin[Axis]) * InvDirection;
+            if (Near > Far)
+            {
+                Swap(Near, Far);
+            }
+            Enter = FMath::Max(Enter, Near);
+            Exit = FMath::Min(Exit, Far);
+            if (Enter > Exit)
+            {
+                return false;
+            }
+        }
+        OutDistance = Enter;
+        return true;
+    }
+
+    static void SortByDistance(TArray<FUnrealMCPSpatialHit>& Hits)
+    {
+        Hits.Sort([](const FUnrealMCPSpatialHit& A, const FUnrealMCPSpatialHit& B) { return A.Distance < B.Distance; });
+    }
+}
+
+/** Loose octree over the editor world, along with the id of every element so actors can be removed */
+struct FUnrealMCPSpatialOctree : public TOctree2<UnrealMCPSpatial::FOctreeElement, UnrealMCPSpatial::FOctreeSemantics>
+{
+    FUnrealMCPSpatialOctree()
+        : TOctree2(FVector::ZeroVector, HALF_WORLD_MAX)
+    {
+    }
+
+    TMap<FObjectKey, FOctreeElementId2> ElementIds;
+};
+
+FUnrealMCPSpatialIndex::FUnrealMCPSpatialIndex()
+    : bStale(true)
+    , bListening(false)
+{
+}
+
+FUnrealMCPSpatialIndex::~FUnrealMCPSpatialIndex()
+{
+    if (bListening)
+    {
+        FUnrealMCPLevelEvents::Get().RemoveListener(this);
+    }
+}
+
+void FUnrealMCPSpatialIndex::StartListening()
+{
+    if (!bListening)
+    {
+        bListening = FUnrealMCPLevelEvents::Get().AddListener(this);
+    }
+}
+
+int32 FUnrealMCPSpatialIndex::Num() const
+{
+    return Octree.IsValid() ? Octree->ElementIds.Num() : 0;
+}
+
+void FUnrealMCPSpatialIndex::Prepare(UWorld* World)
+{
+    check(IsInGameThread());
+    StartListening();
+    if (bStale || !Octree.IsValid() || IndexedWorld.Get() != World)
+    {
+        Rebuild(World);
+    }
+}
+
+void FUnrealMCPSpatialIndex::Rebuild(UWorld* World)
+{
+    Octree = MakeUnique<FUnrealMCPSpatialOctree>();
+    IndexedWorld = World;
+    bStale = false;
+    if (World)
+    {
+        for (TActorIterator<AActor> It(World); It; ++It)
+        {
+            AddActor(*It);
+        }
+    }
+    UE_LOG(LogTemp, Verbose, TEXT("UnrealMCPSpatialIndex: Indexed %d actors"), Num());
+}
+
+void FUnrealMCPSpatialIndex::AddActor(AActor* Actor)
+{
+    if (!IsValid(Actor) || !Actor->GetRootComponent())
+    {
+        return;
+    }
+
+    UnrealMCPSpatial::FOctreeElement Element;
+    Element.Key = FObjectKey(Actor);
+    Element.Actor = Actor;
+    Element.Bounds = UnrealMCPSpatial::GetActorSpatialBounds(Actor);
+    Element.ElementIds = &Octree->ElementIds;
+    Octree->AddElement(Element);
+}
+
+void FUnrealMCPSpatialIndex::RemoveActor(const AActor* Actor)
+{
+    const FObjectKey Key(Actor);
+    FOctreeElementId2 ElementId;
+    if (Octree->ElementIds.RemoveAndCopyValue(Key, ElementId) && ElementId.IsValidId())
+    {
+        // Removing may move another element, which records its new id through SetElementId
+        Octree->RemoveElement(ElementId);
+    }
+}
+
+void FUnrealMCPSpatialIndex::UpdateActor(AActor* Actor)
+{
+    if (bStale || !Octree.IsValid() || !Actor || Actor->GetWorld() != IndexedWorld.Get())
+    {
+        return;
+    }
+
+    if (const FOctreeElementId2* ElementId = Octree->ElementIds.Find(FObjectKey(Actor)))
+    {
+        if (IsValid(Actor) && Octree->GetElementById(*ElementId).Bounds.Equals(UnrealMCPSpatial::GetActorSpatialBounds(Actor)))
+        {
+            return;
+        }
+        RemoveActor(Actor);
+    }
+    AddActor(Actor);
+}
+
+void FUnrealMCPSpatialIndex::Gather(const FBox& QueryBox, FUnrealMCPSpatialFilter Filter, TArray<FUnrealMCPSpatialHit>& OutCandidates)
+{
+    TArray<AActor*> Moved;
+    bool bFoundStale = false;
+
+    Octree->FindElementsWithBoundsTest(FBoxCenterAndExtent(QueryBox), [&](const UnrealMCPSpatial::FOctreeElement& Element)
+    {
+        AActor* Actor = Element.Actor.Get();
+        if (!IsValid(Actor) || Actor->GetWorld() != IndexedWorld.Get())
+        {
+            bFoundStale = true;
+            return;
+        }
+        if (!Filter(Actor))
+        {
+            return;
+        }
+
+        FUnrealMCPSpatialHit& Candidate = OutCandidates.AddDefaulted_GetRef();
+        Candidate.Actor = Actor;
+        Candidate.Bounds = UnrealMCPSpatial::GetActorSpatialBounds(Actor);
+        if (!Candidate.Bounds.Equals(Element.Bounds))
+        {
+            Moved.Add(Actor);
+        }
+    });
+
+    // The octree can't be modified while it is being walked
+    for (AActor* Actor : Moved)
+    {
+        UpdateActor(Actor);
+    }
+
+    if (bFoundStale)
+    {
+        // An actor went away without a notification, don't trust the rest of the index either
+        MarkStale();
+    }
+}
+
+void FUnrealMCPSpatialIndex::FindInRadius(UWorld* World, const FVector& Center, double Radius, FUnrealMCPSpatialFilter Filter, TArray<FUnrealMCPSpatialHit>& OutHits)
+{
+    Prepare(World);
+
+    TArray<FUnrealMCPSpatialHit> Candidates;
+    Gather(FBox(Center - FVector(Radius), Center + FVector(Radius)), Filter, Candidates);
+
+    const double RadiusSquared = Radius * Radius;
+    for (FUnrealMCPSpatialHit& Candidate : Candidates)
+    {
+        const double DistanceSquared = Candidate.Bounds.ComputeSquaredDistanceToPoint(Center);
+        if (DistanceSquared <= RadiusSquared)
+        {
+            Candidate.Distance = FMath::Sqrt(DistanceSquared);
+            OutHits.Add(Candidate);
+        }
+    }
+    UnrealMCPSpatial::SortByDistance(OutHits);
+}
+
+void FUnrealMCPSpatialIndex::FindInBox(UWorld* World, const FBox& Box, bool bContained, FUnrealMCPSpatialFilter Filter, TArray<FUnrealMCPSpatialHit>& OutHits)
+{
+    Prepare(World);
+
+    TArray<FUnrealMCPSpatialHit> Candidates;
+    Gather(Box, Filter, Candidates);
+
+    const FVector Center = Box.GetCenter();
+    for (FUnrealMCPSpatialHit& Candidate : Candidates)
+    {
+        const bool bMatches = bContained
+            ? Box.IsInsideOrOn(Candidate.Bounds.Min) && Box.IsInsideOrOn(Candidate.Bounds.Max)
+            : Box.Intersect(Candidate.Bounds);
+        if (bMatches)
+        {
+            Candidate.Distance = FMath::Sqrt(Candidate.Bounds.ComputeSquaredDistanceToPoint(Center));
+            OutHits.Add(Candidate);
+        }
+    }
+}
+
+void FUnrealMCPSpatialIndex::FindNearest(UWorld* World, const FVector& Location, int32 Count, double MaxDistance, FUnrealMCPSpatialFilter Filter, TArray<FUnrealMCPSpatialHit>& OutHits)
+{
+    Prepare(World);
+    if (Count <= 0)
+    {
+        return;
+    }
+
+    // Widen a search radius until it holds enough actors. Anything nearer than the radius
+    // overlaps the search box, so once Count actors lie within it those are the nearest.
+    const double SearchLimit = MaxDistance > 0.0 ? MaxDistance : UnrealMCPSpatial::MaxSearchRadius;
+    double Radius = FMath::Min(UnrealMCPSpatial::InitialNearestRadius, SearchLimit);
+    for (;;)
+    {
+        OutHits.Reset();
+        FindInRadius(World, Location, Radius, Filter, OutHits);
+        if (OutHits.Num() >= Count || Radius >= SearchLimit)
+        {
+            break;
+        }
+        Radius = FMath::Min(Radius * 4.0, SearchLimit);
+    }
+
+    if (OutHits.Num() > Count)
+    {
+        OutHits.SetNum(Count);
+    }
+}
+
+void FUnrealMCPSpatialIndex::FindOnRay(UWorld* World, const FVector& Origin, const FVector& Direction, double MaxDistance, int32 MaxHits, FUnrealMCPSpatialFilter Filter, TArray<FUnrealMCPSpatialHit>& OutHits)
+{
+    Prepare(World);
+    const FVector RayDirection = Direction.GetSafeNormal();
+    if (MaxHits <= 0 || MaxDistance <= 0.0 || RayDirection.IsZero())
+    {
+        return;
+    }
+
+    // Walk the ray a segment at a time. An actor the ray enters before the end of a segment
+    // overlaps that segment's box, so once MaxHits hits lie before it the rest can only be further away.
+    const double SegmentLength = FMath::Max(UnrealMCPSpatial::MinRaySegmentLength, MaxDistance / UnrealMCPSpatial::MaxRaySegments);
+    TSet<const AActor*> Tested;
+    for (double SegmentStart = 0.0; SegmentStart < MaxDistance; SegmentStart += SegmentLength)
+    {
+        const double SegmentEnd = FMath::Min(SegmentStart + SegmentLength, MaxDistance);
+        const FVector Start = Origin + RayDirection * SegmentStart;
+        const FVector End = Origin + RayDirection * SegmentEnd;
+
+        TArray<FUnrealMCPSpatialHit> Candidates;
+        Gather(FBox(Start.ComponentMin(End), Start.ComponentMax(End)), Filter, Candidates);
+
+        for (FUnrealMCPSpatialHit& Candidate : Candidates)
+        {
+            bool bAlreadyTested = false;
+            Tested.Add(Candidate.Actor, &bAlreadyTested);
+            if (!bAlreadyTested && UnrealMCPSpatial::IntersectRayBox(Origin, RayDirection, Candidate.Bounds, MaxDistance, Candidate.Distance))
+            {
+                OutHits.Add(Candidate);
+            }
+        }
+
+        int32 HitsBeforeEnd = 0;
+        for (const FUnrealMCPSpatialHit& Hit : OutHits)
+        {
+            HitsBeforeEnd += Hit.Distance <= SegmentEnd ? 1 : 0;
+        }
+        if (HitsBeforeEnd >= MaxHits)
+        {
+            break;
+        }
+    }
+
+    UnrealMCPSpatial::SortByDistance(OutHits);
+    if (OutHits.Num() > MaxHits)
+    {
+        OutHits.SetNum(MaxHits);
+    }
+}
+
+void FUnrealMCPSpatialIndex::OnActorAdded(AActor* Actor)
+{
+    if (!bStale && Octree.IsValid() && Actor && Actor->GetWorld() == IndexedWorld.Get())
+    {
+        UpdateActor(Actor);
+    }
+}
+
+void FUnrealMCPSpatialIndex::OnActorDeleted(AActor* Actor)
+{
+    if (!bStale && Octree.IsValid() && Actor)
+    {
+        RemoveActor(Actor);
+    }
+}
+
+void FUnrealMCPSpatialIndex::OnActorMoved(AActor* Actor)
+{
+    UpdateActor(Actor);
+}
+
+void FUnrealMCPSpatialIndex::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+    // Edits in the details panel can resize an actor without moving it, e.g. a new mesh
+    if (AActor* Actor = Cast<AActor>(Object))
+    {
+        UpdateActor(Actor);
+    }
+    else if (UActorComponent* Component = Cast<UActorComponent>(Object))
+    {
+        UpdateActor(Component->GetOwner());
+    }
+}
+
+void FUnrealMCPSpatialIndex::OnLevelReset()
+{
+    MarkStale();
+}
+
+void FUnrealMCPSpatialIndex::MarkStale()
+{
+    bStale = true;
+}
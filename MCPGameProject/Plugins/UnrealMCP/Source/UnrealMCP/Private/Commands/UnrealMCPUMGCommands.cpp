@@ -1,5 +1,9 @@
 #include "Commands/UnrealMCPUMGCommands.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "Commands/UnrealMCPBlueprintCache.h"
+#include "Commands/UnrealMCPBlueprintIndex.h"
+#include "Commands/UnrealMCPCompileScheduler.h"
 #include "Editor.h"
 #include "EditorAssetLibrary.h"
 #include "AssetRegistry/AssetRegistryModule.h"
@@ -26,38 +30,50 @@
 #include "Kismet2/KismetEditorUtilities.h"
 #include "K2Node_Event.h"
 
-FUnrealMCPUMGCommands::FUnrealMCPUMGCommands()
+namespace UnrealMCPUMG
 {
+	/** Find a Widget Blueprint by handle, name or path, short names not found elsewhere are looked for in /Game/Widgets/ */
+	static UWidgetBlueprint* FindWidgetBlueprint(const FString& BlueprintName, FString& OutError)
+	{
+		// Handles and names resolved before come from the shared cache, like any other Blueprint
+		UBlueprint* Blueprint = FUnrealMCPCommonUtils::FindBlueprint(BlueprintName, OutError);
+		if (UWidgetBlueprint* WidgetBlueprint = Cast<UWidgetBlueprint>(Blueprint))
+		{
+			return WidgetBlueprint;
+		}
+		if (FUnrealMCPBlueprintCache::IsHandle(BlueprintName))
+		{
+			if (Blueprint)
+			{
+				OutError = FString::Printf(TEXT("'%s' is not a Widget Blueprint"), *BlueprintName);
+			}
+			return nullptr;
+		}
+
+		// The name may belong to some other Blueprint, or only be found in the widgets folder
+		UWidgetBlueprint* WidgetBlueprint = Cast<UWidgetBlueprint>(FUnrealMCPBlueprintIndex::Get().Resolve(BlueprintName, TEXT("/Game/Widgets/"), UWidgetBlueprint::StaticClass(), OutError));
+		if (WidgetBlueprint && !Blueprint)
+		{
+			FUnrealMCPBlueprintCache::Get().AddName(BlueprintName, WidgetBlueprint);
+		}
+		return WidgetBlueprint;
+	}
 }
 
-TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleCommand(const FString& CommandName, const TSharedPtr<FJsonObject>& Params)
+FUnrealMCPUMGCommands::FUnrealMCPUMGCommands()
 {
-	if (CommandName == TEXT("create_umg_widget_blueprint"))
-	{
-		return HandleCreateUMGWidgetBlueprint(Params);
-	}
-	else if (CommandName == TEXT("add_text_block_to_widget"))
-	{
-		return HandleAddTextBlockToWidget(Params);
-	}
-	else if (CommandName == TEXT("add_widget_to_viewport"))
-	{
-		return HandleAddWidgetToViewport(Params);
-	}
-	else if (CommandName == TEXT("add_button_to_widget"))
-	{
-		return HandleAddButtonToWidget(Params);
-	}
-	else if (CommandName == TEXT("bind_widget_event"))
-	{
-		return HandleBindWidgetEvent(Params);
-	}
-	else if (CommandName == TEXT("set_text_block_binding"))
-	{
-		return HandleSetTextBlockBinding(Params);
-	}
+}
 
-	return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Unknown UMG command: %s"), *CommandName));
+void FUnrealMCPUMGCommands::RegisterCommands(FUnrealMCPCommandRegistry& Registry)
+{
+	const FString Category = TEXT("umg");
+
+	Registry.Register(TEXT("create_umg_widget_blueprint"), Category, TEXT("Create a UMG Widget Blueprint"), this, &FUnrealMCPUMGCommands::HandleCreateUMGWidgetBlueprint);
+	Registry.Register(TEXT("add_text_block_to_widget"), Category, TEXT("Add a Text Block to a Widget Blueprint"), this, &FUnrealMCPUMGCommands::HandleAddTextBlockToWidget);
+	Registry.Register(TEXT("add_widget_to_viewport"), Category, TEXT("Add a widget instance to the game viewport"), this, &FUnrealMCPUMGCommands::HandleAddWidgetToViewport);
+	Registry.Register(TEXT("add_button_to_widget"), Category, TEXT("Add a Button to a Widget Blueprint"), this, &FUnrealMCPUMGCommands::HandleAddButtonToWidget);
+	Registry.Register(TEXT("bind_widget_event"), Category, TEXT("Bind a widget event such as OnClicked to a function"), this, &FUnrealMCPUMGCommands::HandleBindWidgetEvent);
+	Registry.Register(TEXT("set_text_block_binding"), Category, TEXT("Bind a Text Block property to a function"), this, &FUnrealMCPUMGCommands::HandleSetTextBlockBinding);
 }
 
 TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleCreateUMGWidgetBlueprint(const TSharedPtr<FJsonObject>& Params)
@@ -117,12 +133,13 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleCreateUMGWidgetBlueprint(co
 	FAssetRegistryModule::AssetCreated(WidgetBlueprint);
 
 	// Compile the blueprint
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
+	FUnrealMCPCompileScheduler::Get().RequestCompile(WidgetBlueprint);
 
 	// Create success response
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
 	ResultObj->SetStringField(TEXT("name"), BlueprintName);
 	ResultObj->SetStringField(TEXT("path"), FullPath);
+	ResultObj->SetStringField(TEXT("handle"), FUnrealMCPBlueprintCache::Get().GetHandle(WidgetBlueprint));
 	return ResultObj;
 }
 
@@ -142,11 +159,11 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleAddTextBlockToWidget(const
 	}
 
 	// Find the Widget Blueprint
-	FString FullPath = TEXT("/Game/Widgets/") + BlueprintName;
-	UWidgetBlueprint* WidgetBlueprint = Cast<UWidgetBlueprint>(UEditorAssetLibrary::LoadAsset(FullPath));
+	FString FindError;
+	UWidgetBlueprint* WidgetBlueprint = UnrealMCPUMG::FindWidgetBlueprint(BlueprintName, FindError);
 	if (!WidgetBlueprint)
 	{
-		return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Widget Blueprint '%s' not found"), *BlueprintName));
+		return FUnrealMCPCommonUtils::CreateErrorResponse(FindError);
 	}
 
 	// Get optional parameters
@@ -186,7 +203,7 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleAddTextBlockToWidget(const
 
 	// Mark the package dirty and compile
 	WidgetBlueprint->MarkPackageDirty();
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
+	FUnrealMCPCompileScheduler::Get().RequestCompile(WidgetBlueprint);
 
 	// Create success response
 	TSharedPtr<FJsonObject> ResultObj = MakeShared<FJsonObject>();
@@ -205,11 +222,11 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleAddWidgetToViewport(const T
 	}
 
 	// Find the Widget Blueprint
-	FString FullPath = TEXT("/Game/Widgets/") + BlueprintName;
-	UWidgetBlueprint* WidgetBlueprint = Cast<UWidgetBlueprint>(UEditorAssetLibrary::LoadAsset(FullPath));
+	FString FindError;
+	UWidgetBlueprint* WidgetBlueprint = UnrealMCPUMG::FindWidgetBlueprint(BlueprintName, FindError);
 	if (!WidgetBlueprint)
 	{
-		return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("Widget Blueprint '%s' not found"), *BlueprintName));
+		return FUnrealMCPCommonUtils::CreateErrorResponse(FindError);
 	}
 
 	// Get optional Z-order parameter
@@ -217,6 +234,7 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleAddWidgetToViewport(const T
 	Params->TryGetNumberField(TEXT("z_order"), ZOrder);
 
 	// Create widget instance
+	FUnrealMCPCompileScheduler::Get().EnsureCompiled(WidgetBlueprint);
 	UClass* WidgetClass = WidgetBlueprint->GeneratedClass;
 	if (!WidgetClass)
 	{
@@ -263,15 +281,16 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleAddButtonToWidget(const TSh
 	}
 
 	// Load the Widget Blueprint
-	const FString BlueprintPath = FString::Printf(TEXT("/Game/Widgets/%s.%s"), *BlueprintName, *BlueprintName);
-	UWidgetBlueprint* WidgetBlueprint = Cast<UWidgetBlueprint>(UEditorAssetLibrary::LoadAsset(BlueprintPath));
+	FString FindError;
+	UWidgetBlueprint* WidgetBlueprint = UnrealMCPUMG::FindWidgetBlueprint(BlueprintName, FindError);
 	if (!WidgetBlueprint)
 	{
-		Response->SetStringField(TEXT("error"), FString::Printf(TEXT("Failed to load Widget Blueprint: %s"), *BlueprintPath));
+		Response->SetStringField(TEXT("error"), FindError);
 		return Response;
 	}
 
 	// Create Button widget
+	FUnrealMCPCompileScheduler::Get().EnsureCompiled(WidgetBlueprint);
 	UButton* Button = NewObject<UButton>(WidgetBlueprint->GeneratedClass->GetDefaultObject(), UButton::StaticClass(), *WidgetName);
 	if (!Button)
 	{
@@ -310,9 +329,9 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleAddButtonToWidget(const TSh
 		}
 	}
 
-	// Save the Widget Blueprint
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-	UEditorAssetLibrary::SaveAsset(BlueprintPath, false);
+	// Compile before saving so the saved asset matches its edits
+	FUnrealMCPCompileScheduler::Get().CompileNow(WidgetBlueprint);
+	UEditorAssetLibrary::SaveAsset(WidgetBlueprint->GetPathName(), false);
 
 	Response->SetBoolField(TEXT("success"), true);
 	Response->SetStringField(TEXT("widget_name"), WidgetName);
@@ -346,11 +365,11 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleBindWidgetEvent(const TShar
 	}
 
 	// Load the Widget Blueprint
-	const FString BlueprintPath = FString::Printf(TEXT("/Game/Widgets/%s.%s"), *BlueprintName, *BlueprintName);
-	UWidgetBlueprint* WidgetBlueprint = Cast<UWidgetBlueprint>(UEditorAssetLibrary::LoadAsset(BlueprintPath));
+	FString FindError;
+	UWidgetBlueprint* WidgetBlueprint = UnrealMCPUMG::FindWidgetBlueprint(BlueprintName, FindError);
 	if (!WidgetBlueprint)
 	{
-		Response->SetStringField(TEXT("error"), FString::Printf(TEXT("Failed to load Widget Blueprint: %s"), *BlueprintPath));
+		Response->SetStringField(TEXT("error"), FindError);
 		return Response;
 	}
 
@@ -432,9 +451,9 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleBindWidgetEvent(const TShar
 		return Response;
 	}
 
-	// Save the Widget Blueprint
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-	UEditorAssetLibrary::SaveAsset(BlueprintPath, false);
+	// Compile before saving so the saved asset matches its edits
+	FUnrealMCPCompileScheduler::Get().CompileNow(WidgetBlueprint);
+	UEditorAssetLibrary::SaveAsset(WidgetBlueprint->GetPathName(), false);
 
 	Response->SetBoolField(TEXT("success"), true);
 	Response->SetStringField(TEXT("event_name"), EventName);
@@ -468,11 +487,11 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleSetTextBlockBinding(const T
 	}
 
 	// Load the Widget Blueprint
-	const FString BlueprintPath = FString::Printf(TEXT("/Game/Widgets/%s.%s"), *BlueprintName, *BlueprintName);
-	UWidgetBlueprint* WidgetBlueprint = Cast<UWidgetBlueprint>(UEditorAssetLibrary::LoadAsset(BlueprintPath));
+	FString FindError;
+	UWidgetBlueprint* WidgetBlueprint = UnrealMCPUMG::FindWidgetBlueprint(BlueprintName, FindError);
 	if (!WidgetBlueprint)
 	{
-		Response->SetStringField(TEXT("error"), FString::Printf(TEXT("Failed to load Widget Blueprint: %s"), *BlueprintPath));
+		Response->SetStringField(TEXT("error"), FindError);
 		return Response;
 	}
 
@@ -534,9 +553,9 @@ TSharedPtr<FJsonObject> FUnrealMCPUMGCommands::HandleSetTextBlockBinding(const T
 		}
 	}
 
-	// Save the Widget Blueprint
-	FKismetEditorUtilities::CompileBlueprint(WidgetBlueprint);
-	UEditorAssetLibrary::SaveAsset(BlueprintPath, false);
+	// Compile before saving so the saved asset matches its edits
+	FUnrealMCPCompileScheduler::Get().CompileNow(WidgetBlueprint);
+	UEditorAssetLibrary::SaveAsset(WidgetBlueprint->GetPathName(), false);
 
 	Response->SetBoolField(TEXT("success"), true);
 	Response->SetStringField(TEXT("binding_name"), BindingName);
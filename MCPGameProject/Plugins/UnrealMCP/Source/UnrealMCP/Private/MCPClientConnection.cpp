@@ -0,0 +1,643 @@
+#include "MCPClientConnection.h"
+#include "MCPMessageFramer.h"
+#include "MCPMessagePack.h"
+#include "MCPEventHub.h"
+#include "MCPResponseStream.h"
+#include "UnrealMCPBridge.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformTime.h"
+#include "Containers/Queue.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+
+// Buffer size for receiving data; larger reads keep big requests from taking thousands of Recv calls
+static const int32 ReceiveBufferSize = 64 * 1024;
+
+// Upper bound on how long a socket wait may block before re-checking bRunning.
+// Incoming data wakes the wait immediately, so this only affects shutdown.
+static const FTimespan ClientWaitTimeout = FTimespan::FromMilliseconds(100);
+
+/** A response waiting in the outbox, either a complete object or a stream its command is still writing */
+struct FMCPOutgoingResponse
+{
+    TSharedPtr<FJsonObject> Json;
+    TSharedPtr<FMCPResponseStream> Stream;
+};
+
+/**
+ * Completed responses waiting to be written to a connection
+ * Commands hold a reference while they execute, so a response that completes
+ * after the client has gone away is simply dropped.
+ */
+struct FMCPOutbox
+{
+    TQueue<FMCPOutgoingResponse, EQueueMode::Mpsc> Responses;
+    FEvent* WakeEvent;
+
+    /** Commands handed to the bridge whose responses have not been queued yet */
+    std::atomic<int32> InFlight;
+
+    /** Event notifications waiting to be written, kept apart so the event hub can see when they've gone out */
+    TQueue<TSharedPtr<FJsonObject>, EQueueMode::Mpsc> Notifications;
+    std::atomic<int32> QueuedNotifications;
+
+    /** Set once nothing more will be written to the client */
+    std::atomic<bool> bClosed;
+
+    FMCPOutbox()
+        : WakeEvent(FPlatformProcess::GetSynchEventFromPool(false))
+        , InFlight(0)
+        , QueuedNotifications(0)
+        , bClosed(false)
+    {
+    }
+
+    ~FMCPOutbox()
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+    }
+
+    void Push(const TSharedPtr<FJsonObject>& Response)
+    {
+        Responses.Enqueue(FMCPOutgoingResponse{ Response, nullptr });
+        WakeEvent->Trigger();
+    }
+
+    /** Queue the response of a command that went through the bridge */
+    void Complete(const TSharedPtr<FJsonObject>& Response)
+    {
+        Responses.Enqueue(FMCPOutgoingResponse{ Response, nullptr });
+        --InFlight;
+        WakeEvent->Trigger();
+    }
+
+    /** Queue a response its command is about to stream, responses behind it wait until the stream finishes */
+    void CompleteStreamed(const TSharedRef<FMCPResponseStream>& Stream)
+    {
+        Responses.Enqueue(FMCPOutgoingResponse{ nullptr, Stream });
+        --InFlight;
+        WakeEvent->Trigger();
+
+        // Checked after queueing, so either this sees the close or AbandonStreams sees the stream
+        if (bClosed)
+        {
+            Stream->Abandon();
+        }
+    }
+
+    /** Tell the producers of streams nobody will send to stop encoding them, once the writer has exited */
+    void AbandonStreams()
+    {
+        FMCPOutgoingResponse Response;
+        while (Responses.Dequeue(Response))
+        {
+            if (Response.Stream.IsValid())
+            {
+                Response.Stream->Abandon();
+            }
+        }
+    }
+
+    void PushNotification(const TSharedPtr<FJsonObject>& Notification)
+    {
+        ++QueuedNotifications;
+        Notifications.Enqueue(Notification);
+        WakeEvent->Trigger();
+    }
+};
+
+/** Hands the event hub's notifications to a connection's writer */
+class FMCPOutboxEventSink : public IMCPEventSink
+{
+public:
+    FMCPOutboxEventSink(const TSharedRef<FMCPOutbox>& InOutbox, int32 InConnectionId)
+        : Outbox(InOutbox)
+        , ConnectionId(InConnectionId)
+    {
+    }
+
+    virtual int32 GetConnectionId() const override { return ConnectionId; }
+    virtual bool IsOpen() const override { return !Outbox->bClosed; }
+    virtual bool IsReady() const override { return Outbox->QueuedNotifications == 0; }
+    virtual void Push(const TSharedPtr<FJsonObject>& Notification) override { Outbox->PushNotification(Notification); }
+
+private:
+    TSharedRef<FMCPOutbox> Outbox;
+    int32 ConnectionId;
+};
+
+/**
+ * Writes a connection's responses in completion order
+ * Runs on its own thread so the reader never blocks on a slow client and the
+ * game thread never blocks on the socket.
+ */
+class FMCPResponseWriter : public FRunnable
+{
+public:
+    explicit FMCPResponseWriter(FMCPClientConnection& InConnection)
+        : Connection(InConnection)
+        , bReaderDone(false)
+    {
+    }
+
+    /** Called by the reader once no more requests will be submitted */
+    void NotifyReaderDone()
+    {
+        bReaderDone = true;
+        Connection.Outbox->WakeEvent->Trigger();
+    }
+
+    virtual void Stop() override
+    {
+        Connection.bRunning = false;
+        NotifyReaderDone();
+    }
+
+    virtual uint32 Run() override
+    {
+        FMCPOutbox& Outbox = *Connection.Outbox;
+        for (;;)
+        {
+            FMCPOutgoingResponse Response;
+            while (Outbox.Responses.Dequeue(Response))
+            {
+                const bool bSent = Response.Stream.IsValid() ? Connection.SendStream(*Response.Stream) : Connection.SendResponse(Response.Json);
+                if (!bSent)
+                {
+                    // The client is gone, stop reading from it too
+                    Connection.bRunning = false;
+                    return 0;
+                }
+            }
+
+            TSharedPtr<FJsonObject> Notification;
+            while (Outbox.Notifications.Dequeue(Notification))
+            {
+                const bool bSent = Connection.SendResponse(Notification);
+                --Outbox.QueuedNotifications;
+                if (!bSent)
+                {
+                    Connection.bRunning = false;
+                    return 0;
+                }
+            }
+
+            // Once the reader is done, stay around only for responses still being executed
+            if (bReaderDone && (Outbox.InFlight == 0 || !Connection.bRunning) && Outbox.Responses.IsEmpty())
+            {
+                return 0;
+            }
+
+            Outbox.WakeEvent->Wait(ClientWaitTimeout);
+        }
+    }
+
+private:
+    FMCPClientConnection& Connection;
+    std::atomic<bool> bReaderDone;
+};
+
+TSharedPtr<FJsonObject> FMCPClientConnection::MakeErrorResponse(const FString& Message)
+{
+    TSharedPtr<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+    ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+    ResponseJson->SetStringField(TEXT("error"), Message);
+    return ResponseJson;
+}
+
+FMCPClientConnection::FMCPClientConnection(UUnrealMCPBridge* InBridge, TSharedPtr<FSocket> InSocket, int32 InConnectionId, const FMCPServerConfig& InConfig)
+    : Bridge(InBridge)
+    , Socket(InSocket)
+    , Thread(nullptr)
+    , ConnectionId(InConnectionId)
+    , Config(InConfig)
+    , Outbox(MakeShared<FMCPOutbox>())
+    , WriterThread(nullptr)
+    , bBinaryWireFormat(false)
+    , bRunning(true)
+    , bFinished(false)
+{
+    Writer = MakeUnique<FMCPResponseWriter>(*this);
+    EventSink = MakeShared<FMCPOutboxEventSink>(Outbox.ToSharedRef(), ConnectionId);
+}
+
+FMCPClientConnection::~FMCPClientConnection()
+{
+    if (Thread)
+    {
+        // Stops the receive loop, which in turn waits for the writer to finish
+        Thread->Kill(true);
+        delete Thread;
+        Thread = nullptr;
+    }
+
+    if (WriterThread)
+    {
+        WriterThread->Kill(true);
+        delete WriterThread;
+        WriterThread = nullptr;
+    }
+
+    if (Socket.IsValid())
+    {
+        Socket->Close();
+        Socket.Reset();
+    }
+}
+
+bool FMCPClientConnection::Start()
+{
+    WriterThread = FRunnableThread::Create(Writer.Get(), *FString::Printf(TEXT("UnrealMCPClientWriter%d"), ConnectionId), 0, TPri_Normal);
+    if (!WriterThread)
+    {
+        return false;
+    }
+
+    Thread = FRunnableThread::Create(this, *FString::Printf(TEXT("UnrealMCPClient%d"), ConnectionId), 0, TPri_Normal);
+    return Thread != nullptr;
+}
+
+void FMCPClientConnection::Stop()
+{
+    bRunning = false;
+}
+
+uint32 FMCPClientConnection::Run()
+{
+    UE_LOG(LogTemp, Display, TEXT("MCPClientConnection[%d]: Starting to handle client connection"), ConnectionId);
+    
+    // The connection stays open for any number of commands; the framer splits the stream into messages
+    FMCPMessageFramer Framer;
+    Framer.SetMaxMessageSize(Config.MaxMessageSize);
+    TArray<uint8> Buffer;
+    Buffer.SetNumUninitialized(ReceiveBufferSize);
+    bool bHandshakeChecked = false;
+    
+    while (bRunning)
+    {
+        // Sleep in the socket layer until data arrives instead of polling
+        if (!Socket->Wait(ESocketWaitConditions::WaitForRead, ClientWaitTimeout))
+        {
+            continue;
+        }
+
+        int32 BytesRead = 0;
+        if (!Socket->Recv(Buffer.GetData(), ReceiveBufferSize, BytesRead))
+        {
+            int32 LastError = (int32)ISocketSubsystem::Get()->GetLastErrorCode();
+            
+            // Check for "would block" or interrupted calls which aren't real errors
+            if (LastError == SE_EWOULDBLOCK || LastError == SE_EINTR)
+            {
+                UE_LOG(LogTemp, Verbose, TEXT("MCPClientConnection[%d]: Transient socket error %d, continuing..."), ConnectionId, LastError);
+                continue;
+            }
+
+            if (LastError != SE_NO_ERROR)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("MCPClientConnection[%d]: Client disconnected or error. Last error code: %d"), ConnectionId, LastError);
+                bRunning = false;
+            }
+            else
+            {
+                // Requests already received still get their responses if the client only closed its sending side
+                UE_LOG(LogTemp, Display, TEXT("MCPClientConnection[%d]: Client closed the connection"), ConnectionId);
+            }
+            break;
+        }
+
+        if (BytesRead == 0)
+        {
+            // Spurious wakeup (would block), go back to waiting
+            continue;
+        }
+
+        // A client opts into the binary wire format with a single byte before its first request
+        int32 DataOffset = 0;
+        if (!bHandshakeChecked)
+        {
+            bHandshakeChecked = true;
+            if (Buffer[0] == MCPBinaryHandshakeByte)
+            {
+                UE_LOG(LogTemp, Display, TEXT("MCPClientConnection[%d]: Client selected the MessagePack wire format"), ConnectionId);
+                bBinaryWireFormat = true;
+                Framer.SetBinary(true);
+                DataOffset = 1;
+
+                // Nothing has been queued for the writer yet, so the reader can send the acknowledgement itself
+                if (!SendAll(&MCPBinaryHandshakeByte, 1))
+                {
+                    bRunning = false;
+                    break;
+                }
+            }
+        }
+
+        Framer.Append(Buffer.GetData() + DataOffset, BytesRead - DataOffset);
+
+        // Submit every complete message received so far, keeping any partial one buffered
+        if (Framer.IsBinary())
+        {
+            TArray<uint8> Payload;
+            while (bRunning && Framer.PopFrame(Payload))
+            {
+                ProcessBinaryMessage(Payload);
+            }
+        }
+        else
+        {
+            FString Message;
+            while (bRunning && Framer.PopMessage(Message))
+            {
+                ProcessMessage(Message);
+            }
+        }
+
+        if (Framer.IsOverflowed())
+        {
+            // The rest of the oversized message is still in flight, so the stream can't be resynchronized
+            Outbox->Push(MakeErrorResponse(FString::Printf(
+                TEXT("Message exceeds maximum size of %d bytes"), Config.MaxMessageSize)));
+            break;
+        }
+    }
+    
+    UE_LOG(LogTemp, Display, TEXT("MCPClientConnection[%d]: Exited message receive loop"), ConnectionId);
+
+    // Let the writer deliver what's left before the socket goes away
+    Writer->NotifyReaderDone();
+    WriterThread->WaitForCompletion();
+
+    // Subscriptions are dropped on the event hub's next tick
+    Outbox->bClosed = true;
+    Outbox->AbandonStreams();
+
+    // Let the server reap this connection and free its slot
+    Socket->Close();
+    bFinished = true;
+    return 0;
+}
+
+void FMCPClientConnection::ProcessMessage(const FString& Message)
+{
+    UE_LOG(LogTemp, Display, TEXT("MCPClientConnection[%d]: Processing message, length %d"), ConnectionId, Message.Len());
+    UE_LOG(LogTemp, Verbose, TEXT("MCPClientConnection[%d]: Message: %s"), ConnectionId, *Message);
+    
+    // Parse message as JSON
+    TSharedPtr<FJsonObject> JsonMessage;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Message);
+    
+    if (!FJsonSerializer::Deserialize(Reader, JsonMessage) || !JsonMessage.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MCPClientConnection[%d]: Failed to parse message as JSON"), ConnectionId);
+        Outbox->Push(MakeErrorResponse(TEXT("Failed to parse message as JSON")));
+        return;
+    }
+
+    ProcessRequest(JsonMessage);
+}
+
+void FMCPClientConnection::ProcessBinaryMessage(const TArray<uint8>& Payload)
+{
+    UE_LOG(LogTemp, Display, TEXT("MCPClientConnection[%d]: Processing binary message, length %d"), ConnectionId, Payload.Num());
+
+    FString Error;
+    TSharedPtr<FJsonObject> JsonMessage = FMCPMessagePack::Decode(Payload.GetData(), Payload.Num(), Error);
+    if (!JsonMessage.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MCPClientConnection[%d]: Failed to decode MessagePack message: %s"), ConnectionId, *Error);
+        Outbox->Push(MakeErrorResponse(FString::Printf(TEXT("Failed to decode MessagePack message: %s"), *Error)));
+        return;
+    }
+
+    ProcessRequest(JsonMessage);
+}
+
+void FMCPClientConnection::ProcessRequest(const TSharedPtr<FJsonObject>& JsonMessage)
+{
+
+    // An optional client-chosen id is echoed back so pipelined responses can be matched to their requests
+    const TSharedPtr<FJsonValue> RequestId = JsonMessage->TryGetField(TEXT("id"));
+    
+    // Accept both the "type" field used by the Python client and the MCP "command" field
+    FString CommandType;
+    if (!JsonMessage->TryGetStringField(TEXT("type"), CommandType) &&
+        !JsonMessage->TryGetStringField(TEXT("command"), CommandType))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MCPClientConnection[%d]: Message missing 'type' field"), ConnectionId);
+        TSharedPtr<FJsonObject> ErrorResponse = MakeErrorResponse(TEXT("Missing 'type' field in command"));
+        if (RequestId.IsValid())
+        {
+            ErrorResponse->SetField(TEXT("id"), RequestId);
+        }
+        Outbox->Push(ErrorResponse);
+        return;
+    }
+    
+    // Parameters are optional
+    TSharedPtr<FJsonObject> Params = MakeShareable(new FJsonObject());
+    const TSharedPtr<FJsonObject>* ParamsObject = nullptr;
+    if (JsonMessage->TryGetObjectField(TEXT("params"), ParamsObject) && ParamsObject->IsValid())
+    {
+        Params = *ParamsObject;
+    }
+    
+    // Health checks and introspection are answered right here so they never wait behind a busy editor frame.
+    // Without an id the client expects responses in request order, so only skip ahead when nothing is pending.
+    if (Bridge->CanExecuteOnAnyThread(CommandType) && (RequestId.IsValid() || Outbox->InFlight == 0))
+    {
+        TSharedPtr<FJsonObject> Response = Bridge->ExecuteCommandOnCallingThread(CommandType, Params);
+        if (RequestId.IsValid())
+        {
+            Response->SetField(TEXT("id"), RequestId);
+        }
+        Outbox->Push(Response);
+        return;
+    }
+
+    // Optional scheduling lane, see EMCPCommandPriority
+    EMCPCommandPriority Priority = EMCPCommandPriority::Default;
+    FString PriorityName;
+    if (JsonMessage->TryGetStringField(TEXT("priority"), PriorityName))
+    {
+        if (PriorityName == TEXT("interactive"))
+        {
+            Priority = EMCPCommandPriority::Interactive;
+        }
+        else if (PriorityName == TEXT("bulk"))
+        {
+            Priority = EMCPCommandPriority::Bulk;
+        }
+        else
+        {
+            TSharedPtr<FJsonObject> ErrorResponse = MakeErrorResponse(FString::Printf(TEXT("Unknown priority '%s', expected 'interactive' or 'bulk'"), *PriorityName));
+            if (RequestId.IsValid())
+            {
+                ErrorResponse->SetField(TEXT("id"), RequestId);
+            }
+            Outbox->Push(ErrorResponse);
+            return;
+        }
+    }
+
+    // Without an id the responses must come back in request order, so keep this
+    // connection's commands from overtaking each other across priority lanes
+    const FString OrderingKey = RequestId.IsValid() ? FString() : FString::Printf(TEXT("connection:%d"), ConnectionId);
+
+    UE_LOG(LogTemp, Display, TEXT("MCPClientConnection[%d]: Submitting command: %s"), ConnectionId, *CommandType);
+    
+    // Large results may be streamed as they're written, unless the client asks for them whole.
+    // MessagePack frames are length prefixed, so binary responses are always built first.
+    bool bAcceptStream = !bBinaryWireFormat;
+    bool bStreamField = true;
+    if (JsonMessage->TryGetBoolField(TEXT("stream"), bStreamField))
+    {
+        bAcceptStream = bAcceptStream && bStreamField;
+    }
+
+    FMCPStreamCallback OnStream;
+    if (bAcceptStream)
+    {
+        OnStream = [Outbox = Outbox, RequestId](const TSharedRef<FMCPResponseStream>& Stream)
+        {
+            Stream->SetRequestId(RequestId);
+            Outbox->CompleteStreamed(Stream);
+        };
+    }
+
+    // Don't wait for the result; the writer sends it whenever the command completes
+    ++Outbox->InFlight;
+    Bridge->ExecuteCommandAsync(CommandType, Params, [Outbox = Outbox, RequestId](TSharedPtr<FJsonObject> Response)
+    {
+        if (RequestId.IsValid())
+        {
+            Response->SetField(TEXT("id"), RequestId);
+        }
+        Outbox->Complete(Response);
+    }, Priority, OrderingKey, EventSink, MoveTemp(OnStream));
+}
+
+bool FMCPClientConnection::SendResponse(const TSharedPtr<FJsonObject>& Response)
+{
+    if (bBinaryWireFormat)
+    {
+        // Length prefix first, patched once the payload size is known
+        TArray<uint8> Frame;
+        Frame.AddZeroed(4);
+        FMCPMessagePack::Encode(Response, Frame);
+        const uint32 PayloadLength = Frame.Num() - 4;
+        Frame[0] = uint8(PayloadLength >> 24);
+        Frame[1] = uint8(PayloadLength >> 16);
+        Frame[2] = uint8(PayloadLength >> 8);
+        Frame[3] = uint8(PayloadLength);
+
+        if (!SendAll(Frame.GetData(), Frame.Num()))
+        {
+            UE_LOG(LogTemp, Error, TEXT("MCPClientConnection[%d]: Failed to send binary response of %d bytes"), ConnectionId, Frame.Num());
+            return false;
+        }
+
+        UE_LOG(LogTemp, Display, TEXT("MCPClientConnection[%d]: Binary response sent successfully, length %d"), ConnectionId, Frame.Num());
+        return true;
+    }
+
+    // Serialized here rather than on the game thread, which only builds the JSON object
+    FString ResponseString;
+    TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&ResponseString);
+    FJsonSerializer::Serialize(Response.ToSharedRef(), JsonWriter);
+
+    UE_LOG(LogTemp, Verbose, TEXT("MCPClientConnection[%d]: Sending response: %s"), ConnectionId, *ResponseString);
+
+    // Responses are newline terminated so clients can read them off a persistent connection
+    FTCHARToUTF8 Utf8Response(*(ResponseString + TEXT("\n")));
+    
+    if (!SendAll((const uint8*)Utf8Response.Get(), Utf8Response.Length()))
+    {
+        UE_LOG(LogTemp, Error, TEXT("MCPClientConnection[%d]: Failed to send response of %d bytes"), ConnectionId, Utf8Response.Length());
+        return false;
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("MCPClientConnection[%d]: Response sent successfully, length %d"), ConnectionId, Utf8Response.Length());
+    return true;
+}
+
+bool FMCPClientConnection::SendStream(FMCPResponseStream& Stream)
+{
+    TArray<uint8> Chunk;
+    for (;;)
+    {
+        // Read before popping, so a finished stream that has nothing left really is done
+        const bool bStreamFinished = Stream.IsFinished();
+        if (Stream.PopChunk(Chunk))
+        {
+            if (!SendAll(Chunk.GetData(), Chunk.Num()))
+            {
+                UE_LOG(LogTemp, Error, TEXT("MCPClientConnection[%d]: Failed to send streamed response chunk of %d bytes"), ConnectionId, Chunk.Num());
+                Stream.Abandon();
+                return false;
+            }
+            continue;
+        }
+
+        if (bStreamFinished)
+        {
+            break;
+        }
+        if (!bRunning)
+        {
+            Stream.Abandon();
+            return false;
+        }
+        Stream.Wait(ClientWaitTimeout);
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("MCPClientConnection[%d]: Streamed response sent successfully, length %lld"), ConnectionId, Stream.GetTotalBytes());
+    return true;
+}
+
+bool FMCPClientConnection::SendAll(const uint8* Data, int32 NumBytes)
+{
+    int32 TotalSent = 0;
+    double LastProgressTime = FPlatformTime::Seconds();
+
+    while (TotalSent < NumBytes)
+    {
+        // A single Send only writes what fits in the socket buffer, keep going until everything is out
+        int32 BytesSent = 0;
+        if (!Socket->Send(Data + TotalSent, NumBytes - TotalSent, BytesSent))
+        {
+            int32 LastError = (int32)ISocketSubsystem::Get()->GetLastErrorCode();
+            if (LastError != SE_EWOULDBLOCK && LastError != SE_EINTR)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("MCPClientConnection[%d]: Send failed after %d of %d bytes. Last error code: %d"),
+                       ConnectionId, TotalSent, NumBytes, LastError);
+                return false;
+            }
+            BytesSent = 0;
+        }
+
+        if (BytesSent > 0)
+        {
+            TotalSent += BytesSent;
+            LastProgressTime = FPlatformTime::Seconds();
+            continue;
+        }
+
+        // The client isn't reading fast enough; wait for room in the send buffer instead of spinning
+        if (!bRunning || FPlatformTime::Seconds() - LastProgressTime > Config.SendTimeoutSeconds)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("MCPClientConnection[%d]: Send stalled after %d of %d bytes, giving up"), ConnectionId, TotalSent, NumBytes);
+            return false;
+        }
+        Socket->Wait(ESocketWaitConditions::WaitForWrite, ClientWaitTimeout);
+    }
+
+    return true;
+}
@@ -0,0 +1,213 @@
+#include "MCPCommandQueue.h"
+#include "Misc/ScopeLock.h"
+#include "HAL/PlatformTime.h"
+
+FMCPCommandQueue::FMCPCommandQueue(float InBudgetMs)
+    : BudgetMs(InBudgetMs)
+    , TotalWaitMs(0.0)
+    , WaitSamples(0)
+{
+    Stats.BudgetMs = BudgetMs;
+}
+
+FMCPCommandQueue::~FMCPCommandQueue()
+{
+    Stop();
+}
+
+void FMCPCommandQueue::Start()
+{
+    check(IsInGameThread());
+    if (!TickerHandle.IsValid())
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMCPCommandQueue::Tick));
+    }
+}
+
+void FMCPCommandQueue::Stop()
+{
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+
+    // Collect under the lock, cancel outside it so callbacks are free to enqueue or read stats
+    TArray<TUniquePtr<FQueuedWork>> Cancelled;
+    {
+        FScopeLock ScopeLock(&Lock);
+        bool bFromBulk = false;
+        while (TUniquePtr<FQueuedWork> Work = PopNext(bFromBulk))
+        {
+            Cancelled.Add(MoveTemp(Work));
+        }
+        BulkKeyCounts.Empty();
+        Stats.InteractiveDepth = 0;
+        Stats.BulkDepth = 0;
+    }
+
+    for (TUniquePtr<FQueuedWork>& Work : Cancelled)
+    {
+        if (Work->OnCancel)
+        {
+            Work->OnCancel();
+        }
+    }
+}
+
+void FMCPCommandQueue::Enqueue(EMCPCommandPriority Priority, const TArray<FString>& OrderingKeys, FMCPQueuedStep Step, TUniqueFunction<void()> OnCancel)
+{
+    TUniquePtr<FQueuedWork> Work = MakeUnique<FQueuedWork>();
+    Work->Step = MoveTemp(Step);
+    Work->OnCancel = MoveTemp(OnCancel);
+    Work->OrderingKeys = OrderingKeys;
+    Work->EnqueueTime = FPlatformTime::Seconds();
+
+    FScopeLock ScopeLock(&Lock);
+
+    bool bBulk = Priority == EMCPCommandPriority::Bulk;
+    if (!bBulk)
+    {
+        // Never let interactive work overtake bulk work queued earlier for the same asset
+        for (const FString& Key : OrderingKeys)
+        {
+            if (BulkKeyCounts.Contains(Key))
+            {
+                bBulk = true;
+                break;
+            }
+        }
+    }
+
+    if (bBulk)
+    {
+        for (const FString& Key : OrderingKeys)
+        {
+            ++BulkKeyCounts.FindOrAdd(Key);
+        }
+        BulkLane.Enqueue(MoveTemp(Work));
+        ++Stats.BulkDepth;
+    }
+    else
+    {
+        InteractiveLane.Enqueue(MoveTemp(Work));
+        ++Stats.InteractiveDepth;
+    }
+
+    Stats.PeakDepth = FMath::Max(Stats.PeakDepth, Stats.InteractiveDepth + Stats.BulkDepth);
+}
+
+FMCPCommandQueueStats FMCPCommandQueue::GetStats() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return Stats;
+}
+
+TUniquePtr<FMCPCommandQueue::FQueuedWork> FMCPCommandQueue::PopNext(bool& bOutFromBulk)
+{
+    TUniquePtr<FQueuedWork> Work;
+
+    bOutFromBulk = false;
+    if (ResumeInteractive.IsValid())
+    {
+        return MoveTemp(ResumeInteractive);
+    }
+    if (InteractiveLane.Dequeue(Work))
+    {
+        return Work;
+    }
+
+    bOutFromBulk = true;
+    if (ResumeBulk.IsValid())
+    {
+        return MoveTemp(ResumeBulk);
+    }
+    if (BulkLane.Dequeue(Work))
+    {
+        return Work;
+    }
+    return nullptr;
+}
+
+bool FMCPCommandQueue::Tick(float DeltaTime)
+{
+    const double FrameStart = FPlatformTime::Seconds();
+    const double Deadline = FrameStart + BudgetMs / 1000.0;
+    bool bWorkRemaining = false;
+    bool bRanWork = false;
+
+    // Always run at least one step so a small budget can't starve the queue
+    do
+    {
+        bool bFromBulk = false;
+        TUniquePtr<FQueuedWork> Work;
+        {
+            FScopeLock ScopeLock(&Lock);
+            Work = PopNext(bFromBulk);
+        }
+        if (!Work.IsValid())
+        {
+            bWorkRemaining = false;
+            break;
+        }
+
+        bRanWork = true;
+        const double StepStart = FPlatformTime::Seconds();
+        const bool bFirstStep = !Work->bStarted;
+        Work->bStarted = true;
+        const bool bFinished = Work->Step(Deadline);
+
+        FScopeLock ScopeLock(&Lock);
+        if (bFirstStep)
+        {
+            const double WaitMs = (StepStart - Work->EnqueueTime) * 1000.0;
+            TotalWaitMs += WaitMs;
+            ++WaitSamples;
+            Stats.AverageWaitMs = TotalWaitMs / WaitSamples;
+            Stats.MaxWaitMs = FMath::Max(Stats.MaxWaitMs, WaitMs);
+        }
+
+        if (bFinished)
+        {
+            ++Stats.Executed;
+            if (bFromBulk)
+            {
+                --Stats.BulkDepth;
+                for (const FString& Key : Work->OrderingKeys)
+                {
+                    int32* Count = BulkKeyCounts.Find(Key);
+                    if (Count && --(*Count) <= 0)
+                    {
+                        BulkKeyCounts.Remove(Key);
+                    }
+                }
+            }
+            else
+            {
+                --Stats.InteractiveDepth;
+            }
+        }
+        else
+        {
+            // Resumed ahead of the rest of its lane next frame
+            (bFromBulk ? ResumeBulk : ResumeInteractive) = MoveTemp(Work);
+        }
+
+        bWorkRemaining = Stats.InteractiveDepth + Stats.BulkDepth > 0;
+    }
+    while (bWorkRemaining && FPlatformTime::Seconds() < Deadline);
+
+    if (!bRanWork)
+    {
+        return true;
+    }
+
+    FScopeLock ScopeLock(&Lock);
+    Stats.LastFrameMs = (FPlatformTime::Seconds() - FrameStart) * 1000.0;
+    if (bWorkRemaining)
+    {
+        ++Stats.BudgetExhaustedFrames;
+    }
+
+    return true;
+}
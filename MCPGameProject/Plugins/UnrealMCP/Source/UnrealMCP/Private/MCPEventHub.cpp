@@ -0,0 +1,323 @@
+#include "MCPEventHub.h"
+#include "Commands/UnrealMCPEditorCommands.h"
+#include "Commands/UnrealMCPLevelJournal.h"
+#include "Commands/UnrealMCPCommonUtils.h"
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "HAL/PlatformTime.h"
+#include "Dom/JsonValue.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+
+// Wire names of the event streams, in flag order
+static const TPair<const TCHAR*, EMCPEventStreams> EventStreamNames[] =
+{
+    { TEXT("actors"), EMCPEventStreams::Actors },
+    { TEXT("blueprint_compiled"), EMCPEventStreams::BlueprintCompiled },
+    { TEXT("asset_saved"), EMCPEventStreams::AssetSaved },
+    { TEXT("pie"), EMCPEventStreams::PIE },
+};
+
+// Slowest rate a subscription may ask for, in notifications per second
+static const float MinEventRate = 0.1f;
+
+FMCPEventHub::FMCPEventHub(TSharedPtr<FUnrealMCPEditorCommands> InEditorCommands, float InMaxRate)
+    : EditorCommands(InEditorCommands)
+    , MaxRate(FMath::Max(InMaxRate, MinEventRate))
+    , NextSubscriptionId(1)
+    , bBound(false)
+{
+}
+
+FMCPEventHub::~FMCPEventHub()
+{
+    Subscriptions.Empty();
+    UpdateBindings();
+}
+
+bool FMCPEventHub::ParseStreams(const TArray<TSharedPtr<FJsonValue>>& Names, EMCPEventStreams& OutStreams, FString& OutError)
+{
+    OutStreams = EMCPEventStreams::None;
+    for (const TSharedPtr<FJsonValue>& NameValue : Names)
+    {
+        const FString Name = NameValue->AsString();
+        bool bKnown = false;
+        for (const TPair<const TCHAR*, EMCPEventStreams>& Stream : EventStreamNames)
+        {
+            if (Name == Stream.Key)
+            {
+                OutStreams |= Stream.Value;
+                bKnown = true;
+            }
+        }
+
+        if (!bKnown)
+        {
+            OutError = FString::Printf(TEXT("Unknown event stream '%s', expected actors, blueprint_compiled, asset_saved or pie"), *Name);
+            return false;
+        }
+    }
+    return true;
+}
+
+TArray<TSharedPtr<FJsonValue>> FMCPEventHub::StreamsToJson(EMCPEventStreams Streams)
+{
+    TArray<TSharedPtr<FJsonValue>> Names;
+    for (const TPair<const TCHAR*, EMCPEventStreams>& Stream : EventStreamNames)
+    {
+        if (EnumHasAnyFlags(Streams, Stream.Value))
+        {
+            Names.Add(MakeShared<FJsonValueString>(Stream.Key));
+        }
+    }
+    return Names;
+}
+
+int32 FMCPEventHub::Subscribe(const TSharedRef<IMCPEventSink>& Sink, EMCPEventStreams Streams, float Rate, EMCPActorFields ActorFields)
+{
+    check(IsInGameThread());
+
+    FSubscription& Subscription = Subscriptions.AddDefaulted_GetRef();
+    Subscription.Id = NextSubscriptionId++;
+    Subscription.Sink = Sink;
+    Subscription.Streams = Streams;
+    Subscription.ActorFields = ActorFields;
+    Subscription.MinInterval = 1.0 / FMath::Clamp(Rate, MinEventRate, MaxRate);
+    if (EnumHasAnyFlags(Streams, EMCPEventStreams::Actors))
+    {
+        // Report changes from now on, the client reads the current state itself
+        Subscription.ActorVersion = EditorCommands->GetLevelJournal().GetVersion();
+    }
+
+    const int32 SubscriptionId = Subscription.Id;
+    UpdateBindings();
+    return SubscriptionId;
+}
+
+bool FMCPEventHub::Unsubscribe(int32 ConnectionId, int32 SubscriptionId)
+{
+    const int32 Removed = Subscriptions.RemoveAll([ConnectionId, SubscriptionId](const FSubscription& Subscription)
+    {
+        return Subscription.Id == SubscriptionId && Subscription.Sink->GetConnectionId() == ConnectionId;
+    });
+    UpdateBindings();
+    return Removed > 0;
+}
+
+int32 FMCPEventHub::UnsubscribeAll(int32 ConnectionId)
+{
+    const int32 Removed = Subscriptions.RemoveAll([ConnectionId](const FSubscription& Subscription)
+    {
+        return Subscription.Sink->GetConnectionId() == ConnectionId;
+    });
+    UpdateBindings();
+    return Removed;
+}
+
+void FMCPEventHub::UpdateBindings()
+{
+    const bool bWantBound = Subscriptions.Num() > 0 && GEditor;
+    if (bWantBound == bBound)
+    {
+        return;
+    }
+
+    if (bWantBound)
+    {
+        BlueprintPreCompileHandle = GEditor->OnBlueprintPreCompile().AddRaw(this, &FMCPEventHub::HandleBlueprintPreCompile);
+        BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddRaw(this, &FMCPEventHub::HandleBlueprintCompiled);
+        PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FMCPEventHub::HandlePackageSaved);
+        PIEStartedHandle = FEditorDelegates::PostPIEStarted.AddRaw(this, &FMCPEventHub::HandlePIEStarted);
+        PIEEndedHandle = FEditorDelegates::EndPIE.AddRaw(this, &FMCPEventHub::HandlePIEEnded);
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FMCPEventHub::Tick));
+    }
+    else
+    {
+        if (GEditor)
+        {
+            GEditor->OnBlueprintPreCompile().Remove(BlueprintPreCompileHandle);
+            GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+        }
+        UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+        FEditorDelegates::PostPIEStarted.Remove(PIEStartedHandle);
+        FEditorDelegates::EndPIE.Remove(PIEEndedHandle);
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+        CompilingBlueprints.Empty();
+    }
+    bBound = bWantBound;
+}
+
+bool FMCPEventHub::Tick(float DeltaTime)
+{
+    const double Now = FPlatformTime::Seconds();
+    for (int32 Index = 0; Index < Subscriptions.Num(); )
+    {
+        FSubscription& Subscription = Subscriptions[Index];
+        if (!Subscription.Sink->IsOpen())
+        {
+            // The client disconnected without unsubscribing
+            Subscriptions.RemoveAt(Index);
+            continue;
+        }
+
+        // Events keep collecting until the interval has passed and the client has taken the last notification
+        if (Now - Subscription.LastSendTime >= Subscription.MinInterval && Subscription.Sink->IsReady())
+        {
+            if (TSharedPtr<FJsonObject> Notification = MakeNotification(Subscription))
+            {
+                Subscription.Sink->Push(Notification);
+                Subscription.LastSendTime = Now;
+            }
+        }
+        ++Index;
+    }
+
+    if (Subscriptions.Num() == 0)
+    {
+        UpdateBindings();
+    }
+    return true;
+}
+
+TSharedPtr<FJsonObject> FMCPEventHub::MakeNotification(FSubscription& Subscription)
+{
+    // The header comes first so clients can tell a notification from a response without parsing all of it
+    TSharedPtr<FJsonObject> Notification = MakeShared<FJsonObject>();
+    Notification->SetStringField(TEXT("notification"), TEXT("editor_events"));
+    Notification->SetNumberField(TEXT("subscription"), Subscription.Id);
+    Notification->SetNumberField(TEXT("sequence"), Subscription.Sequence + 1);
+    bool bHasEvents = false;
+
+    // Comparing versions is all an idle level costs per frame
+    if (EnumHasAnyFlags(Subscription.Streams, EMCPEventStreams::Actors) &&
+        EditorCommands->GetLevelJournal().GetVersion() != Subscription.ActorVersion)
+    {
+        TSharedPtr<FJsonObject> Changes = EditorCommands->MakeLevelChanges(Subscription.ActorVersion, true, Subscription.ActorFields);
+        Subscription.ActorVersion = (uint64)Changes->GetNumberField(TEXT("version"));
+
+        // Actors added and removed in the same interval cancel out and leave nothing to report
+        if (Changes->GetBoolField(TEXT("resync")) || Changes->GetArrayField(TEXT("changes")).Num() > 0)
+        {
+            Notification->SetObjectField(TEXT("actors"), Changes);
+            bHasEvents = true;
+        }
+    }
+
+    if (Subscription.CompiledBlueprints.Num() > 0)
+    {
+        TArray<TSharedPtr<FJsonValue>> BlueprintArray;
+        for (const TWeakObjectPtr<UBlueprint>& WeakBlueprint : Subscription.CompiledBlueprints)
+        {
+            const UBlueprint* Blueprint = WeakBlueprint.Get();
+            if (!Blueprint)
+            {
+                continue;
+            }
+
+            TSharedPtr<FJsonObject> BlueprintObject = MakeShared<FJsonObject>();
+            BlueprintObject->SetStringField(TEXT("name"), Blueprint->GetName());
+            BlueprintObject->SetStringField(TEXT("path"), Blueprint->GetPathName());
+            BlueprintObject->SetStringField(TEXT("status"), FUnrealMCPCommonUtils::BlueprintStatusToString(Blueprint));
+            BlueprintArray.Add(MakeShared<FJsonValueObject>(BlueprintObject));
+        }
+        Subscription.CompiledBlueprints.Reset();
+
+        if (BlueprintArray.Num() > 0)
+        {
+            Notification->SetArrayField(TEXT("blueprint_compiled"), BlueprintArray);
+            bHasEvents = true;
+        }
+    }
+
+    if (Subscription.SavedPackages.Num() > 0)
+    {
+        TArray<TSharedPtr<FJsonValue>> PackageArray;
+        for (const FName& PackageName : Subscription.SavedPackages)
+        {
+            PackageArray.Add(MakeShared<FJsonValueString>(PackageName.ToString()));
+        }
+        Subscription.SavedPackages.Reset();
+        Notification->SetArrayField(TEXT("asset_saved"), PackageArray);
+        bHasEvents = true;
+    }
+
+    if (Subscription.PIETransitions.Num() > 0)
+    {
+        // Every transition is kept, so a session that starts and stops within one interval isn't missed
+        Notification->SetArrayField(TEXT("pie"), Subscription.PIETransitions);
+        Subscription.PIETransitions.Reset();
+        bHasEvents = true;
+    }
+
+    if (!bHasEvents)
+    {
+        return nullptr;
+    }
+
+    ++Subscription.Sequence;
+    return Notification;
+}
+
+void FMCPEventHub::HandleBlueprintPreCompile(UBlueprint* Blueprint)
+{
+    // The compiled notification doesn't say which blueprints it was for
+    CompilingBlueprints.AddUnique(Blueprint);
+}
+
+void FMCPEventHub::HandleBlueprintCompiled()
+{
+    for (FSubscription& Subscription : Subscriptions)
+    {
+        if (EnumHasAnyFlags(Subscription.Streams, EMCPEventStreams::BlueprintCompiled))
+        {
+            for (const TWeakObjectPtr<UBlueprint>& Blueprint : CompilingBlueprints)
+            {
+                Subscription.CompiledBlueprints.AddUnique(Blueprint);
+            }
+        }
+    }
+    CompilingBlueprints.Reset();
+}
+
+void FMCPEventHub::HandlePackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext SaveContext)
+{
+    // Cooking and other procedural saves don't change the project's assets
+    if (!Package || SaveContext.IsProceduralSave())
+    {
+        return;
+    }
+
+    for (FSubscription& Subscription : Subscriptions)
+    {
+        if (EnumHasAnyFlags(Subscription.Streams, EMCPEventStreams::AssetSaved))
+        {
+            Subscription.SavedPackages.AddUnique(Package->GetFName());
+        }
+    }
+}
+
+void FMCPEventHub::HandlePIEStarted(const bool bIsSimulating)
+{
+    AddPIETransition(TEXT("started"), bIsSimulating);
+}
+
+void FMCPEventHub::HandlePIEEnded(const bool bIsSimulating)
+{
+    AddPIETransition(TEXT("stopped"), bIsSimulating);
+}
+
+void FMCPEventHub::AddPIETransition(const TCHAR* State, bool bIsSimulating)
+{
+    TSharedPtr<FJsonObject> Transition = MakeShared<FJsonObject>();
+    Transition->SetStringField(TEXT("state"), State);
+    Transition->SetBoolField(TEXT("simulating"), bIsSimulating);
+
+    for (FSubscription& Subscription : Subscriptions)
+    {
+        if (EnumHasAnyFlags(Subscription.Streams, EMCPEventStreams::PIE))
+        {
+            Subscription.PIETransitions.Add(MakeShared<FJsonValueObject>(Transition));
+        }
+    }
+}
@@ -0,0 +1,167 @@
+#include "MCPMessageFramer.h"
+
+FMCPMessageFramer::FMCPMessageFramer()
+    : MaxMessageSize(MAX_int32)
+    , bBinary(false)
+{
+    Reset();
+}
+
+void FMCPMessageFramer::Append(const uint8* Data, int32 NumBytes)
+{
+    if (Data && NumBytes > 0)
+    {
+        Compact();
+        Buffer.Append(Data, NumBytes);
+    }
+}
+
+void FMCPMessageFramer::SetBinary(bool bInBinary)
+{
+    Compact();
+    bBinary = bInBinary;
+}
+
+void FMCPMessageFramer::Compact()
+{
+    if (ConsumedBytes > 0)
+    {
+        Buffer.RemoveAt(0, ConsumedBytes, EAllowShrinking::No);
+        // Binary frames don't scan, so ScanOffset may trail the frames consumed
+        ScanOffset = FMath::Max(ScanOffset - ConsumedBytes, 0);
+        if (MessageStart != INDEX_NONE)
+        {
+            MessageStart -= ConsumedBytes;
+        }
+        ConsumedBytes = 0;
+    }
+}
+
+bool FMCPMessageFramer::PopMessage(FString& OutMessage)
+{
+    if (bOverflowed)
+    {
+        return false;
+    }
+
+    for (; ScanOffset < Buffer.Num(); ++ScanOffset)
+    {
+        const uint8 Char = Buffer[ScanOffset];
+
+        // Between messages: wait for the opening brace of the next object
+        if (MessageStart == INDEX_NONE)
+        {
+            if (Char == '{')
+            {
+                MessageStart = ScanOffset;
+                Depth = 1;
+            }
+            continue;
+        }
+
+        if (bInString)
+        {
+            if (bEscaped)
+            {
+                bEscaped = false;
+            }
+            else if (Char == '\\')
+            {
+                bEscaped = true;
+            }
+            else if (Char == '"')
+            {
+                bInString = false;
+            }
+            continue;
+        }
+
+        if (Char == '"')
+        {
+            bInString = true;
+        }
+        else if (Char == '{' || Char == '[')
+        {
+            ++Depth;
+        }
+        else if ((Char == '}' || Char == ']') && --Depth == 0)
+        {
+            // Complete top-level object
+            const int32 MessageLength = ScanOffset - MessageStart + 1;
+            FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Buffer.GetData() + MessageStart), MessageLength);
+            OutMessage = FString(Converted.Length(), Converted.Get());
+
+            // Popped messages are dropped from the buffer together on the next Append
+            ++ScanOffset;
+            ConsumedBytes = ScanOffset;
+            MessageStart = INDEX_NONE;
+            return true;
+        }
+    }
+
+    // Nothing but separators scanned so far, no need to keep them around
+    if (MessageStart == INDEX_NONE)
+    {
+        Buffer.Reset();
+        ScanOffset = 0;
+        ConsumedBytes = 0;
+    }
+    else if (Buffer.Num() - MessageStart > MaxMessageSize)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MCPMessageFramer: Message exceeds the %d byte limit"), MaxMessageSize);
+        bOverflowed = true;
+        Buffer.Empty();
+        ConsumedBytes = 0;
+    }
+
+    return false;
+}
+
+bool FMCPMessageFramer::PopFrame(TArray<uint8>& OutPayload)
+{
+    check(bBinary);
+    const int32 Available = Buffer.Num() - ConsumedBytes;
+    if (bOverflowed || Available < 4)
+    {
+        return false;
+    }
+
+    const uint8* Frame = Buffer.GetData() + ConsumedBytes;
+    const uint32 Length = (uint32(Frame[0]) << 24) | (uint32(Frame[1]) << 16) | (uint32(Frame[2]) << 8) | uint32(Frame[3]);
+    if (Length > (uint32)MaxMessageSize)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("MCPMessageFramer: Frame of %u bytes exceeds the %d byte limit"), Length, MaxMessageSize);
+        bOverflowed = true;
+        Buffer.Empty();
+        ConsumedBytes = 0;
+        return false;
+    }
+
+    if (Available - 4 < (int32)Length)
+    {
+        return false;
+    }
+
+    // Like messages, popped frames are dropped from the buffer together on the next Append
+    OutPayload.Reset(Length);
+    OutPayload.Append(Frame + 4, Length);
+    ConsumedBytes += Length + 4;
+    if (ConsumedBytes == Buffer.Num())
+    {
+        Buffer.Reset();
+        ConsumedBytes = 0;
+    }
+    return true;
+}
+
+void FMCPMessageFramer::Reset()
+{
+    Buffer.Reset();
+    ConsumedBytes = 0;
+    ScanOffset = 0;
+    MessageStart = INDEX_NONE;
+    Depth = 0;
+    bInString = false;
+    bEscaped = false;
+    bOverflowed = false;
+}
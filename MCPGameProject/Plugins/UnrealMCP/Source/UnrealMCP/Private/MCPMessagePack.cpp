@@ -0,0 +1,438 @@
+#include "MCPMessagePack.h"
+#include "Dom/JsonValue.h"
+
+// Deepest nesting accepted when decoding, keeps hostile payloads from exhausting the stack
+static const int32 MessagePackMaxDepth = 512;
+
+namespace MCPMessagePack
+{
+    template <typename T>
+    static void WriteBigEndian(TArray<uint8>& Out, T Value)
+    {
+        for (int32 Shift = (sizeof(T) - 1) * 8; Shift >= 0; Shift -= 8)
+        {
+            Out.Add(static_cast<uint8>(static_cast<uint64>(Value) >> Shift));
+        }
+    }
+
+    static void WriteString(TArray<uint8>& Out, const FString& String)
+    {
+        FTCHARToUTF8 Utf8(*String, String.Len());
+        const uint32 Length = Utf8.Length();
+        if (Length < 32)
+        {
+            Out.Add(0xA0 | Length);
+        }
+        else if (Length <= MAX_uint8)
+        {
+            Out.Add(0xD9);
+            Out.Add(static_cast<uint8>(Length));
+        }
+        else if (Length <= MAX_uint16)
+        {
+            Out.Add(0xDA);
+            WriteBigEndian<uint16>(Out, Length);
+        }
+        else
+        {
+            Out.Add(0xDB);
+            WriteBigEndian<uint32>(Out, Length);
+        }
+        Out.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Length);
+    }
+
+    static void WriteInteger(TArray<uint8>& Out, int64 Value)
+    {
+        if (Value >= 0)
+        {
+            if (Value < 128)
+            {
+                Out.Add(static_cast<uint8>(Value));
+            }
+            else if (Value <= MAX_uint8)
+            {
+                Out.Add(0xCC);
+                Out.Add(static_cast<uint8>(Value));
+            }
+            else if (Value <= MAX_uint16)
+            {
+                Out.Add(0xCD);
+                WriteBigEndian<uint16>(Out, Value);
+            }
+            else if (Value <= MAX_uint32)
+            {
+                Out.Add(0xCE);
+                WriteBigEndian<uint32>(Out, Value);
+            }
+            else
+            {
+                Out.Add(0xCF);
+                WriteBigEndian<uint64>(Out, Value);
+            }
+        }
+        else if (Value >= -32)
+        {
+            Out.Add(static_cast<uint8>(Value));
+        }
+        else if (Value >= MIN_int8)
+        {
+            Out.Add(0xD0);
+            Out.Add(static_cast<uint8>(Value));
+        }
+        else if (Value >= MIN_int16)
+        {
+            Out.Add(0xD1);
+            WriteBigEndian<uint16>(Out, static_cast<uint16>(Value));
+        }
+        else if (Value >= MIN_int32)
+        {
+            Out.Add(0xD2);
+            WriteBigEndian<uint32>(Out, static_cast<uint32>(Value));
+        }
+        else
+        {
+            Out.Add(0xD3);
+            WriteBigEndian<uint64>(Out, static_cast<uint64>(Value));
+        }
+    }
+
+    static void WriteNumber(TArray<uint8>& Out, double Value)
+    {
+        // 2^63 is the first double past the int64 range
+        if (FMath::IsFinite(Value) && Value == FMath::FloorToDouble(Value) && Value >= -9223372036854775808.0 && Value < 9223372036854775808.0)
+        {
+            WriteInteger(Out, static_cast<int64>(Value));
+            return;
+        }
+
+        Out.Add(0xCB);
+        uint64 Bits;
+        FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+        WriteBigEndian<uint64>(Out, Bits);
+    }
+
+    static void WriteContainerHeader(TArray<uint8>& Out, uint32 Count, uint8 FixBase, uint8 Marker16)
+    {
+        if (Count < 16)
+        {
+            Out.Add(FixBase | Count);
+        }
+        else if (Count <= MAX_uint16)
+        {
+            Out.Add(Marker16);
+            WriteBigEndian<uint16>(Out, Count);
+        }
+        else
+        {
+            // The 32 bit marker always follows the 16 bit one
+            Out.Add(Marker16 + 1);
+            WriteBigEndian<uint32>(Out, Count);
+        }
+    }
+
+    static void WriteObject(TArray<uint8>& Out, const FJsonObject& Object);
+
+    static void WriteValue(TArray<uint8>& Out, const TSharedPtr<FJsonValue>& Value)
+    {
+        if (!Value.IsValid())
+        {
+            Out.Add(0xC0);
+            return;
+        }
+
+        switch (Value->Type)
+        {
+        case EJson::Boolean:
+            Out.Add(Value->AsBool() ? 0xC3 : 0xC2);
+            break;
+        case EJson::Number:
+            WriteNumber(Out, Value->AsNumber());
+            break;
+        case EJson::String:
+            WriteString(Out, Value->AsString());
+            break;
+        case EJson::Array:
+        {
+            const TArray<TSharedPtr<FJsonValue>>& Array = Value->AsArray();
+            WriteContainerHeader(Out, Array.Num(), 0x90, 0xDC);
+            for (const TSharedPtr<FJsonValue>& Element : Array)
+            {
+                WriteValue(Out, Element);
+            }
+            break;
+        }
+        case EJson::Object:
+            WriteObject(Out, *Value->AsObject());
+            break;
+        default:
+            Out.Add(0xC0);
+            break;
+        }
+    }
+
+    static void WriteObject(TArray<uint8>& Out, const FJsonObject& Object)
+    {
+        WriteContainerHeader(Out, Object.Values.Num(), 0x80, 0xDE);
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object.Values)
+        {
+            WriteString(Out, Field.Key);
+            WriteValue(Out, Field.Value);
+        }
+    }
+
+    /** Cursor over a payload being decoded */
+    struct FReader
+    {
+        const uint8* Data;
+        int32 NumBytes;
+        int32 Offset = 0;
+        FString Error;
+
+        bool Fail(const FString& Message)
+        {
+            if (Error.IsEmpty())
+            {
+                Error = FString::Printf(TEXT("%s at byte %d"), *Message, Offset);
+            }
+            return false;
+        }
+
+        bool ReadBigEndian(int32 Size, uint64& OutValue)
+        {
+            if (NumBytes - Offset < Size)
+            {
+                return Fail(TEXT("Unexpected end of data"));
+            }
+            OutValue = 0;
+            for (int32 Index = 0; Index < Size; ++Index)
+            {
+                OutValue = (OutValue << 8) | Data[Offset++];
+            }
+            return true;
+        }
+
+        bool ReadString(uint32 Length, FString& OutString)
+        {
+            if (static_cast<uint32>(NumBytes - Offset) < Length)
+            {
+                return Fail(TEXT("String runs past the end of data"));
+            }
+            FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data + Offset), Length);
+            OutString = FString(Converted.Length(), Converted.Get());
+            Offset += Length;
+            return true;
+        }
+
+        bool ReadKey(FString& OutKey)
+        {
+            if (Offset >= NumBytes)
+            {
+                return Fail(TEXT("Unexpected end of data"));
+            }
+            const uint8 Marker = Data[Offset++];
+            uint64 Length = 0;
+            if ((Marker & 0xE0) == 0xA0)
+            {
+                Length = Marker & 0x1F;
+            }
+            else if (Marker < 0xD9 || Marker > 0xDB || !ReadBigEndian(1 << (Marker - 0xD9), Length))
+            {
+                return Fail(TEXT("Map keys must be strings"));
+            }
+            return ReadString(static_cast<uint32>(Length), OutKey);
+        }
+
+        TSharedPtr<FJsonObject> ReadMap(uint64 Count, int32 Depth)
+        {
+            TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+            for (uint64 Index = 0; Index < Count; ++Index)
+            {
+                FString Key;
+                if (!ReadKey(Key))
+                {
+                    return nullptr;
+                }
+                TSharedPtr<FJsonValue> Value = ReadValue(Depth + 1);
+                if (!Value.IsValid())
+                {
+                    return nullptr;
+                }
+                Object->SetField(Key, Value);
+            }
+            return Object;
+        }
+
+        TSharedPtr<FJsonValue> ReadArray(uint64 Count, int32 Depth)
+        {
+            // Every element takes at least one byte, so a count larger than what's left is malformed
+            if (Count > static_cast<uint64>(NumBytes - Offset))
+            {
+                Fail(TEXT("Array runs past the end of data"));
+                return nullptr;
+            }
+
+            TArray<TSharedPtr<FJsonValue>> Array;
+            Array.Reserve(static_cast<int32>(Count));
+            for (uint64 Index = 0; Index < Count; ++Index)
+            {
+                TSharedPtr<FJsonValue> Element = ReadValue(Depth + 1);
+                if (!Element.IsValid())
+                {
+                    return nullptr;
+                }
+                Array.Add(Element);
+            }
+            return MakeShared<FJsonValueArray>(Array);
+        }
+
+        TSharedPtr<FJsonValue> ReadValue(int32 Depth)
+        {
+            if (Depth > MessagePackMaxDepth)
+            {
+                Fail(TEXT("Nesting too deep"));
+                return nullptr;
+            }
+            if (Offset >= NumBytes)
+            {
+                Fail(TEXT("Unexpected end of data"));
+                return nullptr;
+            }
+
+            const uint8 Marker = Data[Offset++];
+            uint64 Raw = 0;
+
+            // Fixed-size forms carry their value or length in the marker itself
+            if (Marker < 0x80)
+            {
+                return MakeShared<FJsonValueNumber>(Marker);
+            }
+            if (Marker >= 0xE0)
+            {
+                return MakeShared<FJsonValueNumber>(static_cast<int8>(Marker));
+            }
+            if ((Marker & 0xF0) == 0x80)
+            {
+                TSharedPtr<FJsonObject> Object = ReadMap(Marker & 0x0F, Depth);
+                return Object.IsValid() ? MakeShared<FJsonValueObject>(Object) : nullptr;
+            }
+            if ((Marker & 0xF0) == 0x90)
+            {
+                return ReadArray(Marker & 0x0F, Depth);
+            }
+            if ((Marker & 0xE0) == 0xA0)
+            {
+                FString String;
+                return ReadString(Marker & 0x1F, String) ? MakeShared<FJsonValueString>(String) : nullptr;
+            }
+
+            switch (Marker)
+            {
+            case 0xC0:
+                return MakeShared<FJsonValueNull>();
+            case 0xC2:
+                return MakeShared<FJsonValueBoolean>(false);
+            case 0xC3:
+                return MakeShared<FJsonValueBoolean>(true);
+            case 0xCA:
+            {
+                if (!ReadBigEndian(4, Raw))
+                {
+                    return nullptr;
+                }
+                const uint32 Bits = static_cast<uint32>(Raw);
+                float Value;
+                FMemory::Memcpy(&Value, &Bits, sizeof(Value));
+                return MakeShared<FJsonValueNumber>(Value);
+            }
+            case 0xCB:
+            {
+                if (!ReadBigEndian(8, Raw))
+                {
+                    return nullptr;
+                }
+                double Value;
+                FMemory::Memcpy(&Value, &Raw, sizeof(Value));
+                return MakeShared<FJsonValueNumber>(Value);
+            }
+            case 0xCC: case 0xCD: case 0xCE: case 0xCF:
+                if (!ReadBigEndian(1 << (Marker - 0xCC), Raw))
+                {
+                    return nullptr;
+                }
+                return MakeShared<FJsonValueNumber>(static_cast<double>(Raw));
+            case 0xD0: case 0xD1: case 0xD2: case 0xD3:
+            {
+                const int32 Size = 1 << (Marker - 0xD0);
+                if (!ReadBigEndian(Size, Raw))
+                {
+                    return nullptr;
+                }
+                // Sign extend from the encoded width
+                const int32 Unused = 64 - Size * 8;
+                const int64 Value = static_cast<int64>(Raw << Unused) >> Unused;
+                return MakeShared<FJsonValueNumber>(static_cast<double>(Value));
+            }
+            case 0xD9: case 0xDA: case 0xDB:
+            {
+                FString String;
+                if (!ReadBigEndian(1 << (Marker - 0xD9), Raw) || !ReadString(static_cast<uint32>(Raw), String))
+                {
+                    return nullptr;
+                }
+                return MakeShared<FJsonValueString>(String);
+            }
+            case 0xDC: case 0xDD:
+                if (!ReadBigEndian(Marker == 0xDC ? 2 : 4, Raw))
+                {
+                    return nullptr;
+                }
+                return ReadArray(Raw, Depth);
+            case 0xDE: case 0xDF:
+            {
+                if (!ReadBigEndian(Marker == 0xDE ? 2 : 4, Raw))
+                {
+                    return nullptr;
+                }
+                TSharedPtr<FJsonObject> Object = ReadMap(Raw, Depth);
+                return Object.IsValid() ? MakeShared<FJsonValueObject>(Object) : nullptr;
+            }
+            default:
+                // bin and ext have no JSON equivalent
+                Fail(FString::Printf(TEXT("Unsupported MessagePack type 0x%02X"), Marker));
+                return nullptr;
+            }
+        }
+    };
+}
+
+void FMCPMessagePack::Encode(const TSharedPtr<FJsonObject>& Object, TArray<uint8>& Out)
+{
+    if (!Object.IsValid())
+    {
+        Out.Add(0xC0);
+        return;
+    }
+    MCPMessagePack::WriteObject(Out, *Object);
+}
+
+TSharedPtr<FJsonObject> FMCPMessagePack::Decode(const uint8* Data, int32 NumBytes, FString& OutError)
+{
+    MCPMessagePack::FReader Reader{ Data, NumBytes };
+    TSharedPtr<FJsonValue> Value = Reader.ReadValue(0);
+    if (!Value.IsValid())
+    {
+        OutError = Reader.Error;
+        return nullptr;
+    }
+    if (Value->Type != EJson::Object)
+    {
+        OutError = TEXT("Message must be a MessagePack map");
+        return nullptr;
+    }
+    if (Reader.Offset != NumBytes)
+    {
+        OutError = FString::Printf(TEXT("%d trailing bytes after the message"), NumBytes - Reader.Offset);
+        return nullptr;
+    }
+    return Value->AsObject();
+}
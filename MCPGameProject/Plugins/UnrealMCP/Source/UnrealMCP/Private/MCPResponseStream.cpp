@@ -0,0 +1,172 @@
+#include "MCPResponseStream.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+
+FMCPResponseStream::FMCPResponseStream()
+    : ChunkEvent(FPlatformProcess::GetSynchEventFromPool(false))
+    , QueuedBytes(0)
+    , PeakQueuedBytes(0)
+    , TotalBytes(0)
+    , NumChunks(0)
+    , bFinished(false)
+    , bAbandoned(false)
+{
+}
+
+FMCPResponseStream::~FMCPResponseStream()
+{
+    FPlatformProcess::ReturnSynchEventToPool(ChunkEvent);
+}
+
+void FMCPResponseStream::PushChunk(TArray<uint8>&& Chunk)
+{
+    check(!bFinished);
+    const int64 ChunkBytes = Chunk.Num();
+    if (ChunkBytes == 0 || bAbandoned)
+    {
+        return;
+    }
+
+    const int64 NowQueued = QueuedBytes += ChunkBytes;
+    if (NowQueued > PeakQueuedBytes)
+    {
+        // Only the producer raises the peak, so a plain store is enough
+        PeakQueuedBytes = NowQueued;
+    }
+    TotalBytes += ChunkBytes;
+    ++NumChunks;
+
+    Chunks.Enqueue(MoveTemp(Chunk));
+    ChunkEvent->Trigger();
+}
+
+void FMCPResponseStream::Finish()
+{
+    bFinished = true;
+    ChunkEvent->Trigger();
+}
+
+bool FMCPResponseStream::PopChunk(TArray<uint8>& OutChunk)
+{
+    if (!Chunks.Dequeue(OutChunk))
+    {
+        return false;
+    }
+    QueuedBytes -= OutChunk.Num();
+    return true;
+}
+
+void FMCPResponseStream::Abandon()
+{
+    // Chunks already queued are freed with the stream
+    bAbandoned = true;
+}
+
+void FMCPResponseStream::Wait(FTimespan Timeout)
+{
+    ChunkEvent->Wait(Timeout);
+}
+
+FMCPResponseStreamArchive::FMCPResponseStreamArchive(FMCPResponseStream& InStream, int32 InChunkSize)
+    : Stream(InStream)
+    , ChunkSize(InChunkSize)
+    , PendingHighSurrogate(0)
+{
+    SetIsSaving(true);
+    Chunk.Reserve(ChunkSize);
+}
+
+void FMCPResponseStreamArchive::Serialize(void* Data, int64 Num)
+{
+    // The client is gone, don't spend time encoding what nobody will read
+    if (Stream.IsAbandoned())
+    {
+        return;
+    }
+
+    // TJsonWriter prints TCHARs a character or a string at a time
+    const TCHAR* Chars = static_cast<const TCHAR*>(Data);
+    const int64 NumChars = Num / sizeof(TCHAR);
+    for (int64 Index = 0; Index < NumChars; ++Index)
+    {
+        const uint32 Char = (uint32)Chars[Index];
+        if (sizeof(TCHAR) == 2 && Char >= 0xD800 && Char <= 0xDBFF)
+        {
+            PendingHighSurrogate = Char;
+            continue;
+        }
+        if (sizeof(TCHAR) == 2 && Char >= 0xDC00 && Char <= 0xDFFF)
+        {
+            AppendCodePoint(PendingHighSurrogate ? 0x10000 + ((PendingHighSurrogate - 0xD800) << 10) + (Char - 0xDC00) : 0xFFFD);
+            PendingHighSurrogate = 0;
+            continue;
+        }
+        if (PendingHighSurrogate)
+        {
+            // A lone high surrogate can't be encoded
+            AppendCodePoint(0xFFFD);
+            PendingHighSurrogate = 0;
+        }
+        AppendCodePoint(Char);
+    }
+}
+
+void FMCPResponseStreamArchive::AppendCodePoint(uint32 CodePoint)
+{
+    if (CodePoint > 0x10FFFF)
+    {
+        CodePoint = 0xFFFD;
+    }
+
+    uint8 Bytes[4];
+    int32 NumBytes;
+    if (CodePoint < 0x80)
+    {
+        Bytes[0] = (uint8)CodePoint;
+        NumBytes = 1;
+    }
+    else if (CodePoint < 0x800)
+    {
+        Bytes[0] = (uint8)(0xC0 | (CodePoint >> 6));
+        Bytes[1] = (uint8)(0x80 | (CodePoint & 0x3F));
+        NumBytes = 2;
+    }
+    else if (CodePoint < 0x10000)
+    {
+        Bytes[0] = (uint8)(0xE0 | (CodePoint >> 12));
+        Bytes[1] = (uint8)(0x80 | ((CodePoint >> 6) & 0x3F));
+        Bytes[2] = (uint8)(0x80 | (CodePoint & 0x3F));
+        NumBytes = 3;
+    }
+    else
+    {
+        Bytes[0] = (uint8)(0xF0 | (CodePoint >> 18));
+        Bytes[1] = (uint8)(0x80 | ((CodePoint >> 12) & 0x3F));
+        Bytes[2] = (uint8)(0x80 | ((CodePoint >> 6) & 0x3F));
+        Bytes[3] = (uint8)(0x80 | (CodePoint & 0x3F));
+        NumBytes = 4;
+    }
+
+    // Chunks may run a few bytes short so a character is never split between two of them
+    if (Chunk.Num() + NumBytes > ChunkSize)
+    {
+        Stream.PushChunk(MoveTemp(Chunk));
+        Chunk.Reset(ChunkSize);
+    }
+    Chunk.Append(Bytes, NumBytes);
+}
+
+void FMCPResponseStreamArchive::Finish()
+{
+    if (PendingHighSurrogate)
+    {
+        AppendCodePoint(0xFFFD);
+        PendingHighSurrogate = 0;
+    }
+
+    // Responses are newline terminated so clients can read them off a persistent connection
+    AppendCodePoint('\n');
+    Stream.PushChunk(MoveTemp(Chunk));
+    Chunk.Empty();
+    Stream.Finish();
+}
@@ -1,5 +1,6 @@
 #include "UnrealMCPBridge.h"
 #include "MCPServerRunnable.h"
+#include "UnrealMCPSettings.h"
 #include "Sockets.h"
 #include "SocketSubsystem.h"
 #include "HAL/RunnableThread.h"
@@ -22,6 +23,9 @@
 #include "Engine/Selection.h"
 #include "Kismet/GameplayStatics.h"
 #include "Async/Async.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+#include "Templates/UnrealTemplate.h"
 // Add Blueprint related includes
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
@@ -56,12 +60,46 @@
 #include "Commands/UnrealMCPBlueprintNodeCommands.h"
 #include "Commands/UnrealMCPProjectCommands.h"
 #include "Commands/UnrealMCPCommonUtils.h"
+#include "Commands/UnrealMCPBlueprintCache.h"
+#include "Commands/UnrealMCPBlueprintIndex.h"
+#include "Commands/UnrealMCPGraphIndex.h"
+#include "Commands/UnrealMCPCompileScheduler.h"
 #include "Commands/UnrealMCPUMGCommands.h"
+#include "Commands/UnrealMCPLevelJournal.h"
 
 // Default settings
 #define MCP_SERVER_HOST "127.0.0.1"
 #define MCP_SERVER_PORT 55557
 
+// State of a batch command that may be spread over several frames
+struct FMCPBatchState
+{
+    TArray<TSharedPtr<FJsonValue>> Commands;
+    bool bStopOnError = true;
+    int32 NextIndex = 0;
+    bool bStopped = false;
+
+    // Result of each executed entry for later references, invalid where the entry failed
+    TArray<TSharedPtr<FJsonValue>> EntryResults;
+    TArray<TSharedPtr<FJsonValue>> Responses;
+    int32 FailedCount = 0;
+
+    // Blueprints edited by the batch compile once it ends rather than after each entry
+    bool bHoldingCompiles = false;
+    TArray<TWeakObjectPtr<UBlueprint>> RequestedCompiles;
+    int32 CompiledCount = 0;
+
+    ~FMCPBatchState()
+    {
+        if (bHoldingCompiles)
+        {
+            FUnrealMCPCompileScheduler::Get().ReleaseHold();
+        }
+    }
+
+    bool IsFinished() const { return bStopped || NextIndex >= Commands.Num(); }
+};
+
 UUnrealMCPBridge::UUnrealMCPBridge()
 {
     EditorCommands = MakeShared<FUnrealMCPEditorCommands>();
@@ -69,6 +107,8 @@ UUnrealMCPBridge::UUnrealMCPBridge()
     BlueprintNodeCommands = MakeShared<FUnrealMCPBlueprintNodeCommands>();
     ProjectCommands = MakeShared<FUnrealMCPProjectCommands>();
     UMGCommands = MakeShared<FUnrealMCPUMGCommands>();
+
+    RegisterCommands();
 }
 
 UUnrealMCPBridge::~UUnrealMCPBridge()
@@ -80,6 +120,25 @@ UUnrealMCPBridge::~UUnrealMCPBridge()
     UMGCommands.Reset();
 }
 
+// Build the dispatch table from the bridge's own commands and every command handler class
+void UUnrealMCPBridge::RegisterCommands()
+{
+    const FString Category = TEXT("server");
+    const EMCPCommandFlags Introspection = EMCPCommandFlags::ReadOnly | EMCPCommandFlags::AnyThread;
+    CommandRegistry.Register(TEXT("ping"), Category, TEXT("Check that the server is responding, echoing an optional 'echo' string"), this, &UUnrealMCPBridge::HandlePing, Introspection);
+    CommandRegistry.Register(TEXT("batch"), Category, TEXT("Run an ordered list of commands in one request, spread over frames when it exceeds the game thread budget"), this, &UUnrealMCPBridge::HandleBatch);
+    CommandRegistry.Register(TEXT("list_commands"), Category, TEXT("List the available commands, optionally filtered by category"), this, &UUnrealMCPBridge::HandleListCommands, Introspection);
+    CommandRegistry.Register(TEXT("get_queue_stats"), Category, TEXT("Report game thread command queue depth, wait times and frame budget usage"), this, &UUnrealMCPBridge::HandleGetQueueStats, Introspection);
+    CommandRegistry.Register(TEXT("subscribe"), Category, TEXT("Push coalesced notifications of actor changes, blueprint compiles, asset saves and PIE sessions to this connection"), this, &UUnrealMCPBridge::HandleSubscribe);
+    CommandRegistry.Register(TEXT("unsubscribe"), Category, TEXT("Stop one or all of this connection's event subscriptions"), this, &UUnrealMCPBridge::HandleUnsubscribe);
+
+    EditorCommands->RegisterCommands(CommandRegistry);
+    BlueprintCommands->RegisterCommands(CommandRegistry);
+    BlueprintNodeCommands->RegisterCommands(CommandRegistry);
+    ProjectCommands->RegisterCommands(CommandRegistry);
+    UMGCommands->RegisterCommands(CommandRegistry);
+}
+
 // Initialize subsystem
 void UUnrealMCPBridge::Initialize(FSubsystemCollectionBase& Collection)
 {
@@ -140,20 +199,37 @@ void UUnrealMCPBridge::StartServer()
         return;
     }
 
+    // Settings are UObjects, so snapshot them here rather than reading them from the server thread
+    const UUnrealMCPSettings* Settings = GetDefault<UUnrealMCPSettings>();
+    FMCPServerConfig Config;
+    Config.MaxMessageSize = FMath::Clamp(Settings->MaxMessageSizeMB, 1, 2047) * 1024 * 1024;
+    Config.SendTimeoutSeconds = FMath::Max(Settings->SendTimeoutSeconds, 1.0f);
+    Config.MaxConnections = FMath::Clamp(Settings->MaxConnections, 1, 64);
+
     // Start listening
-    if (!NewListenerSocket->Listen(5))
+    if (!NewListenerSocket->Listen(Config.MaxConnections))
     {
         UE_LOG(LogTemp, Error, TEXT("UnrealMCPBridge: Failed to start listening"));
         return;
     }
 
+    // Commands from every connection are drained from one queue within the per-frame budget
+    {
+        FScopeLock QueueLock(&CommandQueueLock);
+        CommandQueue = MakeUnique<FMCPCommandQueue>(FMath::Clamp(Settings->GameThreadBudgetMs, 0.5f, 100.0f));
+        CommandQueue->Start();
+    }
+    EventHub = MakeUnique<FMCPEventHub>(EditorCommands, FMath::Clamp(Settings->MaxEventRate, 0.1f, 120.0f));
+    FUnrealMCPCompileScheduler::Get().SetIdleDelay(FMath::Clamp(Settings->BlueprintCompileDelaySeconds, 0.0f, 60.0f));
+
     ListenerSocket = NewListenerSocket;
     bIsRunning = true;
     UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Server started on %s:%d"), *ServerAddress.ToString(), Port);
 
     // Start server thread
+    ServerRunnable = MakeUnique<FMCPServerRunnable>(this, ListenerSocket, Config);
     ServerThread = FRunnableThread::Create(
-        new FMCPServerRunnable(this, ListenerSocket),
+        ServerRunnable.Get(),
         TEXT("UnrealMCPServerThread"),
         0, TPri_Normal
     );
@@ -183,6 +259,30 @@ void UUnrealMCPBridge::StopServer()
         delete ServerThread;
         ServerThread = nullptr;
     }
+    ServerRunnable.Reset();
+
+    // Every connection has exited, so nothing can enqueue any more. Anything still queued is answered with an error.
+    // get_queue_stats may still be reading the queue from another thread, so it is detached under the lock.
+    TUniquePtr<FMCPCommandQueue> StoppedQueue;
+    {
+        FScopeLock QueueLock(&CommandQueueLock);
+        StoppedQueue = MoveTemp(CommandQueue);
+    }
+    if (StoppedQueue.IsValid())
+    {
+        StoppedQueue->Stop();
+        StoppedQueue.Reset();
+    }
+    EventHub.Reset();
+
+    // Don't leave edits uncompiled, unless the editor is on its way out anyway
+    if (!IsEngineExitRequested())
+    {
+        FUnrealMCPCompileScheduler::Get().FlushAll();
+    }
+    FUnrealMCPBlueprintCache::Get().Reset();
+    FUnrealMCPBlueprintIndex::Get().Reset();
+    FUnrealMCPGraphIndex::Get().Reset();
 
     // Close sockets
     if (ConnectionSocket.IsValid())
@@ -200,153 +300,631 @@ void UUnrealMCPBridge::StopServer()
     UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Server stopped"));
 }
 
-// Execute a command received from a client
-FString UUnrealMCPBridge::ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+// Build an error response envelope
+static TSharedPtr<FJsonObject> MakeErrorEnvelope(const FString& Message)
 {
-    UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Executing command: %s"), *CommandType);
+    TSharedPtr<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+    ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
+    ResponseJson->SetStringField(TEXT("error"), Message);
+    return ResponseJson;
+}
+
+// Wrap a handler result in a response envelope, using its success field to pick the status
+static TSharedPtr<FJsonObject> MakeResponseEnvelope(const TSharedPtr<FJsonObject>& ResultJson)
+{
+    bool bSuccess = true;
+    FString ErrorMessage;
     
-    // Create a promise to wait for the result
-    TPromise<FString> Promise;
-    TFuture<FString> Future = Promise.GetFuture();
+    if (ResultJson->HasField(TEXT("success")))
+    {
+        bSuccess = ResultJson->GetBoolField(TEXT("success"));
+        if (!bSuccess && ResultJson->HasField(TEXT("error")))
+        {
+            ErrorMessage = ResultJson->GetStringField(TEXT("error"));
+        }
+    }
     
-    // Queue execution on Game Thread
-    AsyncTask(ENamedThreads::GameThread, [this, CommandType, Params, Promise = MoveTemp(Promise)]() mutable
+    if (!bSuccess)
     {
-        TSharedPtr<FJsonObject> ResponseJson = MakeShareable(new FJsonObject);
-        
-        try
+        return MakeErrorEnvelope(ErrorMessage);
+    }
+
+    TSharedPtr<FJsonObject> ResponseJson = MakeShared<FJsonObject>();
+    ResponseJson->SetStringField(TEXT("status"), TEXT("success"));
+    ResponseJson->SetObjectField(TEXT("result"), ResultJson);
+    return ResponseJson;
+}
+
+// Blueprint edits wait for the compile scheduler unless the request sets "defer_compile": false
+static bool ShouldDeferCompiles(const TSharedPtr<FJsonObject>& Params)
+{
+    bool bDefer = true;
+    if (Params.IsValid())
+    {
+        Params->TryGetBoolField(TEXT("defer_compile"), bDefer);
+    }
+    return bDefer;
+}
+
+// Whether a command name routes to batch, which the registry matches ignoring case like any FName
+static bool IsBatchCommand(const FString& CommandType)
+{
+    return CommandType.Equals(TEXT("batch"), ESearchCase::IgnoreCase);
+}
+
+// Collect the assets a command names, so the queue keeps work on the same asset in order.
+// A batch names everything its entries do. Batch references ("$0.name") aren't known yet and are skipped.
+static void CollectOrderingKeys(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, TArray<FString>& OutKeys)
+{
+    if (!Params.IsValid())
+    {
+        return;
+    }
+
+    if (IsBatchCommand(CommandType))
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Commands = nullptr;
+        if (Params->TryGetArrayField(TEXT("commands"), Commands))
         {
-            TSharedPtr<FJsonObject> ResultJson;
-            
-            if (CommandType == TEXT("ping"))
+            for (const TSharedPtr<FJsonValue>& EntryValue : *Commands)
             {
-                ResultJson = MakeShareable(new FJsonObject);
-                ResultJson->SetStringField(TEXT("message"), TEXT("pong"));
-            }
-            // Editor Commands (including actor manipulation)
-            else if (CommandType == TEXT("get_actors_in_level") || 
-                     CommandType == TEXT("find_actors_by_name") ||
-                     CommandType == TEXT("spawn_actor") ||
-                     CommandType == TEXT("create_actor") ||
-                     CommandType == TEXT("delete_actor") || 
-                     CommandType == TEXT("set_actor_transform") ||
-                     CommandType == TEXT("get_actor_properties") ||
-                     CommandType == TEXT("set_actor_property") ||
-                     CommandType == TEXT("spawn_blueprint_actor") ||
-                     CommandType == TEXT("focus_viewport") || 
-                     CommandType == TEXT("take_screenshot"))
-            {
-                ResultJson = EditorCommands->HandleCommand(CommandType, Params);
-            }
-            // Blueprint Commands
-            else if (CommandType == TEXT("create_blueprint") || 
-                     CommandType == TEXT("add_component_to_blueprint") || 
-                     CommandType == TEXT("set_component_property") || 
-                     CommandType == TEXT("set_physics_properties") || 
-                     CommandType == TEXT("compile_blueprint") || 
-                     CommandType == TEXT("set_blueprint_property") || 
-                     CommandType == TEXT("set_static_mesh_properties") ||
-                     CommandType == TEXT("set_pawn_properties") ||
-                     CommandType == TEXT("add_function_to_blueprint")
-                     )
-            {
-                ResultJson = BlueprintCommands->HandleCommand(CommandType, Params);
-            }
-            // Blueprint Node Commands
-            else if (   CommandType == TEXT("connect_blueprint_nodes") || 
-                        CommandType == TEXT("add_blueprint_get_self_component_reference") ||
-                        CommandType == TEXT("add_blueprint_self_reference") ||
-                        CommandType == TEXT("find_blueprint_nodes") ||
-                        CommandType == TEXT("add_blueprint_input_action_node") ||
-                        // CommandType == TEXT("add_blueprint_function_node") ||
-                        CommandType == TEXT("add_blueprint_get_component_node") ||
-                        CommandType == TEXT("add_blueprint_member_variable") ||
-                        CommandType == TEXT("add_blueprint_local_variable") ||
-                        
-                        CommandType == TEXT("add_event_node") ||
-                        CommandType == TEXT("add_function_call_node") ||
-                        CommandType == TEXT("add_math_node") ||
-                        CommandType == TEXT("add_control_node") ||
-                        CommandType == TEXT("add_sequence_node") ||
-                        CommandType == TEXT("add_select_node") ||
-                        CommandType == TEXT("add_enum_switch_node") ||
-                        CommandType == TEXT("add_make_struct_node") ||
-                        CommandType == TEXT("add_break_struct_node") ||
-                        CommandType == TEXT("find_event_node_by_name") ||
-                        CommandType == TEXT("get_node_pins") ||
-                        CommandType == TEXT("set_node_pin_default_value") ||
-                        CommandType == TEXT("get_all_nodes") ||
-                        CommandType == TEXT("add_variable_get_node") ||
-                        CommandType == TEXT("add_variable_set_node") ||
-                        CommandType == TEXT("add_component_node") 
-                        )
-            {
-                ResultJson = BlueprintNodeCommands->HandleCommand(CommandType, Params);
+                const TSharedPtr<FJsonObject>* Entry = nullptr;
+                const TSharedPtr<FJsonObject>* EntryParams = nullptr;
+                FString EntryType;
+                if (EntryValue->TryGetObject(Entry) && (*Entry)->TryGetObjectField(TEXT("params"), EntryParams))
+                {
+                    if (!(*Entry)->TryGetStringField(TEXT("type"), EntryType))
+                    {
+                        (*Entry)->TryGetStringField(TEXT("command"), EntryType);
+                    }
+                    CollectOrderingKeys(EntryType, *EntryParams, OutKeys);
+                }
             }
-            // Project Commands
-            else if (CommandType == TEXT("create_input_mapping"))
+        }
+        return;
+    }
+
+    for (const TCHAR* Field : { TEXT("blueprint_name"), TEXT("name") })
+    {
+        FString Value;
+        if (Params->TryGetStringField(Field, Value) && !Value.IsEmpty() && !Value.StartsWith(TEXT("$")))
+        {
+            OutKeys.AddUnique(Value.ToLower());
+        }
+    }
+}
+
+// Read a batch's parameters into its execution state
+static bool InitBatch(const TSharedPtr<FJsonObject>& Params, FMCPBatchState& State, FString& OutError)
+{
+    const TArray<TSharedPtr<FJsonValue>>* Commands = nullptr;
+    if (!Params->TryGetArrayField(TEXT("commands"), Commands))
+    {
+        OutError = TEXT("Missing 'commands' array parameter");
+        return false;
+    }
+
+    State.Commands = *Commands;
+    Params->TryGetBoolField(TEXT("stop_on_error"), State.bStopOnError);
+    return true;
+}
+
+// Summarize the entries a batch has executed
+static TSharedPtr<FJsonObject> MakeBatchResult(const FMCPBatchState& State)
+{
+    TSharedPtr<FJsonObject> ResultJson = MakeShared<FJsonObject>();
+    ResultJson->SetArrayField(TEXT("results"), State.Responses);
+    ResultJson->SetNumberField(TEXT("executed"), State.Responses.Num());
+    ResultJson->SetNumberField(TEXT("failed"), State.FailedCount);
+    ResultJson->SetBoolField(TEXT("completed"), State.Responses.Num() == State.Commands.Num());
+    ResultJson->SetNumberField(TEXT("compiled_blueprints"), State.CompiledCount);
+    return ResultJson;
+}
+
+// Queue a command for the game thread without waiting for it
+void UUnrealMCPBridge::ExecuteCommandAsync(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FMCPCommandCallback OnComplete,
+    EMCPCommandPriority Priority, const FString& OrderingKey, TSharedPtr<IMCPEventSink> EventSink, FMCPStreamCallback OnStream)
+{
+    UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Executing command: %s"), *CommandType);
+
+    if (!CommandQueue.IsValid())
+    {
+        OnComplete(MakeErrorEnvelope(TEXT("Server is not running")));
+        return;
+    }
+
+    const bool bIsBatch = IsBatchCommand(CommandType);
+    if (Priority == EMCPCommandPriority::Default)
+    {
+        Priority = bIsBatch ? EMCPCommandPriority::Bulk : EMCPCommandPriority::Interactive;
+    }
+
+    TArray<FString> OrderingKeys;
+    if (!OrderingKey.IsEmpty())
+    {
+        OrderingKeys.Add(OrderingKey);
+    }
+    CollectOrderingKeys(CommandType, Params, OrderingKeys);
+
+    // Exactly one of the step and cancel callbacks below ends up calling it
+    TSharedRef<FMCPCommandCallback> Callback = MakeShared<FMCPCommandCallback>(MoveTemp(OnComplete));
+    TUniqueFunction<void()> OnCancel = [Callback]()
+    {
+        (*Callback)(MakeErrorEnvelope(TEXT("Server stopped before the command could run")));
+    };
+
+    // Batches run entry by entry so a long one yields to the editor between frames instead of stalling it
+    TSharedPtr<FMCPBatchState> Batch;
+    FString BatchError;
+    if (bIsBatch && Params.IsValid())
+    {
+        Batch = MakeShared<FMCPBatchState>();
+        if (!InitBatch(Params, *Batch, BatchError))
+        {
+            Batch.Reset();
+        }
+    }
+
+    if (Batch.IsValid())
+    {
+        CommandQueue->Enqueue(Priority, OrderingKeys, [this, Batch, Callback, EventSink](double DeadlineSeconds)
+        {
+            TGuardValue<TSharedPtr<IMCPEventSink>> SinkGuard(CurrentEventSink, EventSink);
+            if (!StepBatch(*Batch, DeadlineSeconds))
             {
-                ResultJson = ProjectCommands->HandleCommand(CommandType, Params);
+                return false;
             }
-            // UMG Commands
-            else if (CommandType == TEXT("create_umg_widget_blueprint") ||
-                     CommandType == TEXT("add_text_block_to_widget") ||
-                     CommandType == TEXT("add_button_to_widget") ||
-                     CommandType == TEXT("bind_widget_event") ||
-                     CommandType == TEXT("set_text_block_binding") ||
-                     CommandType == TEXT("add_widget_to_viewport"))
+            (*Callback)(MakeResponseEnvelope(MakeBatchResult(*Batch)));
+            return true;
+        }, MoveTemp(OnCancel));
+        return;
+    }
+
+    CommandQueue->Enqueue(Priority, OrderingKeys, [this, CommandType, Params, Callback, EventSink, OnStream = MoveTemp(OnStream)](double DeadlineSeconds) mutable
+    {
+        TGuardValue<TSharedPtr<IMCPEventSink>> SinkGuard(CurrentEventSink, EventSink);
+        if (OnStream && DispatchStreamingCommand(CommandType, Params, *Callback, OnStream))
+        {
+            return true;
+        }
+        (*Callback)(DispatchCommand(CommandType, Params));
+        return true;
+    }, MoveTemp(OnCancel));
+}
+
+bool UUnrealMCPBridge::CanExecuteOnAnyThread(const FString& CommandType) const
+{
+    const FMCPCommandInfo* Command = CommandRegistry.Find(CommandType);
+    return Command && Command->CanRunOnAnyThread();
+}
+
+// Answer a command on the calling thread, skipping the game thread queue
+TSharedPtr<FJsonObject> UUnrealMCPBridge::ExecuteCommandOnCallingThread(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+    checkf(CanExecuteOnAnyThread(CommandType), TEXT("%s must run on the game thread"), *CommandType);
+    return DispatchCommand(CommandType, Params);
+}
+
+// Route a command to its handler and wrap the result in a response envelope.
+// Must run on the game thread unless the command is registered as AnyThread.
+TSharedPtr<FJsonObject> UUnrealMCPBridge::DispatchCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params)
+{
+    try
+    {
+        // O(1) lookup in the dispatch table built by RegisterCommands
+        const FMCPCommandInfo* Command = CommandRegistry.Find(CommandType);
+        if (!Command)
+        {
+            return MakeErrorEnvelope(FString::Printf(TEXT("Unknown command: %s"), *CommandType));
+        }
+
+        check(IsInGameThread() || Command->CanRunOnAnyThread());
+        FUnrealMCPCompileScheduler::FScopedImmediate ImmediateCompiles(IsInGameThread() && !ShouldDeferCompiles(Params));
+        return MakeResponseEnvelope(Command->Handler(Params));
+    }
+    catch (const std::exception& e)
+    {
+        return MakeErrorEnvelope(UTF8_TO_TCHAR(e.what()));
+    }
+}
+
+// Write a command's result straight into a response stream instead of building it as an object first
+bool UUnrealMCPBridge::DispatchStreamingCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FMCPCommandCallback& OnComplete,
+    FMCPStreamCallback& OnStream)
+{
+    const FMCPCommandInfo* Command = CommandRegistry.Find(CommandType);
+    if (!Command || !Command->StreamingHandler)
+    {
+        return false;
+    }
+
+    FUnrealMCPCompileScheduler::FScopedImmediate ImmediateCompiles(!ShouldDeferCompiles(Params));
+
+    // Errors, and anything else the handler chose to build itself, go out as ordinary responses
+    FMCPResultWriter WriteResult;
+    TSharedPtr<FJsonObject> ResultJson = Command->StreamingHandler(Params, WriteResult);
+    if (ResultJson.IsValid() || !WriteResult)
+    {
+        OnComplete(MakeResponseEnvelope(ResultJson.IsValid() ? ResultJson : MakeShared<FJsonObject>()));
+        return true;
+    }
+
+    // The connection queues the stream first, so it can start sending as soon as the first chunk fills
+    TSharedRef<FMCPResponseStream> Stream = MakeShared<FMCPResponseStream>();
+    OnStream(Stream);
+
+    FMCPResponseStreamArchive Archive(*Stream);
+    TSharedRef<FMCPJsonWriter> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Archive);
+    Writer->WriteObjectStart();
+    if (Stream->GetRequestId().IsValid())
+    {
+        FJsonSerializer::Serialize(Stream->GetRequestId(), TEXT("id"), Writer, false);
+    }
+    Writer->WriteValue(TEXT("status"), TEXT("success"));
+    Writer->WriteObjectStart(TEXT("result"));
+    WriteResult.WriteText(*Writer);
+    Writer->WriteObjectEnd();
+    Writer->WriteObjectEnd();
+    Writer->Close();
+    Archive.Finish();
+
+    if (Stream->IsAbandoned())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UnrealMCPBridge: Stopped streaming %s response after %lld bytes, the connection closed"),
+               *CommandType, Stream->GetTotalBytes());
+        return true;
+    }
+    UE_LOG(LogTemp, Display, TEXT("UnrealMCPBridge: Streamed %s response, %lld bytes in %d chunks, at most %lld bytes queued"),
+           *CommandType, Stream->GetTotalBytes(), Stream->GetNumChunks(), Stream->GetPeakQueuedBytes());
+    if (Stream->GetPeakQueuedBytes() > MCPResponseStreamWarnQueuedBytes)
+    {
+        // The game thread never waits on a client, so a slow one shows up here as memory instead
+        UE_LOG(LogTemp, Warning, TEXT("UnrealMCPBridge: The client fell %lld bytes behind the %s response, consider \"stream\": false or smaller pages"),
+               Stream->GetPeakQueuedBytes(), *CommandType);
+    }
+    return true;
+}
+
+// Report that the server is alive
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandlePing(const TSharedPtr<FJsonObject>& Params)
+{
+    TSharedPtr<FJsonObject> ResultJson = MakeShareable(new FJsonObject);
+    ResultJson->SetStringField(TEXT("message"), TEXT("pong"));
+
+    // Echo back an optional payload, used to exercise large round trips
+    FString Echo;
+    if (Params->TryGetStringField(TEXT("echo"), Echo))
+    {
+        ResultJson->SetStringField(TEXT("echo"), Echo);
+    }
+    return ResultJson;
+}
+
+// Enumerate the registered commands
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleListCommands(const TSharedPtr<FJsonObject>& Params)
+{
+    FString CategoryFilter;
+    Params->TryGetStringField(TEXT("category"), CategoryFilter);
+
+    TArray<TSharedPtr<FJsonValue>> CommandArray;
+    for (const FMCPCommandInfo* Command : CommandRegistry.GetCommands())
+    {
+        if (!CategoryFilter.IsEmpty() && Command->Category != CategoryFilter)
+        {
+            continue;
+        }
+
+        TSharedPtr<FJsonObject> CommandJson = MakeShared<FJsonObject>();
+        CommandJson->SetStringField(TEXT("name"), Command->Name.ToString());
+        CommandJson->SetStringField(TEXT("category"), Command->Category);
+        CommandJson->SetStringField(TEXT("description"), Command->Description);
+        CommandJson->SetBoolField(TEXT("read_only"), Command->IsReadOnly());
+        CommandJson->SetStringField(TEXT("thread"), Command->CanRunOnAnyThread() ? TEXT("any") : TEXT("game"));
+        CommandArray.Add(MakeShared<FJsonValueObject>(CommandJson));
+    }
+
+    TSharedPtr<FJsonObject> ResultJson = MakeShared<FJsonObject>();
+    ResultJson->SetArrayField(TEXT("commands"), CommandArray);
+    ResultJson->SetNumberField(TEXT("count"), CommandArray.Num());
+    return ResultJson;
+}
+
+// Report how the game thread command queue is keeping up
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleGetQueueStats(const TSharedPtr<FJsonObject>& Params)
+{
+    // Runs on any thread, the lock keeps StopServer from destroying the queue mid-read
+    FMCPCommandQueueStats Stats;
+    {
+        FScopeLock QueueLock(&CommandQueueLock);
+        if (!CommandQueue.IsValid())
+        {
+            return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("Server is not running"));
+        }
+        Stats = CommandQueue->GetStats();
+    }
+
+    TSharedPtr<FJsonObject> ResultJson = MakeShared<FJsonObject>();
+    ResultJson->SetNumberField(TEXT("interactive_depth"), Stats.InteractiveDepth);
+    ResultJson->SetNumberField(TEXT("bulk_depth"), Stats.BulkDepth);
+    ResultJson->SetNumberField(TEXT("peak_depth"), Stats.PeakDepth);
+    ResultJson->SetNumberField(TEXT("executed"), Stats.Executed);
+    ResultJson->SetNumberField(TEXT("budget_exhausted_frames"), Stats.BudgetExhaustedFrames);
+    ResultJson->SetNumberField(TEXT("average_wait_ms"), Stats.AverageWaitMs);
+    ResultJson->SetNumberField(TEXT("max_wait_ms"), Stats.MaxWaitMs);
+    ResultJson->SetNumberField(TEXT("last_frame_ms"), Stats.LastFrameMs);
+    ResultJson->SetNumberField(TEXT("budget_ms"), Stats.BudgetMs);
+    return ResultJson;
+}
+
+// Start pushing editor events to the connection that sent the command
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleSubscribe(const TSharedPtr<FJsonObject>& Params)
+{
+    if (!EventHub.IsValid() || !CurrentEventSink.IsValid())
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("subscribe must be sent over a client connection"));
+    }
+
+    EMCPEventStreams Streams = EMCPEventStreams::All;
+    FString Error;
+    const TArray<TSharedPtr<FJsonValue>>* StreamNames = nullptr;
+    if (Params->TryGetArrayField(TEXT("events"), StreamNames) && !FMCPEventHub::ParseStreams(*StreamNames, Streams, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+    if (Streams == EMCPEventStreams::None)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("'events' must name at least one event stream"));
+    }
+
+    EMCPActorFields ActorFields;
+    if (!FUnrealMCPCommonUtils::ParseActorFields(Params, ActorFields, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+
+    double Rate = EventHub->GetMaxRate();
+    Params->TryGetNumberField(TEXT("max_rate"), Rate);
+    if (Rate <= 0.0)
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("'max_rate' must be positive"));
+    }
+    Rate = FMath::Min(Rate, (double)EventHub->GetMaxRate());
+
+    const int32 SubscriptionId = EventHub->Subscribe(CurrentEventSink.ToSharedRef(), Streams, (float)Rate, ActorFields);
+
+    TSharedPtr<FJsonObject> ResultJson = MakeShared<FJsonObject>();
+    ResultJson->SetNumberField(TEXT("subscription"), SubscriptionId);
+    ResultJson->SetArrayField(TEXT("events"), FMCPEventHub::StreamsToJson(Streams));
+    ResultJson->SetNumberField(TEXT("max_rate"), Rate);
+    if (EnumHasAnyFlags(Streams, EMCPEventStreams::Actors))
+    {
+        // Actor notifications continue from here, the same position get_level_changes_since would
+        const FUnrealMCPLevelJournal& Journal = EditorCommands->GetLevelJournal();
+        ResultJson->SetStringField(TEXT("journal"), Journal.GetJournalId());
+        ResultJson->SetNumberField(TEXT("version"), (double)Journal.GetVersion());
+    }
+    return ResultJson;
+}
+
+// Stop pushing events to the connection that sent the command
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleUnsubscribe(const TSharedPtr<FJsonObject>& Params)
+{
+    if (!EventHub.IsValid() || !CurrentEventSink.IsValid())
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(TEXT("unsubscribe must be sent over a client connection"));
+    }
+
+    const int32 ConnectionId = CurrentEventSink->GetConnectionId();
+    int32 Removed = 0;
+    double SubscriptionId = 0.0;
+    if (Params->TryGetNumberField(TEXT("subscription"), SubscriptionId))
+    {
+        if (!EventHub->Unsubscribe(ConnectionId, (int32)SubscriptionId))
+        {
+            return FUnrealMCPCommonUtils::CreateErrorResponse(FString::Printf(TEXT("This connection has no subscription %d"), (int32)SubscriptionId));
+        }
+        Removed = 1;
+    }
+    else
+    {
+        Removed = EventHub->UnsubscribeAll(ConnectionId);
+    }
+
+    TSharedPtr<FJsonObject> ResultJson = MakeShared<FJsonObject>();
+    ResultJson->SetNumberField(TEXT("unsubscribed"), Removed);
+    return ResultJson;
+}
+
+// Resolve a dotted path such as "node_id" or "nodes.0.id" inside an earlier batch result
+static TSharedPtr<FJsonValue> ResolveBatchPath(const TSharedPtr<FJsonValue>& Root, const FString& Path)
+{
+    TArray<FString> Segments;
+    Path.ParseIntoArray(Segments, TEXT("."));
+
+    TSharedPtr<FJsonValue> Current = Root;
+    for (const FString& Segment : Segments)
+    {
+        if (!Current.IsValid())
+        {
+            return nullptr;
+        }
+
+        if (Current->Type == EJson::Object)
+        {
+            Current = Current->AsObject()->TryGetField(Segment);
+        }
+        else if (Current->Type == EJson::Array && Segment.IsNumeric())
+        {
+            const TArray<TSharedPtr<FJsonValue>>& Array = Current->AsArray();
+            const int32 ArrayIndex = FCString::Atoi(*Segment);
+            Current = Array.IsValidIndex(ArrayIndex) ? Array[ArrayIndex] : nullptr;
+        }
+        else
+        {
+            return nullptr;
+        }
+    }
+    return Current;
+}
+
+// Copy a batch entry's parameters, replacing "$<index>.<path>" strings with values from earlier results.
+// A leading "$$" escapes a literal string that would otherwise look like a reference.
+static TSharedPtr<FJsonValue> ResolveBatchReferences(const TSharedPtr<FJsonValue>& Value, const TArray<TSharedPtr<FJsonValue>>& Results, FString& OutError)
+{
+    if (Value->Type == EJson::String)
+    {
+        const FString& Text = Value->AsString();
+        if (Text.StartsWith(TEXT("$$")))
+        {
+            return MakeShared<FJsonValueString>(Text.RightChop(1));
+        }
+        if (Text.Len() < 2 || Text[0] != TEXT('$') || !FChar::IsDigit(Text[1]))
+        {
+            return Value;
+        }
+
+        FString IndexString = Text.RightChop(1);
+        FString Path;
+        Text.RightChop(1).Split(TEXT("."), &IndexString, &Path);
+
+        const int32 ResultIndex = FCString::Atoi(*IndexString);
+        if (!IndexString.IsNumeric() || !Results.IsValidIndex(ResultIndex))
+        {
+            OutError = FString::Printf(TEXT("Reference '%s' does not point to an earlier command"), *Text);
+            return nullptr;
+        }
+        if (!Results[ResultIndex].IsValid())
+        {
+            OutError = FString::Printf(TEXT("Reference '%s' points to a command that failed"), *Text);
+            return nullptr;
+        }
+
+        TSharedPtr<FJsonValue> Resolved = ResolveBatchPath(Results[ResultIndex], Path);
+        if (!Resolved.IsValid())
+        {
+            OutError = FString::Printf(TEXT("Reference '%s' not found in the result of command %d"), *Text, ResultIndex);
+        }
+        return Resolved;
+    }
+
+    if (Value->Type == EJson::Array)
+    {
+        TArray<TSharedPtr<FJsonValue>> ResolvedArray;
+        for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+        {
+            TSharedPtr<FJsonValue> ResolvedElement = ResolveBatchReferences(Element, Results, OutError);
+            if (!ResolvedElement.IsValid())
             {
-                ResultJson = UMGCommands->HandleCommand(CommandType, Params);
+                return nullptr;
             }
-            else
+            ResolvedArray.Add(ResolvedElement);
+        }
+        return MakeShared<FJsonValueArray>(ResolvedArray);
+    }
+
+    if (Value->Type == EJson::Object)
+    {
+        TSharedPtr<FJsonObject> ResolvedObject = MakeShared<FJsonObject>();
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Value->AsObject()->Values)
+        {
+            TSharedPtr<FJsonValue> ResolvedField = ResolveBatchReferences(Field.Value, Results, OutError);
+            if (!ResolvedField.IsValid())
             {
-                ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-                ResponseJson->SetStringField(TEXT("error"), FString::Printf(TEXT("Unknown command: %s"), *CommandType));
-                
-                FString ResultString;
-                TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-                FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
-                Promise.SetValue(ResultString);
-                return;
+                return nullptr;
             }
-            
-            // Check if the result contains an error
-            bool bSuccess = true;
-            FString ErrorMessage;
-            
-            if (ResultJson->HasField(TEXT("success")))
+            ResolvedObject->SetField(Field.Key, ResolvedField);
+        }
+        return MakeShared<FJsonValueObject>(ResolvedObject);
+    }
+
+    return Value;
+}
+
+// Execute a whole batch at once, used when a batch is dispatched outside the command queue
+TSharedPtr<FJsonObject> UUnrealMCPBridge::HandleBatch(const TSharedPtr<FJsonObject>& Params)
+{
+    FMCPBatchState State;
+    FString Error;
+    if (!InitBatch(Params, State, Error))
+    {
+        return FUnrealMCPCommonUtils::CreateErrorResponse(Error);
+    }
+
+    StepBatch(State, MAX_dbl);
+    return MakeBatchResult(State);
+}
+
+// Execute batch entries in order until the batch is finished or the frame's deadline passes
+bool UUnrealMCPBridge::StepBatch(FMCPBatchState& State, double DeadlineSeconds)
+{
+    if (!State.bHoldingCompiles && !State.IsFinished())
+    {
+        FUnrealMCPCompileScheduler::Get().AddHold();
+        State.bHoldingCompiles = true;
+    }
+
+    // Always run at least one entry so the batch makes progress however small the budget
+    while (!State.IsFinished())
+    {
+        const int32 Index = State.NextIndex++;
+        TSharedPtr<FJsonObject> EntryResponse;
+        const TSharedPtr<FJsonObject>* Entry = nullptr;
+        FString EntryType;
+
+        if (!State.Commands[Index]->TryGetObject(Entry) ||
+            (!(*Entry)->TryGetStringField(TEXT("type"), EntryType) && !(*Entry)->TryGetStringField(TEXT("command"), EntryType)))
+        {
+            EntryResponse = MakeErrorEnvelope(FString::Printf(TEXT("Command %d is missing a 'type' field"), Index));
+        }
+        else if (IsBatchCommand(EntryType))
+        {
+            EntryResponse = MakeErrorEnvelope(TEXT("Batches cannot be nested"));
+        }
+        else
+        {
+            TSharedPtr<FJsonObject> EntryParams = MakeShared<FJsonObject>();
+            const TSharedPtr<FJsonObject>* ParamsObject = nullptr;
+            if ((*Entry)->TryGetObjectField(TEXT("params"), ParamsObject) && ParamsObject->IsValid())
             {
-                bSuccess = ResultJson->GetBoolField(TEXT("success"));
-                if (!bSuccess && ResultJson->HasField(TEXT("error")))
-                {
-                    ErrorMessage = ResultJson->GetStringField(TEXT("error"));
-                }
+                EntryParams = *ParamsObject;
             }
-            
-            if (bSuccess)
+
+            FString ReferenceError;
+            TSharedPtr<FJsonValue> ResolvedParams = ResolveBatchReferences(MakeShared<FJsonValueObject>(EntryParams), State.EntryResults, ReferenceError);
+            if (ResolvedParams.IsValid())
             {
-                // Set success status and include the result
-                ResponseJson->SetStringField(TEXT("status"), TEXT("success"));
-                ResponseJson->SetObjectField(TEXT("result"), ResultJson);
+                FUnrealMCPCompileScheduler::FScopedRecord RecordCompiles(State.RequestedCompiles);
+                EntryResponse = DispatchCommand(EntryType, ResolvedParams->AsObject());
             }
             else
             {
-                // Set error status and include the error message
-                ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-                ResponseJson->SetStringField(TEXT("error"), ErrorMessage);
+                EntryResponse = MakeErrorEnvelope(ReferenceError);
             }
         }
-        catch (const std::exception& e)
+
+        const bool bEntrySucceeded = EntryResponse->GetStringField(TEXT("status")) == TEXT("success");
+        State.EntryResults.Add(bEntrySucceeded ? EntryResponse->TryGetField(TEXT("result")) : nullptr);
+        State.Responses.Add(MakeShared<FJsonValueObject>(EntryResponse));
+
+        if (!bEntrySucceeded)
         {
-            ResponseJson->SetStringField(TEXT("status"), TEXT("error"));
-            ResponseJson->SetStringField(TEXT("error"), UTF8_TO_TCHAR(e.what()));
+            ++State.FailedCount;
+            State.bStopped = State.bStopOnError;
         }
-        
-        FString ResultString;
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultString);
-        FJsonSerializer::Serialize(ResponseJson.ToSharedRef(), Writer);
-        Promise.SetValue(ResultString);
-    });
-    
-    return Future.Get();
-}
\ No newline at end of file
+
+        if (FPlatformTime::Seconds() >= DeadlineSeconds)
+        {
+            break;
+        }
+    }
+
+    if (State.IsFinished() && State.bHoldingCompiles)
+    {
+        // Each Blueprint the entries edited compiles once, however many entries touched it,
+        // edits from commands outside the batch are left to the idle delay
+        FUnrealMCPCompileScheduler::Get().ReleaseHold();
+        State.bHoldingCompiles = false;
+        State.CompiledCount = FUnrealMCPCompileScheduler::Get().Flush(State.RequestedCompiles);
+    }
+    return State.IsFinished();
+}
@@ -0,0 +1,16 @@
+#include "UnrealMCPSettings.h"
+
+UUnrealMCPSettings::UUnrealMCPSettings()
+{
+    MaxMessageSizeMB = 64;
+    SendTimeoutSeconds = 30.0f;
+    MaxConnections = 8;
+    GameThreadBudgetMs = 8.0f;
+    MaxEventRate = 10.0f;
+    BlueprintCompileDelaySeconds = 1.0f;
+}
+
+FName UUnrealMCPSettings::GetCategoryName() const
+{
+    return TEXT("Plugins");
+}
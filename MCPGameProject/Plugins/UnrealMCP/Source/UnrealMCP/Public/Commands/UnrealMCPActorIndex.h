@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "Commands/UnrealMCPLevelEvents.h"
+
+class AActor;
+class UObject;
+class UWorld;
+
+/**
+ * Name to actor lookup for the editor world
+ * Built on first use and kept current from the engine's actor added, deleted
+ * and renamed notifications, so finding an actor by name no longer means
+ * walking every actor in the level. Map changes, level list changes and
+ * undo/redo mark the index stale and it is rebuilt on the next lookup.
+ * Names and labels are also kept in a sorted list for prefix lookups, built
+ * on the first prefix lookup after a rebuild. A few edits between lookups
+ * insert and remove the changed actors' keys in place; past that, as when a
+ * bulk spawn adds many actors at once, the list is sorted again on the next
+ * lookup instead, since each insertion shifts the entries after it.
+ * Game thread only.
+ */
+class UNREALMCP_API FUnrealMCPActorIndex : public IMCPLevelListener
+{
+public:
+    FUnrealMCPActorIndex();
+    ~FUnrealMCPActorIndex();
+
+    /** Find an actor in World by object name, with the same case-insensitive matching as FName */
+    AActor* FindActor(UWorld* World, const FString& ActorName);
+
+    /**
+     * Visit the actors whose name or label starts with Prefix, ignoring case, in alphabetical order of the matching key
+     * An actor whose name and label both match is visited twice. Return false from Visitor to stop.
+     */
+    void ForEachWithPrefix(UWorld* World, const FString& Prefix, bool bNames, bool bLabels, TFunctionRef<bool(AActor*)> Visitor);
+
+    /** Number of indexed actors, including entries for actors not yet known to be gone */
+    int32 Num() const { return Actors.Num(); }
+
+private:
+    /** Register for level changes, retried on each lookup until the engine is up */
+    void StartListening();
+
+    void Rebuild(UWorld* World);
+    AActor* FindIndexedActor(FName Name, bool& bOutFoundStale) const;
+    void SortKeys();
+
+    /** Insert or remove an actor's keys in the sorted list, a no-op until the list is first built */
+    void AddKeys(AActor* Actor);
+    void RemoveKeys(AActor* Actor);
+
+    /** Count one in-place key edit, false once there were enough since the last lookup that a sort is cheaper */
+    bool TrackKeyEdit();
+
+    // IMCPLevelListener, a reset marks the index stale so the next lookup rebuilds it
+    virtual void OnActorAdded(AActor* Actor) override;
+    virtual void OnActorDeleted(AActor* Actor) override;
+    virtual void OnObjectRenamed(UObject* Object, UObject* OldOuter, FName OldName) override;
+    virtual void OnActorLabelChanged(AActor* Actor) override;
+    virtual void OnLevelReset() override;
+
+    /** Multi map because actors in different sublevels may share a name */
+    TMultiMap<FName, TWeakObjectPtr<AActor>> Actors;
+    TWeakObjectPtr<UWorld> IndexedWorld;
+    bool bStale;
+
+    /** Lowercase name or label of an actor, for prefix lookups */
+    struct FSortedKey
+    {
+        FString Key;
+        TWeakObjectPtr<AActor> Actor;
+        bool bLabel;
+    };
+    TArray<FSortedKey> SortedKeys;
+
+    /** Keys each actor was listed under, so they can be found again after a rename */
+    struct FActorKeys
+    {
+        FString NameKey;
+        FString LabelKey;
+    };
+    TMap<TWeakObjectPtr<AActor>, FActorKeys> KeysByActor;
+    int32 KeyEditsSinceLookup;
+    bool bKeysDirty;
+    bool bListening;
+};
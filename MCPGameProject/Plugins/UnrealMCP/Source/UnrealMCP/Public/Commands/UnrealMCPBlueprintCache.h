@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UBlueprint;
+class UEdGraph;
+struct FAssetData;
+class FPackageReloadedEvent;
+enum class EPackageReloadPhase : uint8;
+
+/**
+ * Remembers which Blueprint a name resolved to and which graph a graph name
+ * resolved to, so commands that keep naming the same Blueprint don't resolve
+ * it and walk its graphs every time. Entries are weak and checked on each hit;
+ * asset removal, rename and reload notifications drop or repoint the entries
+ * they affect, and a new Blueprint drops the names it could make ambiguous.
+ * Also hands out opaque Blueprint handles (bp#<n>) that commands accept
+ * wherever they take a Blueprint name. Cleared when the server stops.
+ * Game thread only.
+ */
+class UNREALMCP_API FUnrealMCPBlueprintCache
+{
+public:
+    static FUnrealMCPBlueprintCache& Get();
+
+    /** Whether Name is a handle rather than a Blueprint name, handles use a character asset names can't contain */
+    static bool IsHandle(const FString& Name) { return Name.StartsWith(TEXT("bp#"), ESearchCase::CaseSensitive); }
+
+    /** Blueprint a handle was issued for, null if unknown or the Blueprint is gone */
+    UBlueprint* FindByHandle(const FString& Handle) const;
+
+    /** Handle for a Blueprint, the same one every time it is asked for during this session */
+    FString GetHandle(UBlueprint* Blueprint);
+
+    /** Blueprint a name resolved to before, null on a miss */
+    UBlueprint* FindByName(const FString& Name);
+    void AddName(const FString& Name, UBlueprint* Blueprint);
+
+    /** Graph a graph name resolved to before, null on a miss or if the graph was renamed or removed since */
+    UEdGraph* FindGraph(UBlueprint* Blueprint, const FString& GraphName);
+    void AddGraph(UBlueprint* Blueprint, const FString& GraphName, UEdGraph* Graph);
+
+    /** Forget everything and stop listening for asset notifications */
+    void Reset();
+
+private:
+    FUnrealMCPBlueprintCache();
+
+    /** Hook up the asset notifications on first use, the asset registry may not be up when the bridge starts */
+    void BindDelegates();
+    void UnbindDelegates();
+
+    /** Drop the name and graph entries of a Blueprint that was removed or renamed */
+    void Forget(const FString& ObjectPath);
+
+    void HandleAssetAdded(const FAssetData& AssetData);
+    void HandleAssetRemoved(const FAssetData& AssetData);
+    void HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+    void HandlePackageReloaded(EPackageReloadPhase Phase, FPackageReloadedEvent* Event);
+
+    TMap<FString, TWeakObjectPtr<UBlueprint>> Names;
+    TMap<FString, TWeakObjectPtr<UBlueprint>> Handles;
+    TMap<TWeakObjectPtr<UBlueprint>, FString> HandleOf;
+    TMap<TWeakObjectPtr<UBlueprint>, TMap<FString, TWeakObjectPtr<UEdGraph>>> Graphs;
+    int32 NextHandle;
+    bool bDelegatesBound;
+
+    FDelegateHandle AssetAddedHandle;
+    FDelegateHandle AssetRemovedHandle;
+    FDelegateHandle AssetRenamedHandle;
+    FDelegateHandle PackageReloadedHandle;
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/TopLevelAssetPath.h"
+
+class UBlueprint;
+class UClass;
+struct FAssetData;
+
+/**
+ * Name to path lookup for every Blueprint asset in the project
+ * Built from the asset registry on first use (UBlueprint and its subclasses,
+ * so Widget Blueprints too) and kept current from the registry's added,
+ * removed and renamed notifications, so resolving a name never scans the
+ * disk. Accepts short asset names, package paths and object paths. A short
+ * name that several Blueprints share resolves to the one in the caller's
+ * default folder if there is one, and is reported as ambiguous otherwise.
+ * Game thread only.
+ */
+class UNREALMCP_API FUnrealMCPBlueprintIndex
+{
+public:
+    static FUnrealMCPBlueprintIndex& Get();
+
+    /**
+     * Find and load the Blueprint Name refers to
+     * Names containing a '/' but not starting with one are taken relative to DefaultFolder, as is a short name
+     * no indexed Blueprint has. Only Blueprints of RequiredClass are considered. On failure OutError says why.
+     */
+    UBlueprint* Resolve(const FString& Name, const FString& DefaultFolder, const UClass* RequiredClass, FString& OutError);
+
+    /** Number of indexed Blueprint assets */
+    int32 Num() const { return NumAssets; }
+
+    /** Drop the index and stop listening for asset notifications, it is rebuilt on the next lookup */
+    void Reset();
+
+private:
+    FUnrealMCPBlueprintIndex();
+
+    struct FEntry
+    {
+        FSoftObjectPath Path;
+        FTopLevelAssetPath ClassPath;
+    };
+
+    void Build();
+    void BindDelegates();
+    void UnbindDelegates();
+
+    void AddAsset(const FAssetData& AssetData);
+    void RemoveAsset(const FSoftObjectPath& Path);
+    static bool IsBlueprintAsset(const FAssetData& AssetData);
+    static bool MatchesClass(const FEntry& Entry, const UClass* RequiredClass);
+
+    /** Load a package or object path, falling back to loading it directly if the index doesn't have it, errors refer to it as Name */
+    UBlueprint* ResolvePath(const FString& PathName, const FString& Name, const UClass* RequiredClass, FString& OutError);
+
+    void HandleAssetAdded(const FAssetData& AssetData);
+    void HandleAssetRemoved(const FAssetData& AssetData);
+    void HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+    /** Asset name, which compares without case like asset names do, to every Blueprint with that name */
+    TMap<FName, TArray<FEntry, TInlineAllocator<1>>> ByName;
+    int32 NumAssets;
+    bool bBuilt;
+
+    FDelegateHandle AssetAddedHandle;
+    FDelegateHandle AssetRemovedHandle;
+    FDelegateHandle AssetRenamedHandle;
+};
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
 
 /**
  * Handler class for Blueprint Node-related MCP commands
@@ -11,8 +12,8 @@ class UNREALMCP_API FUnrealMCPBlueprintNodeCommands
 public:
     FUnrealMCPBlueprintNodeCommands();
 
-    // Handle blueprint node commands
-    TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+    // Register blueprint node commands with the bridge's dispatch table
+    void RegisterCommands(FUnrealMCPCommandRegistry& Registry);
 
 private:
     // Specific blueprint node command handlers
@@ -43,7 +44,7 @@ private:
     
     TSharedPtr<FJsonObject> HandleConnectBlueprintNodes(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSetNodePinDefaultValue(const TSharedPtr<FJsonObject>& Params);
-    TSharedPtr<FJsonObject> HandleGetAllNodes(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleGetAllNodes(const TSharedPtr<FJsonObject>& Params, FMCPResultWriter& OutWriteResult);
 
 
     static bool GetEventGraphFromParams(const TSharedPtr<FJsonObject>& Params, UBlueprint*& Blueprint, UEdGraph*& EventGraph, TSharedPtr<FJsonObject>& ErrorResponse);
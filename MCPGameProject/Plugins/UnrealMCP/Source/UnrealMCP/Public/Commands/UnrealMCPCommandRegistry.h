@@ -0,0 +1,167 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Json.h"
+
+/** How a command may be scheduled */
+enum class EMCPCommandFlags : uint8
+{
+    None = 0,
+
+    /** Only reads editor state, never modifies assets or the level */
+    ReadOnly = 1 << 0,
+
+    /** Touches no UObjects, so it may run on the socket thread instead of waiting for the game thread */
+    AnyThread = 1 << 1,
+};
+ENUM_CLASS_FLAGS(EMCPCommandFlags);
+
+/** Signature shared by every command handler */
+using FMCPCommandHandler = TFunction<TSharedPtr<FJsonObject>(const TSharedPtr<FJsonObject>& Params)>;
+
+/** Writer for responses streamed straight to text */
+using FMCPJsonWriter = TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+/**
+ * Builds an FJsonObject through the part of the TJsonWriter interface result writers use,
+ * so the same field code serves both in-memory results and streamed ones
+ */
+class UNREALMCP_API FMCPJsonObjectBuilder
+{
+public:
+    FMCPJsonObjectBuilder();
+
+    void WriteObjectStart(const FString& Key);
+    void WriteObjectStart();
+    void WriteObjectEnd();
+    void WriteArrayStart(const FString& Key);
+    void WriteArrayEnd();
+
+    void WriteValue(const FString& Key, const FString& Value) { Objects.Last()->SetStringField(Key, Value); }
+    void WriteValue(const FString& Key, const TCHAR* Value) { Objects.Last()->SetStringField(Key, Value); }
+    void WriteValue(const FString& Key, bool Value) { Objects.Last()->SetBoolField(Key, Value); }
+    void WriteValue(const FString& Key, int32 Value) { Objects.Last()->SetNumberField(Key, Value); }
+    void WriteValue(const FString& Key, double Value) { Objects.Last()->SetNumberField(Key, Value); }
+
+    void WriteValue(const FString& Value) { Arrays.Last().Values.Add(MakeShared<FJsonValueString>(Value)); }
+    void WriteValue(double Value) { Arrays.Last().Values.Add(MakeShared<FJsonValueNumber>(Value)); }
+    void WriteNull() { Arrays.Last().Values.Add(MakeShared<FJsonValueNull>()); }
+
+    const TSharedRef<FJsonObject>& GetRoot() const { return Root; }
+
+private:
+    struct FArrayFrame
+    {
+        FString Key;
+        TArray<TSharedPtr<FJsonValue>> Values;
+    };
+
+    TSharedRef<FJsonObject> Root;
+    TArray<TSharedPtr<FJsonObject>, TInlineAllocator<4>> Objects;
+    TArray<FArrayFrame, TInlineAllocator<2>> Arrays;
+};
+
+/**
+ * Writes the fields of a command's result object, called once right after its handler returns
+ * Holds the same writing code twice, once for text streamed to the client and
+ * once for an object built in memory, so results that go out as objects
+ * (batches, MessagePack, in-editor callers) never round-trip through text.
+ */
+struct FMCPResultWriter
+{
+    TFunction<void(FMCPJsonWriter& Writer)> WriteText;
+    TFunction<void(FMCPJsonObjectBuilder& Writer)> WriteObject;
+
+    explicit operator bool() const { return WriteText && WriteObject; }
+
+    /** Wrap a callable taking either writer, normally a lambda with an auto& parameter */
+    template<typename FuncType>
+    static FMCPResultWriter Make(FuncType&& Func)
+    {
+        TSharedRef<TDecay<FuncType>> Shared = MakeShared<TDecay<FuncType>>(Forward<FuncType>(Func));
+        FMCPResultWriter Result;
+        Result.WriteText = [Shared](FMCPJsonWriter& Writer) { (*Shared)(Writer); };
+        Result.WriteObject = [Shared](FMCPJsonObjectBuilder& Writer) { (*Shared)(Writer); };
+        return Result;
+    }
+};
+
+/**
+ * Handler for commands whose results can be large
+ * Returns a result object as usual, which is how errors are reported, or
+ * returns null and sets OutWriteResult to have the result written straight
+ * to the client instead of being built in memory first.
+ */
+using FMCPStreamingHandler = TFunction<TSharedPtr<FJsonObject>(const TSharedPtr<FJsonObject>& Params, FMCPResultWriter& OutWriteResult)>;
+
+/**
+ * A command registered with the bridge
+ */
+struct FMCPCommandInfo
+{
+    FName Name;
+    FString Category;
+    FString Description;
+    FMCPCommandHandler Handler;
+
+    /** Set for commands that can stream their result, Handler then builds the same result as an object */
+    FMCPStreamingHandler StreamingHandler;
+    EMCPCommandFlags Flags = EMCPCommandFlags::None;
+
+    bool IsReadOnly() const { return EnumHasAnyFlags(Flags, EMCPCommandFlags::ReadOnly); }
+    bool CanRunOnAnyThread() const { return EnumHasAnyFlags(Flags, EMCPCommandFlags::AnyThread); }
+};
+
+/**
+ * Dispatch table mapping command names to their handlers
+ * Each command handler class adds its commands in RegisterCommands, so a new
+ * command only needs to be registered in one place to become routable.
+ */
+class UNREALMCP_API FUnrealMCPCommandRegistry
+{
+public:
+    /** Add a command, replacing any earlier registration with the same name */
+    void Register(FName Name, const FString& Category, const FString& Description, FMCPCommandHandler Handler,
+                  EMCPCommandFlags Flags = EMCPCommandFlags::None);
+
+    /** Convenience overload for handlers that are member functions of a command class */
+    template<typename OwnerType>
+    void Register(FName Name, const FString& Category, const FString& Description, OwnerType* Owner,
+                  TSharedPtr<FJsonObject> (OwnerType::*Method)(const TSharedPtr<FJsonObject>&),
+                  EMCPCommandFlags Flags = EMCPCommandFlags::None)
+    {
+        Register(Name, Category, Description, [Owner, Method](const TSharedPtr<FJsonObject>& Params)
+        {
+            return (Owner->*Method)(Params);
+        }, Flags);
+    }
+
+    /** Add a command that can stream its result to clients that accept streamed responses */
+    void RegisterStreaming(FName Name, const FString& Category, const FString& Description, FMCPStreamingHandler Handler,
+                           EMCPCommandFlags Flags = EMCPCommandFlags::None);
+
+    template<typename OwnerType>
+    void RegisterStreaming(FName Name, const FString& Category, const FString& Description, OwnerType* Owner,
+                           TSharedPtr<FJsonObject> (OwnerType::*Method)(const TSharedPtr<FJsonObject>&, FMCPResultWriter&),
+                           EMCPCommandFlags Flags = EMCPCommandFlags::None)
+    {
+        RegisterStreaming(Name, Category, Description, [Owner, Method](const TSharedPtr<FJsonObject>& Params, FMCPResultWriter& OutWriteResult)
+        {
+            return (Owner->*Method)(Params, OutWriteResult);
+        }, Flags);
+    }
+
+    /** Build the result object a result writer would have written, without going through text */
+    static TSharedPtr<FJsonObject> WriteResultToObject(const FMCPResultWriter& WriteResult);
+
+    /** Look up a command by the name a client sent, returns null if it isn't registered */
+    const FMCPCommandInfo* Find(const FString& CommandType) const;
+
+    /** All registered commands, sorted by category then name */
+    TArray<const FMCPCommandInfo*> GetCommands() const;
+
+    int32 Num() const { return Commands.Num(); }
+
+private:
+    TMap<FName, FMCPCommandInfo> Commands;
+};
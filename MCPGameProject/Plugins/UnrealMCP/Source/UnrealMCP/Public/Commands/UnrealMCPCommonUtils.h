@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
 
 // Forward declarations
 class AActor;
@@ -78,6 +79,31 @@ enum EVariableScopeType
 	Local
 };
 
+/** Actor fields a command can ask for, selected by a "fields" parameter */
+enum class EMCPActorFields : uint32
+{
+	None = 0,
+	Name = 1 << 0,
+	Class = 1 << 1,
+	Location = 1 << 2,
+	Rotation = 1 << 3,
+	Scale = 1 << 4,
+	Label = 1 << 5,
+	Folder = 1 << 6,
+	Tags = 1 << 7,
+
+	/** Name and class of each component */
+	Components = 1 << 8,
+
+	/** Every editable property as exported text, can be large */
+	Properties = 1 << 9,
+
+	Transform = Location | Rotation | Scale,
+	Default = Name | Class | Transform,
+	All = Default | Label | Folder | Tags | Components | Properties,
+};
+ENUM_CLASS_FLAGS(EMCPActorFields);
+
 enum EVariableOperateType
 {
 	GetValue,
@@ -213,13 +239,21 @@ public:
     static FRotator GetRotatorFromJson(const TSharedPtr<FJsonObject>& JsonObject, const FString& FieldName);
     
     // Actor utilities
-    static TSharedPtr<FJsonValue> ActorToJson(AActor* Actor);
-    static TSharedPtr<FJsonObject> ActorToJsonObject(AActor* Actor, bool bDetailed = false);
+    static TSharedPtr<FJsonObject> ActorToJsonObject(AActor* Actor, EMCPActorFields Fields = EMCPActorFields::Default);
+    /** Write the requested fields of an actor as one JSON object, without building it in memory first */
+    static void WriteActorJson(FMCPJsonWriter& Writer, AActor* Actor, EMCPActorFields Fields);
+    static void WriteActorJson(FMCPJsonObjectBuilder& Writer, AActor* Actor, EMCPActorFields Fields);
+    static bool ParseActorFields(const TSharedPtr<FJsonObject>& Params, EMCPActorFields& OutFields, FString& OutError,
+                                 EMCPActorFields DefaultFields = EMCPActorFields::Default);
     
     // Blueprint utilities
     static UBlueprint* FindBlueprint(const FString& BlueprintName);
-    static UBlueprint* FindBlueprintByName(const FString& BlueprintName);
+    /** Find a Blueprint by handle, short name or path, OutError says whether it was missing or the name ambiguous */
+    static UBlueprint* FindBlueprint(const FString& BlueprintName, FString& OutError);
+    static UBlueprint* FindBlueprintByName(const FString& BlueprintName, FString& OutError);
     static UEdGraph* FindOrCreateEventGraph(UBlueprint* Blueprint);
+    /** Compile status as reported to clients: up_to_date, warnings, error or dirty */
+    static const TCHAR* BlueprintStatusToString(const UBlueprint* Blueprint);
 	static UEdGraph* FindBlueprintGraphByName(UBlueprint* Blueprint, const FString& GraphName);
     
     // Blueprint node utilities
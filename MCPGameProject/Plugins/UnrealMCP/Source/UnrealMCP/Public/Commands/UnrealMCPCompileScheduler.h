@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UBlueprint;
+
+/**
+ * Defers Blueprint compiles so a run of edits compiles each Blueprint once
+ * Commands that change a Blueprint ask for a compile instead of compiling it
+ * straight away, and the Blueprint joins a pending set. Pending Blueprints are
+ * compiled when a batch finishes, when compile_blueprint names them, when a
+ * command needs their generated class, or once no edit has asked for a
+ * compile for the idle delay. Requests sent with "defer_compile": false
+ * compile on every edit as before. Game thread only.
+ */
+class UNREALMCP_API FUnrealMCPCompileScheduler
+{
+public:
+    static FUnrealMCPCompileScheduler& Get();
+
+    /** Seconds without a new compile request before pending Blueprints are compiled */
+    void SetIdleDelay(float InIdleDelaySeconds) { IdleDelaySeconds = FMath::Max(InIdleDelaySeconds, 0.0f); }
+
+    /** Note that a Blueprint was edited, compiling it now if the current request opted out of deferral */
+    void RequestCompile(UBlueprint* Blueprint);
+
+    /** Compile a Blueprint if it has a compile pending, call before using its generated class */
+    void EnsureCompiled(UBlueprint* Blueprint);
+
+    /** Compile a Blueprint now, pending or not */
+    void CompileNow(UBlueprint* Blueprint);
+
+    /** Drop a Blueprint from the pending set after it was compiled some other way */
+    void MarkCompiled(UBlueprint* Blueprint);
+
+    /** Compile every pending Blueprint, returns how many were compiled */
+    int32 FlushAll();
+
+    /** Compile those of the given Blueprints still pending, in request order, returns how many were compiled */
+    int32 Flush(const TArray<TWeakObjectPtr<UBlueprint>>& Blueprints);
+
+    bool IsPending(const UBlueprint* Blueprint) const;
+    int32 NumPending() const { return Pending.Num(); }
+
+    /** Keep the idle delay from compiling while a batch is between entries, released when the batch ends */
+    void AddHold() { ++HoldCount; }
+    void ReleaseHold() { HoldCount = FMath::Max(HoldCount - 1, 0); }
+
+    /** Makes compile requests compile immediately while in scope */
+    class FScopedImmediate
+    {
+    public:
+        explicit FScopedImmediate(bool bInActive)
+            : bActive(bInActive)
+        {
+            if (bActive)
+            {
+                ++Get().ImmediateCount;
+            }
+        }
+
+        ~FScopedImmediate()
+        {
+            if (bActive)
+            {
+                --Get().ImmediateCount;
+            }
+        }
+
+    private:
+        bool bActive;
+    };
+
+    /** Collects the Blueprints asked to compile while in scope, so a batch flushes only its own edits */
+    class FScopedRecord
+    {
+    public:
+        explicit FScopedRecord(TArray<TWeakObjectPtr<UBlueprint>>& Into)
+            : PreviousRecord(Get().Record)
+        {
+            Get().Record = &Into;
+        }
+
+        ~FScopedRecord()
+        {
+            Get().Record = PreviousRecord;
+        }
+
+    private:
+        TArray<TWeakObjectPtr<UBlueprint>>* PreviousRecord;
+    };
+
+private:
+    FUnrealMCPCompileScheduler();
+
+    /** Compile the pending Blueprints that pass the filter, in the order the compiles were requested */
+    int32 CompilePending(TFunctionRef<bool(const TWeakObjectPtr<UBlueprint>&)> Filter);
+
+    /** Stop ticking once nothing is left to compile */
+    void StopTickerIfIdle();
+
+    /** Core ticker callback, compiles the pending set once requests have been idle long enough */
+    bool Tick(float DeltaTime);
+
+    /** Oldest request first, each Blueprint at most once */
+    TArray<TWeakObjectPtr<UBlueprint>> Pending;
+    double LastRequestTime;
+    float IdleDelaySeconds;
+    int32 ImmediateCount;
+    int32 HoldCount;
+    TArray<TWeakObjectPtr<UBlueprint>>* Record;
+    FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -2,6 +2,12 @@
 
 #include "CoreMinimal.h"
 #include "Json.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
+
+class FUnrealMCPActorIndex;
+class FUnrealMCPSpatialIndex;
+class FUnrealMCPLevelJournal;
+enum class EMCPActorFields : uint32;
 
 /**
  * Handler class for Editor-related MCP commands
@@ -12,12 +18,21 @@ class UNREALMCP_API FUnrealMCPEditorCommands
 public:
     FUnrealMCPEditorCommands();
 
-    // Handle editor commands
-    TSharedPtr<FJsonObject> HandleCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+    // Register editor commands with the bridge's dispatch table
+    void RegisterCommands(FUnrealMCPCommandRegistry& Registry);
+
+    /** The level journal, recording changes to the current editor world */
+    FUnrealMCPLevelJournal& GetLevelJournal();
+
+    /**
+     * Build the get_level_changes_since result for the changes after SinceVersion
+     * @param bSameJournal - False if the version came from another journal, which always needs a resync
+     */
+    TSharedPtr<FJsonObject> MakeLevelChanges(uint64 SinceVersion, bool bSameJournal, EMCPActorFields Fields);
 
 private:
     // Actor manipulation commands
-    TSharedPtr<FJsonObject> HandleGetActorsInLevel(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleGetActorsInLevel(const TSharedPtr<FJsonObject>& Params, FMCPResultWriter& OutWriteResult);
     TSharedPtr<FJsonObject> HandleFindActorsByName(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSpawnActor(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleDeleteActor(const TSharedPtr<FJsonObject>& Params);
@@ -25,10 +40,41 @@ private:
     TSharedPtr<FJsonObject> HandleGetActorProperties(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleSetActorProperty(const TSharedPtr<FJsonObject>& Params);
 
+    // Bulk actor commands, each one undo transaction with errors reported per entry
+    TSharedPtr<FJsonObject> HandleSpawnActors(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleSetActorTransforms(const TSharedPtr<FJsonObject>& Params);
+
+    // Instanced placement, many copies of a mesh as instances on one actor
+    TSharedPtr<FJsonObject> HandleAddMeshInstances(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleUpdateMeshInstances(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleRemoveMeshInstances(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleGetMeshInstances(const TSharedPtr<FJsonObject>& Params);
+
+    // Level change journal
+    TSharedPtr<FJsonObject> HandleGetLevelChangesSince(const TSharedPtr<FJsonObject>& Params);
+
+    // Spatial queries
+    TSharedPtr<FJsonObject> HandleFindActorsInRadius(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleFindActorsInBox(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleFindNearestActors(const TSharedPtr<FJsonObject>& Params);
+    TSharedPtr<FJsonObject> HandleFindActorsOnRay(const TSharedPtr<FJsonObject>& Params);
+
     // Blueprint actor spawning
     TSharedPtr<FJsonObject> HandleSpawnBlueprintActor(const TSharedPtr<FJsonObject>& Params);
 
     // Editor viewport commands
     TSharedPtr<FJsonObject> HandleFocusViewport(const TSharedPtr<FJsonObject>& Params);
     TSharedPtr<FJsonObject> HandleTakeScreenshot(const TSharedPtr<FJsonObject>& Params);
+
+    // Name lookup shared by every command that targets a single actor
+    TSharedPtr<FUnrealMCPActorIndex> ActorIndex;
+
+    // Octree over actor bounds behind the spatial queries
+    TSharedPtr<FUnrealMCPSpatialIndex> SpatialIndex;
+
+    // Versioned record of level edits behind get_level_changes_since
+    TSharedPtr<FUnrealMCPLevelJournal> LevelJournal;
+
+    /** Update the spatial index and the journal after a command changes an actor, PropertyName None meaning its transform */
+    void NoteActorEdited(AActor* Actor, FName PropertyName = NAME_None);
 }; 
\ No newline at end of file
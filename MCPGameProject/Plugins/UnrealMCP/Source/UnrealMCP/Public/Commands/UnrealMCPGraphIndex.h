@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EdGraph/EdGraphNode.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UEdGraph;
+class UEdGraphPin;
+struct FEdGraphEditAction;
+
+/**
+ * Per-graph lookup of nodes by GUID and of pins by node, name and direction
+ * A graph's node map is built the first time a node is looked up in it and
+ * kept current from the graph's changed notifications: added nodes are
+ * indexed on the next lookup (the plugin gives nodes their GUID after adding
+ * them), removed nodes are dropped, and any other change rebuilds the map.
+ * Pins are remembered by their position in the node's pin list once found,
+ * along with the name of the pin the request matched, which need not be the
+ * requested name. Every hit is checked against the node as it is now, so
+ * node reconstruction never leaves a stale pin behind. Game thread only.
+ */
+class UNREALMCP_API FUnrealMCPGraphIndex
+{
+public:
+    static FUnrealMCPGraphIndex& Get();
+
+    /** Node of Graph with the given GUID, null if there is none */
+    UEdGraphNode* FindNode(UEdGraph* Graph, const FGuid& NodeId);
+
+    /** Pin remembered for this name and direction, null on a miss */
+    UEdGraphPin* FindPin(UEdGraphNode* Node, const FString& PinName, EEdGraphPinDirection Direction);
+    void AddPin(UEdGraphNode* Node, const FString& PinName, EEdGraphPinDirection Direction, const UEdGraphPin* Pin);
+
+    /** Forget every graph and stop listening to them */
+    void Reset();
+
+private:
+    FUnrealMCPGraphIndex() = default;
+
+    struct FPinKey
+    {
+        FGuid NodeId;
+        FName PinName;
+        EEdGraphPinDirection Direction;
+
+        bool operator==(const FPinKey& Other) const
+        {
+            return NodeId == Other.NodeId && PinName == Other.PinName && Direction == Other.Direction;
+        }
+
+        friend uint32 GetTypeHash(const FPinKey& Key)
+        {
+            return HashCombine(HashCombine(GetTypeHash(Key.NodeId), GetTypeHash(Key.PinName)), (uint32)Key.Direction);
+        }
+    };
+
+    struct FGraphEntry
+    {
+        TMap<FGuid, TWeakObjectPtr<UEdGraphNode>> Nodes;
+        /** Nodes added since the last lookup, whose GUID may not be final when the graph reports them */
+        TArray<TWeakObjectPtr<UEdGraphNode>> Added;
+        /** Index into the node's Pins and the name the pin there had */
+        TMap<FPinKey, TPair<int32, FName>> Pins;
+        FDelegateHandle ChangedHandle;
+        bool bStale = true;
+    };
+
+    /** Entry for Graph, listening to it from now on if it is new */
+    FGraphEntry& FindOrAddEntry(UEdGraph* Graph);
+    void Rebuild(UEdGraph* Graph, FGraphEntry& Entry);
+    void HandleGraphChanged(const FEdGraphEditAction& Action);
+
+    TMap<TWeakObjectPtr<UEdGraph>, FGraphEntry> Graphs;
+};
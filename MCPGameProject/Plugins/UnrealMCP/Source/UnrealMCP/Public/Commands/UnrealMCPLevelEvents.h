@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class UObject;
+struct FPropertyChangedEvent;
+
+/**
+ * Receives the editor's level change notifications through FUnrealMCPLevelEvents
+ * Every handler defaults to doing nothing, so a listener only overrides the
+ * changes it tracks. Called on the game thread.
+ */
+class IMCPLevelListener
+{
+public:
+    virtual ~IMCPLevelListener() {}
+
+    virtual void OnActorAdded(AActor* Actor) {}
+    virtual void OnActorDeleted(AActor* Actor) {}
+    virtual void OnActorMoved(AActor* Actor) {}
+    virtual void OnActorLabelChanged(AActor* Actor) {}
+    virtual void OnObjectRenamed(UObject* Object, UObject* OldOuter, FName OldName) {}
+    virtual void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event) {}
+
+    /** The level list changed, a map was loaded or an undo/redo ran, so any actor may have changed without a notification */
+    virtual void OnLevelReset() {}
+};
+
+/**
+ * One set of engine level change bindings shared by everything that tracks
+ * the editor world. The engine delegates are bound when the first listener
+ * is added and unbound when the last one leaves. GEngine doesn't exist yet
+ * when the bridge CDO is built, so listeners are added on first use rather
+ * than on construction. Game thread only.
+ */
+class UNREALMCP_API FUnrealMCPLevelEvents
+{
+public:
+    static FUnrealMCPLevelEvents& Get();
+
+    /** Start forwarding level changes to Listener, returns false if the engine isn't up yet */
+    bool AddListener(IMCPLevelListener* Listener);
+    void RemoveListener(IMCPLevelListener* Listener);
+
+private:
+    FUnrealMCPLevelEvents() = default;
+
+    void BindDelegates();
+    void UnbindDelegates();
+
+    /** Call Handler on every listener, by index since a handler may add or remove listeners */
+    template<typename FuncType>
+    void Broadcast(FuncType&& Handler)
+    {
+        for (int32 Index = 0; Index < Listeners.Num(); ++Index)
+        {
+            Handler(*Listeners[Index]);
+        }
+    }
+
+    TArray<IMCPLevelListener*> Listeners;
+    bool bDelegatesBound = false;
+
+    FDelegateHandle ActorAddedHandle;
+    FDelegateHandle ActorDeletedHandle;
+    FDelegateHandle ActorMovedHandle;
+    FDelegateHandle ActorListChangedHandle;
+    FDelegateHandle ActorLabelChangedHandle;
+    FDelegateHandle ObjectRenamedHandle;
+    FDelegateHandle PropertyChangedHandle;
+    FDelegateHandle MapChangeHandle;
+    FDelegateHandle UndoRedoHandle;
+};
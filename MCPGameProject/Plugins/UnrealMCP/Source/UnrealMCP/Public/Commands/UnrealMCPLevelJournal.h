@@ -0,0 +1,99 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtr.h"
+#include "Commands/UnrealMCPLevelEvents.h"
+
+class AActor;
+class UObject;
+class UWorld;
+struct FPropertyChangedEvent;
+
+/** What happened to an actor in one journal entry */
+enum class EMCPLevelChange : uint8
+{
+    Added,
+    Removed,
+    Transformed,
+    PropertyChanged,
+    Renamed
+};
+
+/** One entry of the level journal */
+struct FMCPLevelChange
+{
+    uint64 Version = 0;
+    EMCPLevelChange Kind = EMCPLevelChange::PropertyChanged;
+    FObjectKey ActorKey;
+    TWeakObjectPtr<AActor> Actor;
+
+    /** Name of the actor when the change happened */
+    FName ActorName;
+
+    /** Previous name for Renamed, changed property for PropertyChanged */
+    FName Detail;
+};
+
+/**
+ * Versioned journal of actor changes in the editor world
+ * Every actor added, removed, moved, edited or renamed gets the next version
+ * number, so a client that has seen the level at some version can ask for
+ * just what changed since. Recorded from the engine's notifications, plus
+ * explicit records from commands whose changes the engine doesn't broadcast.
+ * Map changes, level list changes and undo/redo can change anything, so they
+ * reset the journal and clients from before the reset must reload the level.
+ * The oldest entries are dropped past a fixed size, with the same effect for
+ * clients that fall that far behind. Starts recording on first use. Game
+ * thread only.
+ */
+class UNREALMCP_API FUnrealMCPLevelJournal : public IMCPLevelListener
+{
+public:
+    FUnrealMCPLevelJournal();
+    ~FUnrealMCPLevelJournal();
+
+    /** Start recording changes to World if not already, call before reading the level so no later change is missed */
+    void Prepare(UWorld* World);
+
+    /** Version of the most recent change */
+    uint64 GetVersion() const { return Version; }
+
+    /** Identifies this journal, versions from another journal (e.g. before an editor restart) can't be compared */
+    const FString& GetJournalId() const { return JournalId; }
+
+    /**
+     * Copy the entries after SinceVersion in order
+     * Returns false if some of them are no longer known, because of a reset or because they were dropped.
+     */
+    bool GetChangesSince(uint64 SinceVersion, TArray<FMCPLevelChange>& OutChanges) const;
+
+    /** Record a change made without an engine notification, such as setting a transform from code */
+    void RecordTransformed(AActor* Actor);
+    void RecordPropertyChanged(AActor* Actor, FName PropertyName);
+
+private:
+    /** Begin recording once a command first reads the level, nothing before that can be asked about */
+    void StartListening();
+
+    void Record(AActor* Actor, EMCPLevelChange Kind, FName Detail = NAME_None);
+    void Reset();
+
+    // IMCPLevelListener, every notification becomes an entry and a reset empties the journal
+    virtual void OnActorAdded(AActor* Actor) override;
+    virtual void OnActorDeleted(AActor* Actor) override;
+    virtual void OnActorMoved(AActor* Actor) override;
+    virtual void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event) override;
+    virtual void OnObjectRenamed(UObject* Object, UObject* OldOuter, FName OldName) override;
+    virtual void OnLevelReset() override;
+
+    /** Oldest entries first, versions strictly increasing */
+    TArray<FMCPLevelChange> Entries;
+    TWeakObjectPtr<UWorld> JournalWorld;
+    FString JournalId;
+    uint64 Version;
+
+    /** Changes up to and including this version are no longer in Entries */
+    uint64 ForgottenVersion;
+    bool bListening;
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "Commands/UnrealMCPLevelEvents.h"
+
+class AActor;
+class UObject;
+class UWorld;
+struct FPropertyChangedEvent;
+struct FUnrealMCPSpatialOctree;
+
+/** An actor returned by a spatial query, with its current bounds and its distance from the query */
+struct FUnrealMCPSpatialHit
+{
+    AActor* Actor = nullptr;
+    FBox Bounds = FBox(ForceInit);
+
+    /** Distance from the query point to the bounds, or along the ray for ray queries */
+    double Distance = 0.0;
+};
+
+/** Returns false for actors a query should skip */
+using FUnrealMCPSpatialFilter = TFunctionRef<bool(const AActor*)>;
+
+/**
+ * Octree over the bounds of the actors in the editor world
+ * Built on first use and kept current from the engine's actor added, deleted
+ * and moved notifications, property edits, and explicit updates from commands
+ * that move actors. Candidates are checked against their live bounds, so an
+ * actor moved without a notification is never reported where it no longer is,
+ * and its entry is corrected for later queries. Actors without a root
+ * component have no place in the level and are not indexed. Map changes,
+ * level list changes and undo/redo mark the index stale and it is rebuilt on
+ * the next query. Game thread only.
+ */
+class UNREALMCP_API FUnrealMCPSpatialIndex : public IMCPLevelListener
+{
+public:
+    FUnrealMCPSpatialIndex();
+    ~FUnrealMCPSpatialIndex();
+
+    /** Actors whose bounds come within Radius of Center, nearest first */
+    void FindInRadius(UWorld* World, const FVector& Center, double Radius, FUnrealMCPSpatialFilter Filter, TArray<FUnrealMCPSpatialHit>& OutHits);
+
+    /** Actors whose bounds intersect Box, or lie entirely inside it when bContained is set */
+    void FindInBox(UWorld* World, const FBox& Box, bool bContained, FUnrealMCPSpatialFilter Filter, TArray<FUnrealMCPSpatialHit>& OutHits);
+
+    /** Up to Count actors nearest to Location, nearest first. MaxDistance <= 0 means unlimited */
+    void FindNearest(UWorld* World, const FVector& Location, int32 Count, double MaxDistance, FUnrealMCPSpatialFilter Filter, TArray<FUnrealMCPSpatialHit>& OutHits);
+
+    /** Up to MaxHits actors whose bounds the ray enters within MaxDistance, in the order it enters them */
+    void FindOnRay(UWorld* World, const FVector& Origin, const FVector& Direction, double MaxDistance, int32 MaxHits, FUnrealMCPSpatialFilter Filter, TArray<FUnrealMCPSpatialHit>& OutHits);
+
+    /** Re-read an actor's bounds after changing its transform or components */
+    void UpdateActor(AActor* Actor);
+
+    /** Number of indexed actors */
+    int32 Num() const;
+
+private:
+    /** Subscribe to actor adds, deletes, moves and edits the first time a query prepares the octree */
+    void StartListening();
+
+    /** Bind delegates and rebuild if the index is stale or was built for another world */
+    void Prepare(UWorld* World);
+    void Rebuild(UWorld* World);
+
+    /** Indexed actors whose cached bounds intersect QueryBox and pass Filter, with their live bounds */
+    void Gather(const FBox& QueryBox, FUnrealMCPSpatialFilter Filter, TArray<FUnrealMCPSpatialHit>& OutCandidates);
+
+    void AddActor(AActor* Actor);
+    void RemoveActor(const AActor* Actor);
+
+    // IMCPLevelListener
+    virtual void OnActorAdded(AActor* Actor) override;
+    virtual void OnActorDeleted(AActor* Actor) override;
+    virtual void OnActorMoved(AActor* Actor) override;
+    virtual void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event) override;
+    virtual void OnLevelReset() override;
+    void MarkStale();
+
+    TUniquePtr<FUnrealMCPSpatialOctree> Octree;
+    TWeakObjectPtr<UWorld> IndexedWorld;
+    bool bStale;
+    bool bListening;
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Sockets.h"
+#include "Dom/JsonObject.h"
+#include "MCPServerRunnable.h"
+#include <atomic>
+
+class UUnrealMCPBridge;
+class FRunnableThread;
+class FMCPResponseWriter;
+struct FMCPOutbox;
+class IMCPEventSink;
+class FMCPResponseStream;
+
+/**
+ * A single client session on its own worker thread
+ * Owns the client socket and its framing state, and feeds every message it
+ * receives to the bridge's shared command dispatcher. Commands are not waited
+ * on: the next request is read while earlier ones execute, and responses are
+ * written by a companion writer thread as they complete.
+ */
+class FMCPClientConnection : public FRunnable
+{
+public:
+	FMCPClientConnection(UUnrealMCPBridge* InBridge, TSharedPtr<FSocket> InSocket, int32 InConnectionId, const FMCPServerConfig& InConfig);
+	virtual ~FMCPClientConnection();
+
+	/** Spawn the worker threads serving this connection */
+	bool Start();
+
+	/** True once the client has disconnected and the workers are done with the socket */
+	bool IsFinished() const { return bFinished; }
+
+	int32 GetConnectionId() const { return ConnectionId; }
+
+	/** Build a protocol-level error response for messages that never reach the bridge */
+	static TSharedPtr<FJsonObject> MakeErrorResponse(const FString& Message);
+
+	// FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+protected:
+	friend class FMCPResponseWriter;
+
+	/** Parse one JSON message and hand it to the bridge, the response is queued once the command completes */
+	void ProcessMessage(const FString& Message);
+
+	/** Decode one MessagePack message and hand it to the bridge */
+	void ProcessBinaryMessage(const TArray<uint8>& Payload);
+
+	/** Submit a decoded request envelope to the bridge */
+	void ProcessRequest(const TSharedPtr<FJsonObject>& JsonMessage);
+
+	/** Serialize and send one response, returns false if the client can no longer be written to */
+	bool SendResponse(const TSharedPtr<FJsonObject>& Response);
+
+	/** Send a streamed response a chunk at a time as its command writes it, returns false if the client can no longer be written to */
+	bool SendStream(FMCPResponseStream& Stream);
+
+	/** Send the whole buffer, waiting for the socket to drain when the send buffer is full */
+	bool SendAll(const uint8* Data, int32 NumBytes);
+
+private:
+	UUnrealMCPBridge* Bridge;
+	TSharedPtr<FSocket> Socket;
+	FRunnableThread* Thread;
+	int32 ConnectionId;
+	FMCPServerConfig Config;
+
+	/** Responses waiting to be written; shared with in-flight commands so they can outlive the connection */
+	TSharedPtr<FMCPOutbox> Outbox;
+	TUniquePtr<FMCPResponseWriter> Writer;
+	FRunnableThread* WriterThread;
+
+	/** Where the event hub delivers this connection's subscriptions, passed along with every command */
+	TSharedPtr<IMCPEventSink> EventSink;
+
+	/** Set by the reader during the handshake, before any response can be queued */
+	std::atomic<bool> bBinaryWireFormat;
+
+	std::atomic<bool> bRunning;
+	std::atomic<bool> bFinished;
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Containers/Queue.h"
+#include "HAL/CriticalSection.h"
+
+/** Scheduling lanes for commands waiting on the game thread */
+enum class EMCPCommandPriority : uint8
+{
+	/** Let the bridge pick: bulk for batches, interactive for everything else */
+	Default,
+
+	/** Single edits and queries, always drained before bulk work */
+	Interactive,
+
+	/** Large automated workloads that may be spread over many frames */
+	Bulk,
+};
+
+/** Snapshot of the queue's metrics */
+struct FMCPCommandQueueStats
+{
+	int32 InteractiveDepth = 0;
+	int32 BulkDepth = 0;
+	int32 PeakDepth = 0;
+	uint64 Executed = 0;
+
+	/** Frames that ran out of budget with work still queued */
+	uint64 BudgetExhaustedFrames = 0;
+
+	double AverageWaitMs = 0.0;
+	double MaxWaitMs = 0.0;
+	double LastFrameMs = 0.0;
+	float BudgetMs = 0.0f;
+};
+
+/**
+ * A unit of game thread work
+ * Called with the FPlatformTime::Seconds() deadline for the current frame. Returns true
+ * when finished, or false to be resumed next frame (used by batches to yield between entries).
+ */
+using FMCPQueuedStep = TUniqueFunction<bool(double DeadlineSeconds)>;
+
+/**
+ * Command queue drained on the game thread within a per-frame time budget
+ *
+ * Work is taken from the interactive lane first, then the bulk lane, until the
+ * frame's budget is spent, so a long stream of automated edits can't freeze
+ * the editor UI. At least one step runs every frame so progress is guaranteed.
+ *
+ * Work that names the same asset is kept in submission order: interactive work
+ * for an asset that still has bulk work pending is demoted to the bulk lane.
+ */
+class FMCPCommandQueue
+{
+public:
+	explicit FMCPCommandQueue(float InBudgetMs);
+	~FMCPCommandQueue();
+
+	/** Start draining on the core ticker, must be called on the game thread */
+	void Start();
+
+	/** Stop draining and cancel everything still queued, must be called on the game thread */
+	void Stop();
+
+	/**
+	 * Queue work from any thread
+	 * @param Priority - Requested lane, Default is treated as Interactive
+	 * @param OrderingKeys - Assets the work touches; work sharing a key runs in submission order
+	 * @param Step - The work itself, see FMCPQueuedStep
+	 * @param OnCancel - Called instead of Step if the queue is stopped first
+	 */
+	void Enqueue(EMCPCommandPriority Priority, const TArray<FString>& OrderingKeys, FMCPQueuedStep Step, TUniqueFunction<void()> OnCancel);
+
+	FMCPCommandQueueStats GetStats() const;
+
+private:
+	struct FQueuedWork
+	{
+		FMCPQueuedStep Step;
+		TUniqueFunction<void()> OnCancel;
+		TArray<FString> OrderingKeys;
+		double EnqueueTime = 0.0;
+		bool bStarted = false;
+	};
+
+	/** Core ticker callback, drains work until the budget runs out */
+	bool Tick(float DeltaTime);
+
+	/** Next work to run, continuing a partially executed item first. Called with Lock held. */
+	TUniquePtr<FQueuedWork> PopNext(bool& bOutFromBulk);
+
+	mutable FCriticalSection Lock;
+
+	TQueue<TUniquePtr<FQueuedWork>> InteractiveLane;
+	TQueue<TUniquePtr<FQueuedWork>> BulkLane;
+
+	/** Partially executed work, resumed before anything else in its lane */
+	TUniquePtr<FQueuedWork> ResumeInteractive;
+	TUniquePtr<FQueuedWork> ResumeBulk;
+
+	/** Number of pending bulk items per ordering key */
+	TMap<FString, int32> BulkKeyCounts;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+	float BudgetMs;
+
+	// Metrics, guarded by Lock
+	FMCPCommandQueueStats Stats;
+	double TotalWaitMs;
+	uint64 WaitSamples;
+};
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+#include "UObject/WeakObjectPtr.h"
+
+class FUnrealMCPEditorCommands;
+class FObjectPostSaveContext;
+class UBlueprint;
+class UPackage;
+enum class EMCPActorFields : uint32;
+
+/** Editor event streams a client can subscribe to */
+enum class EMCPEventStreams : uint8
+{
+	None = 0,
+
+	/** Actors added, removed, moved, edited or renamed, from the level journal */
+	Actors = 1 << 0,
+
+	/** Blueprints that finished compiling, with their status */
+	BlueprintCompiled = 1 << 1,
+
+	/** Packages written to disk */
+	AssetSaved = 1 << 2,
+
+	/** Play In Editor sessions starting and stopping */
+	PIE = 1 << 3,
+
+	All = Actors | BlueprintCompiled | AssetSaved | PIE,
+};
+ENUM_CLASS_FLAGS(EMCPEventStreams);
+
+/**
+ * Where a client connection receives notifications
+ * Implemented by the connection, only called on the game thread.
+ */
+class IMCPEventSink
+{
+public:
+	virtual ~IMCPEventSink() {}
+
+	virtual int32 GetConnectionId() const = 0;
+
+	/** False once the client has disconnected */
+	virtual bool IsOpen() const = 0;
+
+	/** False while the previous notification is still waiting to be written */
+	virtual bool IsReady() const = 0;
+
+	/** Queue a notification frame for the client */
+	virtual void Push(const TSharedPtr<FJsonObject>& Notification) = 0;
+};
+
+/**
+ * Pushes editor events to subscribed client connections
+ *
+ * Events are collected per subscription as they happen and sent as a single
+ * notification frame no more often than the subscription's rate allows, so
+ * a burst of edits reaches the client as one coalesced message instead of a
+ * message per edit. A subscription also waits for its previous notification
+ * to be written before sending another, so a client that reads slowly gets
+ * fewer, larger notifications rather than an ever growing backlog. Actor
+ * changes come from the level journal, so a notification carries the same
+ * delta as get_level_changes_since. Editor delegates are bound only while
+ * there are subscriptions. Game thread only.
+ */
+class FMCPEventHub
+{
+public:
+	FMCPEventHub(TSharedPtr<FUnrealMCPEditorCommands> InEditorCommands, float InMaxRate);
+	~FMCPEventHub();
+
+	/**
+	 * Start sending events to a client
+	 * @param Rate - Most notifications per second, clamped to the server's maximum
+	 * @param ActorFields - Fields of each changed actor in actor notifications
+	 * @return The new subscription's id
+	 */
+	int32 Subscribe(const TSharedRef<IMCPEventSink>& Sink, EMCPEventStreams Streams, float Rate, EMCPActorFields ActorFields);
+
+	/** End one of a connection's subscriptions, returns false if it has no subscription with that id */
+	bool Unsubscribe(int32 ConnectionId, int32 SubscriptionId);
+
+	/** End all of a connection's subscriptions, returns how many there were */
+	int32 UnsubscribeAll(int32 ConnectionId);
+
+	/** Highest notification rate a subscription may ask for */
+	float GetMaxRate() const { return MaxRate; }
+
+	/** Read stream names such as "actors" or "pie" */
+	static bool ParseStreams(const TArray<TSharedPtr<FJsonValue>>& Names, EMCPEventStreams& OutStreams, FString& OutError);
+	static TArray<TSharedPtr<FJsonValue>> StreamsToJson(EMCPEventStreams Streams);
+
+private:
+	struct FSubscription
+	{
+		int32 Id = 0;
+		TSharedPtr<IMCPEventSink> Sink;
+		EMCPEventStreams Streams = EMCPEventStreams::None;
+		EMCPActorFields ActorFields;
+		double MinInterval = 0.0;
+		double LastSendTime = 0.0;
+		int32 Sequence = 0;
+
+		/** Last journal version reported to the client */
+		uint64 ActorVersion = 0;
+
+		// Events since the last notification
+		TArray<TWeakObjectPtr<UBlueprint>> CompiledBlueprints;
+		TArray<FName> SavedPackages;
+		TArray<TSharedPtr<FJsonValue>> PIETransitions;
+	};
+
+	/** Core ticker callback, sends whatever each subscription has collected once its interval has passed */
+	bool Tick(float DeltaTime);
+
+	/** Build the subscription's next notification, or null if nothing happened since the last one */
+	TSharedPtr<FJsonObject> MakeNotification(FSubscription& Subscription);
+
+	/** Bind the editor delegates and start ticking while there are subscriptions, and stop once there are none */
+	void UpdateBindings();
+
+	void HandleBlueprintPreCompile(UBlueprint* Blueprint);
+	void HandleBlueprintCompiled();
+	void HandlePackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext SaveContext);
+	void HandlePIEStarted(const bool bIsSimulating);
+	void HandlePIEEnded(const bool bIsSimulating);
+	void AddPIETransition(const TCHAR* State, bool bIsSimulating);
+
+	TArray<FSubscription> Subscriptions;
+	TSharedPtr<FUnrealMCPEditorCommands> EditorCommands;
+	float MaxRate;
+	int32 NextSubscriptionId;
+
+	/** Blueprints between their pre-compile and compiled notifications */
+	TArray<TWeakObjectPtr<UBlueprint>> CompilingBlueprints;
+
+	bool bBound;
+	FTSTicker::FDelegateHandle TickerHandle;
+	FDelegateHandle BlueprintPreCompileHandle;
+	FDelegateHandle BlueprintCompiledHandle;
+	FDelegateHandle PackageSavedHandle;
+	FDelegateHandle PIEStartedHandle;
+	FDelegateHandle PIEEndedHandle;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Splits a TCP byte stream into complete messages.
+ *
+ * Messages are newline-delimited JSON objects. The framer tracks object depth
+ * incrementally instead of searching for the delimiter, so a trailing newline
+ * is optional and older clients that send a bare object without one still work.
+ * Bytes between messages (whitespace, newlines, keep-alive bytes) are skipped.
+ * Messages may arrive split across any number of reads.
+ *
+ * In binary mode each message is instead a 4 byte big-endian length followed
+ * by that many bytes of payload.
+ */
+class UNREALMCP_API FMCPMessageFramer
+{
+public:
+	FMCPMessageFramer();
+
+	/** Append raw bytes received from the socket */
+	void Append(const uint8* Data, int32 NumBytes);
+
+	/**
+	 * Pop the next complete message from the buffer
+	 * @param OutMessage - Receives the UTF-8 decoded message
+	 * @return True if a complete message was available
+	 */
+	bool PopMessage(FString& OutMessage);
+
+	/**
+	 * Pop the next complete binary frame from the buffer, only valid in binary mode
+	 * @param OutPayload - Receives the frame's payload without its length prefix
+	 * @return True if a complete frame was available
+	 */
+	bool PopFrame(TArray<uint8>& OutPayload);
+
+	/** Switch to length-prefixed binary frames, used once a client negotiated the binary wire format */
+	void SetBinary(bool bInBinary);
+	bool IsBinary() const { return bBinary; }
+
+	/** Discard all buffered data and scanning state */
+	void Reset();
+
+	/** Limit how large a single message may grow before the stream is considered invalid */
+	void SetMaxMessageSize(int32 InMaxMessageSize) { MaxMessageSize = InMaxMessageSize; }
+
+	/** True once a message exceeded the size limit; the stream cannot be resynchronized after that */
+	bool IsOverflowed() const { return bOverflowed; }
+
+private:
+	/** Drop the bytes of messages already popped, done once per Append rather than once per message */
+	void Compact();
+
+	TArray<uint8> Buffer;
+	int32 ConsumedBytes;
+	int32 MaxMessageSize;
+	bool bOverflowed;
+	bool bBinary;
+
+	// Scanning state, preserved between Append calls so each byte is only looked at once
+	int32 ScanOffset;
+	int32 MessageStart;
+	int32 Depth;
+	bool bInString;
+	bool bEscaped;
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * First byte a client sends to switch its connection to the binary wire format.
+ * 0xC1 is never used by MessagePack and can't start a UTF-8 JSON document, so it
+ * can't be confused with a JSON request. The server echoes it back to accept.
+ */
+static constexpr uint8 MCPBinaryHandshakeByte = 0xC1;
+
+/**
+ * MessagePack encoding of JSON values, used by the binary wire format
+ * Maps one to one onto the JSON data model, so commands see the same parameter
+ * shapes whichever encoding a client picked. Integral numbers are written as
+ * MessagePack integers and all other numbers as float64.
+ */
+class UNREALMCP_API FMCPMessagePack
+{
+public:
+	/** Append the encoding of an object to Out */
+	static void Encode(const TSharedPtr<FJsonObject>& Object, TArray<uint8>& Out);
+
+	/**
+	 * Decode one object from a complete payload
+	 * @return The object, or null with OutError set if the payload is malformed or isn't a map
+	 */
+	static TSharedPtr<FJsonObject> Decode(const uint8* Data, int32 NumBytes, FString& OutError);
+};
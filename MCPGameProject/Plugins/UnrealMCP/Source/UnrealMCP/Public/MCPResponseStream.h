@@ -0,0 +1,105 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/Archive.h"
+#include <atomic>
+
+class FEvent;
+
+/** Size of the UTF-8 chunks a streamed response is sent in */
+static const int32 MCPResponseStreamChunkSize = 64 * 1024;
+
+/** Queued bytes past which a streamed response is logged as having outrun its client */
+static const int64 MCPResponseStreamWarnQueuedBytes = 16 * MCPResponseStreamChunkSize;
+
+/**
+ * A JSON response sent to the client while its command is still writing it
+ * The command prints its result through FMCPResponseStreamArchive, which
+ * encodes it to UTF-8 in fixed size chunks and hands each one over as soon
+ * as it fills. The connection's writer thread sends chunks as they arrive,
+ * so a large result never exists as a JSON object tree, a TCHAR string and
+ * a UTF-8 copy at the same time. The producer is the game thread, so it
+ * never waits for the writer: a client slower than the command lets chunks
+ * pile up instead, which the peak queued size reports. Once the connection
+ * gives up on the stream it is abandoned, and the producer drops whatever
+ * else it writes. Filled on the game thread and drained by a single writer
+ * thread.
+ */
+class FMCPResponseStream
+{
+public:
+	FMCPResponseStream();
+	~FMCPResponseStream();
+
+	/** Id echoed in the response envelope, set by the connection before anything is written */
+	void SetRequestId(const TSharedPtr<FJsonValue>& InRequestId) { RequestId = InRequestId; }
+	const TSharedPtr<FJsonValue>& GetRequestId() const { return RequestId; }
+
+	/** Queue the next chunk of the response without waiting, dropped if the stream was abandoned */
+	void PushChunk(TArray<uint8>&& Chunk);
+
+	/** Called by the connection when it won't send any more of the response */
+	void Abandon();
+	bool IsAbandoned() const { return bAbandoned; }
+
+	/** Mark the response complete, no chunks may follow */
+	void Finish();
+
+	/** Take the next chunk, returns false if none is waiting */
+	bool PopChunk(TArray<uint8>& OutChunk);
+
+	/** True once the whole response has been queued, some of it may not have been taken yet */
+	bool IsFinished() const { return bFinished; }
+
+	/** Sleep until another chunk is queued or the response completes, or the timeout passes */
+	void Wait(FTimespan Timeout);
+
+	/** Bytes of the whole response */
+	int64 GetTotalBytes() const { return TotalBytes; }
+
+	int32 GetNumChunks() const { return NumChunks; }
+
+	/** Most bytes queued and not yet taken at any one time, the stream's peak memory use */
+	int64 GetPeakQueuedBytes() const { return PeakQueuedBytes; }
+
+private:
+	TQueue<TArray<uint8>, EQueueMode::Spsc> Chunks;
+	FEvent* ChunkEvent;
+	TSharedPtr<FJsonValue> RequestId;
+
+	std::atomic<int64> QueuedBytes;
+	std::atomic<int64> PeakQueuedBytes;
+	std::atomic<int64> TotalBytes;
+	std::atomic<int32> NumChunks;
+	std::atomic<bool> bFinished;
+	std::atomic<bool> bAbandoned;
+};
+
+/**
+ * Archive a TJsonWriter can print to, encoding the TCHARs it writes as
+ * UTF-8 straight into a response stream's chunks
+ */
+class FMCPResponseStreamArchive : public FArchive
+{
+public:
+	explicit FMCPResponseStreamArchive(FMCPResponseStream& InStream, int32 InChunkSize = MCPResponseStreamChunkSize);
+
+	// FArchive interface
+	virtual void Serialize(void* Data, int64 Num) override;
+	virtual FString GetArchiveName() const override { return TEXT("FMCPResponseStreamArchive"); }
+
+	/** Terminate the message with a newline, hand over the last partial chunk and complete the stream */
+	void Finish();
+
+private:
+	void AppendCodePoint(uint32 CodePoint);
+
+	FMCPResponseStream& Stream;
+	TArray<uint8> Chunk;
+	int32 ChunkSize;
+
+	/** First half of a UTF-16 surrogate pair whose second half hasn't been written yet */
+	uint32 PendingHighSurrogate;
+};
@@ -4,16 +4,32 @@
 #include "HAL/Runnable.h"
 #include "Sockets.h"
 #include "Interfaces/IPv4/IPv4Address.h"
+#include <atomic>
 
 class UUnrealMCPBridge;
+class FMCPClientConnection;
+
+/** Server limits, captured from UUnrealMCPSettings on the game thread before the server thread starts */
+struct FMCPServerConfig
+{
+	/** Largest request accepted on a connection, in bytes */
+	int32 MaxMessageSize = 64 * 1024 * 1024;
+
+	/** How long a send may make no progress before the client is considered stalled */
+	float SendTimeoutSeconds = 30.0f;
+
+	/** Number of clients served at once; further connections are refused */
+	int32 MaxConnections = 8;
+};
 
 /**
  * Runnable class for the MCP server thread
+ * Accepts clients and hands each one to its own FMCPClientConnection worker.
  */
 class FMCPServerRunnable : public FRunnable
 {
 public:
-	FMCPServerRunnable(UUnrealMCPBridge* InBridge, TSharedPtr<FSocket> InListenerSocket);
+	FMCPServerRunnable(UUnrealMCPBridge* InBridge, TSharedPtr<FSocket> InListenerSocket, const FMCPServerConfig& InConfig);
 	virtual ~FMCPServerRunnable();
 
 	// FRunnable interface
@@ -23,12 +39,19 @@ public:
 	virtual void Exit() override;
 
 protected:
-	void HandleClientConnection(TSharedPtr<FSocket> ClientSocket);
-	void ProcessMessage(TSharedPtr<FSocket> Client, const FString& Message);
+	/** Start a worker for a newly accepted client, or refuse it when the server is full */
+	void AcceptClient(TSharedPtr<FSocket> InClientSocket);
+
+	/** Destroy workers whose clients have disconnected */
+	void ReapFinishedConnections();
 
 private:
 	UUnrealMCPBridge* Bridge;
 	TSharedPtr<FSocket> ListenerSocket;
-	TSharedPtr<FSocket> ClientSocket;
-	bool bRunning;
-}; 
\ No newline at end of file
+	TArray<TUniquePtr<FMCPClientConnection>> Connections;
+	FMCPServerConfig Config;
+	int32 NextConnectionId;
+
+	/** Cleared by Stop on the stopping thread, read by Run on the server thread */
+	std::atomic<bool> bRunning;
+};
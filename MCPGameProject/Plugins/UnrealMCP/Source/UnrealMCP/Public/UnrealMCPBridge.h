@@ -13,9 +13,20 @@
 #include "Commands/UnrealMCPBlueprintNodeCommands.h"
 #include "Commands/UnrealMCPProjectCommands.h"
 #include "Commands/UnrealMCPUMGCommands.h"
+#include "Commands/UnrealMCPCommandRegistry.h"
+#include "MCPCommandQueue.h"
+#include "MCPEventHub.h"
+#include "MCPResponseStream.h"
+#include "MCPServerRunnable.h"
 #include "UnrealMCPBridge.generated.h"
 
-class FMCPServerRunnable;
+struct FMCPBatchState;
+
+/** Receives the response envelope of a command once it has executed */
+using FMCPCommandCallback = TUniqueFunction<void(TSharedPtr<FJsonObject> Response)>;
+
+/** Receives a streamed response before its command starts writing it, the stream is finished when the command completes */
+using FMCPStreamCallback = TUniqueFunction<void(const TSharedRef<FMCPResponseStream>& Stream)>;
 
 /**
  * Editor subsystem for MCP Bridge
@@ -42,15 +53,72 @@ public:
 	bool IsRunning() const { return bIsRunning; }
 
 	// Command execution
-	FString ExecuteCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+	/**
+	 * Execute a command without blocking the calling thread
+	 * @param OnComplete - Called on the game thread with the response envelope
+	 * @param Priority - Command queue lane, Default puts batches in the bulk lane and everything else in the interactive one
+	 * @param OrderingKey - Optional extra key; commands sharing it are never reordered across lanes
+	 * @param EventSink - The client connection sending the command, where subscribe delivers its notifications
+	 * @param OnStream - Set by callers that accept a streamed JSON response, called instead of OnComplete when the command streams its result
+	 */
+	void ExecuteCommandAsync(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FMCPCommandCallback OnComplete,
+		EMCPCommandPriority Priority = EMCPCommandPriority::Default, const FString& OrderingKey = FString(),
+		TSharedPtr<IMCPEventSink> EventSink = nullptr, FMCPStreamCallback OnStream = nullptr);
+
+	/** True for commands that touch no UObjects and so can be answered without waiting for the game thread */
+	bool CanExecuteOnAnyThread(const FString& CommandType) const;
+
+	/** Execute an AnyThread command immediately on the calling thread and return its response envelope */
+	TSharedPtr<FJsonObject> ExecuteCommandOnCallingThread(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
 
 private:
+	/** Fill the dispatch table with every command the bridge can execute */
+	void RegisterCommands();
+
+	/** Route a command to its handler on the game thread and build the response envelope */
+	TSharedPtr<FJsonObject> DispatchCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params);
+
+	/**
+	 * Run a command that can stream its result, writing the response envelope around it
+	 * Returns false without running anything for commands that can't stream.
+	 */
+	bool DispatchStreamingCommand(const FString& CommandType, const TSharedPtr<FJsonObject>& Params, FMCPCommandCallback& OnComplete,
+		FMCPStreamCallback& OnStream);
+
+	/** Run the entries of a batch command in order, resolving references to earlier results */
+	TSharedPtr<FJsonObject> HandleBatch(const TSharedPtr<FJsonObject>& Params);
+
+	/** Run batch entries until all are done or the deadline passes, returns true once the batch is finished */
+	bool StepBatch(FMCPBatchState& State, double DeadlineSeconds);
+
+	// Server-level commands
+	TSharedPtr<FJsonObject> HandlePing(const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> HandleListCommands(const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> HandleGetQueueStats(const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> HandleSubscribe(const TSharedPtr<FJsonObject>& Params);
+	TSharedPtr<FJsonObject> HandleUnsubscribe(const TSharedPtr<FJsonObject>& Params);
+
 	// Server state
 	bool bIsRunning;
 	TSharedPtr<FSocket> ListenerSocket;
 	TSharedPtr<FSocket> ConnectionSocket;
 	FRunnableThread* ServerThread;
 
+	// Runnable the server thread executes, destroyed once the thread has exited
+	TUniquePtr<FMCPServerRunnable> ServerRunnable;
+
+	// Game thread work submitted by client connections, drained within a per-frame budget
+	TUniquePtr<FMCPCommandQueue> CommandQueue;
+
+	// Guards CommandQueue against get_queue_stats, which reads it off the game thread while the server stops
+	FCriticalSection CommandQueueLock;
+
+	// Editor event notifications for subscribed connections
+	TUniquePtr<FMCPEventHub> EventHub;
+
+	// Connection of the command being dispatched, null for commands that didn't come from a client
+	TSharedPtr<IMCPEventSink> CurrentEventSink;
+
 	// Server configuration
 	FIPv4Address ServerAddress;
 	uint16 Port;
@@ -61,4 +129,7 @@ private:
 	TSharedPtr<FUnrealMCPBlueprintNodeCommands> BlueprintNodeCommands;
 	TSharedPtr<FUnrealMCPProjectCommands> ProjectCommands;
 	TSharedPtr<FUnrealMCPUMGCommands> UMGCommands;
+
+	// Command name to handler dispatch table
+	FUnrealMCPCommandRegistry CommandRegistry;
 }; 
\ No newline at end of file
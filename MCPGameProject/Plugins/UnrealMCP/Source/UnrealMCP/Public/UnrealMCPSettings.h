@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "UnrealMCPSettings.generated.h"
+
+/**
+ * Project settings for the MCP server
+ * Exposed under Project Settings > Plugins > Unreal MCP and stored in DefaultEditor.ini.
+ * Values are read when the server starts.
+ */
+UCLASS(config = Editor, defaultconfig, meta = (DisplayName = "Unreal MCP"))
+class UNREALMCP_API UUnrealMCPSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UUnrealMCPSettings();
+
+	// UDeveloperSettings implementation
+	virtual FName GetCategoryName() const override;
+
+	/** Largest single request the server will buffer, in megabytes. Larger requests close the connection. */
+	UPROPERTY(config, EditAnywhere, Category = "Server", meta = (ClampMin = "1", ClampMax = "2047", UIMin = "1"))
+	int32 MaxMessageSizeMB;
+
+	/** How long sending a response may stall on a client that is not reading before the connection is dropped */
+	UPROPERTY(config, EditAnywhere, Category = "Server", meta = (ClampMin = "1.0", Units = "s"))
+	float SendTimeoutSeconds;
+
+	/** Number of clients served at the same time, each on its own worker thread. Also used as the listen backlog. */
+	UPROPERTY(config, EditAnywhere, Category = "Server", meta = (ClampMin = "1", ClampMax = "64"))
+	int32 MaxConnections;
+
+	/** Game thread time spent on queued commands per editor frame. Lower keeps the editor smoother, higher finishes large workloads sooner. */
+	UPROPERTY(config, EditAnywhere, Category = "Server", meta = (ClampMin = "0.5", ClampMax = "100.0", Units = "ms"))
+	float GameThreadBudgetMs;
+
+	/** Most event notifications per second sent to one subscription. Events in between are merged into the next notification. */
+	UPROPERTY(config, EditAnywhere, Category = "Server", meta = (ClampMin = "0.1", ClampMax = "120.0"))
+	float MaxEventRate;
+
+	/** Seconds after the last Blueprint edit before edited Blueprints are compiled. Edits within a batch always wait for the batch to finish. */
+	UPROPERTY(config, EditAnywhere, Category = "Server", meta = (ClampMin = "0.0", ClampMax = "60.0", Units = "s"))
+	float BlueprintCompileDelaySeconds;
+};
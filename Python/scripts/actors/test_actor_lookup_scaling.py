@@ -0,0 +1,99 @@
+#!/usr/bin/env python
+"""
+Actor lookup scaling benchmark for the Unreal MCP socket server.
+
+Grows the level in steps by spawning throwaway actors, and at each size times
+single-actor commands (get_actor_properties, set_actor_transform) that look
+their target up by name, and a prefix find_actors_by_name. With the actor name
+index the per-command cost should stay flat as the level grows. The spawned
+actors are deleted at the end.
+Run it against an editor with the UnrealMCP plugin loaded and a level open.
+"""
+
+import sys
+import time
+import socket
+import json
+import logging
+import argparse
+
+# Set up logging
+logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(name)s - %(levelname)s - %(message)s')
+logger = logging.getLogger("TestActorLookupScaling")
+
+HOST = "127.0.0.1"
+PORT = 55557
+PREFIX = "MCPLookupBench_"
+
+class Client:
+    """Sends one request at a time over a persistent connection."""
+
+    def __init__(self):
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        self.sock.settimeout(300)
+        self.sock.connect((HOST, PORT))
+        self.buffer = b''
+
+    def send(self, command: str, params: dict) -> dict:
+        self.sock.sendall(json.dumps({"id": 1, "type": command, "params": params}).encode('utf-8') + b'\n')
+        while b'\n' not in self.buffer:
+            chunk = self.sock.recv(65536)
+            if not chunk:
+                raise Exception("Connection closed by server")
+            self.buffer += chunk
+        line, _, self.buffer = self.buffer.partition(b'\n')
+        response = json.loads(line.decode('utf-8'))
+        if response.get("status") != "success":
+            raise Exception(f"{command} failed: {response.get('error')}")
+        return response
+
+    def batch(self, commands: list):
+        # Spread over several requests so no single response gets huge
+        for start in range(0, len(commands), 1000):
+            self.send("batch", {"commands": commands[start:start + 1000], "stop_on_error": False})
+
+    def close(self):
+        self.sock.close()
+
+def time_command(client: Client, command: str, params: dict, iterations: int) -> float:
+    start = time.perf_counter()
+    for _ in range(iterations):
+        client.send(command, params)
+    return (time.perf_counter() - start) * 1000 / iterations
+
+def main():
+    parser = argparse.ArgumentParser(description="Time name-based actor commands as the level grows")
+    parser.add_argument("--sizes", default="100,1000,10000", help="Comma-separated numbers of extra actors to measure at")
+    parser.add_argument("--iterations", type=int, default=100, help="Requests timed per command and size")
+    args = parser.parse_args()
+    sizes = sorted(int(size) for size in args.sizes.split(","))
+
+    client = Client()
+    spawned = 0
+    try:
+        for size in sizes:
+            client.batch([
+                {"type": "spawn_actor", "params": {"type": "PointLight", "name": f"{PREFIX}{i}", "location": [i * 10.0, 0.0, 0.0]}}
+                for i in range(spawned, size)
+            ])
+            spawned = size
+
+            # Target the most recently spawned actor so a linear scan would have to walk the whole level
+            target = f"{PREFIX}{size - 1}"
+            get_ms = time_command(client, "get_actor_properties", {"name": target}, args.iterations)
+            set_ms = time_command(client, "set_actor_transform", {"name": target, "location": [0.0, 0.0, 100.0]}, args.iterations)
+            prefix_ms = time_command(client, "find_actors_by_name", {"pattern": target, "mode": "prefix", "limit": 10}, args.iterations)
+            logger.info(f"{size:>6} extra actors: get_actor_properties {get_ms:.2f} ms, set_actor_transform {set_ms:.2f} ms, "
+                        f"prefix find_actors_by_name {prefix_ms:.2f} ms")
+    except Exception as e:
+        logger.error(f"Test failed: {e}")
+        sys.exit(1)
+    finally:
+        try:
+            client.batch([{"type": "delete_actor", "params": {"name": f"{PREFIX}{i}"}} for i in range(spawned)])
+        finally:
+            client.close()
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,126 @@
+#!/usr/bin/env python
+"""
+Bulk actor benchmark for the Unreal MCP socket server.
+
+Spawns and then moves the same number of throwaway actors three ways: one
+spawn_actor / set_actor_transform request per actor, batches of those, and
+single spawn_actors / set_actor_transforms requests with packed transforms.
+Reports the wall time and request size of each. The spawned actors are deleted
+after each run.
+Run it against an editor with the UnrealMCP plugin loaded and a level open.
+"""
+
+import sys
+import time
+import socket
+import json
+import logging
+import argparse
+
+# Set up logging
+logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(name)s - %(levelname)s - %(message)s')
+logger = logging.getLogger("TestBulkSpawn")
+
+HOST = "127.0.0.1"
+PORT = 55557
+PREFIX = "MCPBulkBench_"
+
+class Client:
+    """Sends one request at a time over a persistent connection."""
+
+    def __init__(self):
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        self.sock.settimeout(600)
+        self.sock.connect((HOST, PORT))
+        self.buffer = b''
+        self.bytes_sent = 0
+
+    def send(self, command: str, params: dict) -> dict:
+        request = json.dumps({"id": 1, "type": command, "params": params}).encode('utf-8') + b'\n'
+        self.bytes_sent += len(request)
+        self.sock.sendall(request)
+        while b'\n' not in self.buffer:
+            chunk = self.sock.recv(65536)
+            if not chunk:
+                raise Exception("Connection closed by server")
+            self.buffer += chunk
+        line, _, self.buffer = self.buffer.partition(b'\n')
+        response = json.loads(line.decode('utf-8'))
+        if response.get("status") != "success":
+            raise Exception(f"{command} failed: {response.get('error')}")
+        return response["result"]
+
+    def close(self):
+        self.sock.close()
+
+def location(i: int, offset: float) -> list:
+    return [(i % 100) * 200.0, (i // 100) * 200.0, offset]
+
+def run_single(client: Client, count: int):
+    for i in range(count):
+        client.send("spawn_actor", {"type": "StaticMeshActor", "name": f"{PREFIX}{i}", "location": location(i, 0.0)})
+    for i in range(count):
+        client.send("set_actor_transform", {"name": f"{PREFIX}{i}", "location": location(i, 100.0)})
+
+def run_batched(client: Client, count: int):
+    for start in range(0, count, 1000):
+        client.send("batch", {"commands": [
+            {"type": "spawn_actor", "params": {"type": "StaticMeshActor", "name": f"{PREFIX}{i}", "location": location(i, 0.0)}}
+            for i in range(start, min(start + 1000, count))
+        ]})
+    for start in range(0, count, 1000):
+        client.send("batch", {"commands": [
+            {"type": "set_actor_transform", "params": {"name": f"{PREFIX}{i}", "location": location(i, 100.0)}}
+            for i in range(start, min(start + 1000, count))
+        ]})
+
+def run_bulk(client: Client, count: int):
+    names = [f"{PREFIX}{i}" for i in range(count)]
+    transforms = []
+    for i in range(count):
+        transforms += location(i, 0.0) + [0.0, 0.0, 0.0] + [1.0, 1.0, 1.0]
+    result = client.send("spawn_actors", {"type": "StaticMeshActor", "names": names, "transforms": transforms})
+    if result["failed"]:
+        raise Exception(f"spawn_actors failed for {result['failed']} actors: {result['errors'][:3]}")
+    locations = [value for i in range(count) for value in location(i, 100.0)]
+    result = client.send("set_actor_transforms", {"names": names, "locations": locations})
+    if result["failed"]:
+        raise Exception(f"set_actor_transforms failed for {result['failed']} actors: {result['errors'][:3]}")
+
+def cleanup(client: Client, count: int):
+    for start in range(0, count, 1000):
+        client.send("batch", {"commands": [
+            {"type": "delete_actor", "params": {"name": f"{PREFIX}{i}"}}
+            for i in range(start, min(start + 1000, count))
+        ], "stop_on_error": False})
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare per-actor, batched and bulk actor commands")
+    parser.add_argument("--count", type=int, default=2000, help="Actors spawned and moved per run")
+    parser.add_argument("--skip-single", action="store_true", help="Skip the slow one-request-per-actor run")
+    args = parser.parse_args()
+
+    runs = [("batched", run_batched), ("bulk", run_bulk)]
+    if not args.skip_single:
+        runs.insert(0, ("single", run_single))
+
+    client = Client()
+    try:
+        for label, run in runs:
+            sent = client.bytes_sent
+            start = time.perf_counter()
+            try:
+                run(client, args.count)
+                elapsed_ms = (time.perf_counter() - start) * 1000
+                logger.info(f"{label:>8}: {elapsed_ms:10.1f} ms, {client.bytes_sent - sent:>10} bytes sent for {args.count} actors")
+            finally:
+                cleanup(client, args.count)
+    except Exception as e:
+        logger.error(f"Test failed: {e}")
+        sys.exit(1)
+    finally:
+        client.close()
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,135 @@
+#!/usr/bin/env python
+"""
+Spatial query benchmark for the Unreal MCP socket server.
+
+Spawns a grid of throwaway actors, then answers "which actors are within this
+radius" two ways: by pulling every actor with get_actors_in_level and
+filtering on the client, and with find_actors_in_radius. It reports the time
+and bytes received for each, checks that both agree, and times the other
+spatial queries. The spawned actors are deleted at the end.
+Run it against an editor with the UnrealMCP plugin loaded and a level open.
+"""
+
+import sys
+import time
+import math
+import socket
+import json
+import logging
+import argparse
+
+# Set up logging
+logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(name)s - %(levelname)s - %(message)s')
+logger = logging.getLogger("TestSpatialQueries")
+
+HOST = "127.0.0.1"
+PORT = 55557
+PREFIX = "MCPSpatialBench_"
+SPACING = 200.0
+
+class Client:
+    """Sends one request at a time over a persistent connection."""
+
+    def __init__(self):
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        self.sock.settimeout(300)
+        self.sock.connect((HOST, PORT))
+        self.buffer = b''
+        self.bytes_received = 0
+
+    def send(self, command: str, params: dict) -> dict:
+        self.sock.sendall(json.dumps({"id": 1, "type": command, "params": params}).encode('utf-8') + b'\n')
+        while b'\n' not in self.buffer:
+            chunk = self.sock.recv(65536)
+            if not chunk:
+                raise Exception("Connection closed by server")
+            self.buffer += chunk
+        line, _, self.buffer = self.buffer.partition(b'\n')
+        self.bytes_received += len(line)
+        response = json.loads(line.decode('utf-8'))
+        if response.get("status") != "success":
+            raise Exception(f"{command} failed: {response.get('error')}")
+        return response["result"]
+
+    def batch(self, commands: list):
+        # Spread over several requests so no single response gets huge
+        for start in range(0, len(commands), 1000):
+            self.send("batch", {"commands": commands[start:start + 1000], "stop_on_error": False})
+
+    def close(self):
+        self.sock.close()
+
+def measure(client: Client, func) -> tuple:
+    received = client.bytes_received
+    start = time.perf_counter()
+    result = func()
+    return result, (time.perf_counter() - start) * 1000, client.bytes_received - received
+
+def all_actors_in_radius(client: Client, center: list, radius: float) -> set:
+    """The client-side approach: page through every actor and keep the close ones."""
+    names = set()
+    cursor = ""
+    while True:
+        params = {"fields": ["name", "location"], "limit": 10000}
+        if cursor:
+            params["cursor"] = cursor
+        page = client.send("get_actors_in_level", params)
+        for actor in page["actors"]:
+            if math.dist(actor["location"], center) <= radius:
+                names.add(actor["name"])
+        cursor = page.get("next_cursor")
+        if not cursor:
+            return names
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare spatial queries against filtering the full actor list")
+    parser.add_argument("--grid", type=int, default=100, help="Actors per side of the spawned grid")
+    parser.add_argument("--radius", type=float, default=1000.0, help="Query radius in world units")
+    args = parser.parse_args()
+
+    client = Client()
+    count = args.grid * args.grid
+    try:
+        client.batch([
+            {"type": "spawn_actor", "params": {
+                "type": "PointLight",
+                "name": f"{PREFIX}{i}",
+                "location": [(i % args.grid) * SPACING, (i // args.grid) * SPACING, 0.0]
+            }}
+            for i in range(count)
+        ])
+        center = [args.grid * SPACING / 2, args.grid * SPACING / 2, 0.0]
+        logger.info(f"Spawned {count} actors, querying radius {args.radius} around {center}")
+
+        expected, full_ms, full_bytes = measure(client, lambda: all_actors_in_radius(client, center, args.radius))
+        logger.info(f"get_actors_in_level + filter: {full_ms:8.2f} ms, {full_bytes:>10} bytes, {len(expected)} actors")
+
+        result, query_ms, query_bytes = measure(client, lambda: client.send("find_actors_in_radius", {
+            "center": center, "radius": args.radius, "fields": ["name"], "limit": 10000
+        }))
+        logger.info(f"find_actors_in_radius:        {query_ms:8.2f} ms, {query_bytes:>10} bytes, {len(result['actors'])} actors")
+
+        # Radius queries measure to the bounds, which include editor sprites, so they may find a few more
+        missing = {name for name in expected if name.startswith(PREFIX)} - {actor["name"] for actor in result["actors"]}
+        if missing:
+            raise Exception(f"find_actors_in_radius missed {len(missing)} actors, e.g. {sorted(missing)[:5]}")
+
+        for command, params in [
+            ("find_actors_in_box", {"min": [0, 0, -100], "max": [args.radius, args.radius, 100], "fields": ["name"]}),
+            ("find_nearest_actors", {"location": center, "count": 10, "fields": ["name"]}),
+            ("find_actors_on_ray", {"origin": [-1000.0, SPACING, 0.0], "direction": [1, 0, 0], "limit": 5, "fields": ["name"]}),
+        ]:
+            result, elapsed_ms, received = measure(client, lambda: client.send(command, params))
+            logger.info(f"{command + ':':<29} {elapsed_ms:8.2f} ms, {received:>10} bytes, {len(result['actors'])} actors")
+    except Exception as e:
+        logger.error(f"Test failed: {e}")
+        sys.exit(1)
+    finally:
+        try:
+            client.batch([{"type": "delete_actor", "params": {"name": f"{PREFIX}{i}"}} for i in range(count)])
+        finally:
+            client.close()
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,76 @@
+#!/usr/bin/env python
+"""
+Concurrent client test for the Unreal MCP socket server.
+
+Opens several persistent connections at once and has each one send a stream
+of `ping` commands, checking that every client is served while the others
+stay connected. Run it against an editor with the UnrealMCP plugin loaded.
+"""
+
+import sys
+import time
+import socket
+import json
+import logging
+import argparse
+import threading
+from typing import List
+
+# Set up logging
+logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(name)s - %(levelname)s - %(message)s')
+logger = logging.getLogger("TestConcurrentClients")
+
+HOST = "127.0.0.1"
+PORT = 55557
+
+def run_client(client_id: int, count: int, errors: List[str]):
+    """Send count pings over one connection, recording any failure."""
+    sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    sock.settimeout(10)
+    try:
+        sock.connect((HOST, PORT))
+        buffer = b''
+        for i in range(count):
+            sock.sendall(json.dumps({"type": "ping", "params": {"echo": f"{client_id}:{i}"}}).encode('utf-8') + b'\n')
+            while b'\n' not in buffer:
+                chunk = sock.recv(4096)
+                if not chunk:
+                    raise Exception("Connection closed by server")
+                buffer += chunk
+            line, _, buffer = buffer.partition(b'\n')
+            response = json.loads(line.decode('utf-8'))
+            if response.get("status") != "success":
+                raise Exception(response.get("error"))
+            if response.get("result", {}).get("echo") != f"{client_id}:{i}":
+                raise Exception(f"Response {i} does not match its request")
+    except Exception as e:
+        errors.append(f"client {client_id}: {e}")
+    finally:
+        sock.close()
+
+def main():
+    parser = argparse.ArgumentParser(description="Serve several MCP clients at the same time")
+    parser.add_argument("--clients", type=int, default=4, help="Number of simultaneous connections")
+    parser.add_argument("--count", type=int, default=100, help="Pings sent by each client")
+    args = parser.parse_args()
+
+    errors: List[str] = []
+    threads = [threading.Thread(target=run_client, args=(i, args.count, errors)) for i in range(args.clients)]
+
+    start = time.perf_counter()
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    elapsed = time.perf_counter() - start
+
+    if errors:
+        for error in errors:
+            logger.error(error)
+        sys.exit(1)
+
+    logger.info(f"{args.clients} clients x {args.count} pings completed in {elapsed:.2f} s")
+
+if __name__ == "__main__":
+    main()
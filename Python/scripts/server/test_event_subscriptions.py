@@ -0,0 +1,158 @@
+#!/usr/bin/env python
+"""
+Event subscription test for the Unreal MCP socket server.
+
+One connection spawns a throwaway actor and moves it repeatedly while a second
+connection watches for the moves two ways: polling get_level_changes_since at
+a fixed interval, and subscribing to actor events. Reports how long each takes
+to see a move and how many requests it sent, and checks that a burst of moves
+is merged into few notifications. The actor is deleted at the end.
+Run it against an editor with the UnrealMCP plugin loaded and a level open.
+"""
+
+import sys
+import time
+import socket
+import json
+import logging
+import argparse
+import statistics
+
+# Set up logging
+logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(name)s - %(levelname)s - %(message)s')
+logger = logging.getLogger("TestEventSubscriptions")
+
+HOST = "127.0.0.1"
+PORT = 55557
+ACTOR_NAME = "MCPEventBench_Actor"
+
+class Client:
+    """A connection that sets notifications aside while it waits for responses."""
+
+    def __init__(self):
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        self.sock.settimeout(30)
+        self.sock.connect((HOST, PORT))
+        self.buffer = b''
+        self.notifications = []
+        self.requests = 0
+
+    def read(self) -> dict:
+        while b'\n' not in self.buffer:
+            chunk = self.sock.recv(65536)
+            if not chunk:
+                raise Exception("Connection closed by server")
+            self.buffer += chunk
+        line, _, self.buffer = self.buffer.partition(b'\n')
+        return json.loads(line.decode('utf-8'))
+
+    def send(self, command: str, params: dict) -> dict:
+        self.requests += 1
+        self.sock.sendall(json.dumps({"id": 1, "type": command, "params": params}).encode('utf-8') + b'\n')
+        while True:
+            message = self.read()
+            if "notification" in message:
+                self.notifications.append((time.perf_counter(), message))
+                continue
+            if message.get("status") != "success":
+                raise Exception(f"{command} failed: {message.get('error')}")
+            return message["result"]
+
+    def wait_notification(self, timeout: float) -> tuple:
+        if self.notifications:
+            return self.notifications.pop(0)
+        self.sock.settimeout(timeout)
+        try:
+            message = self.read()
+        finally:
+            self.sock.settimeout(30)
+        if "notification" not in message:
+            raise Exception(f"Expected a notification, got {message}")
+        return time.perf_counter(), message
+
+    def close(self):
+        self.sock.close()
+
+def move(editor: Client, i: int):
+    editor.send("set_actor_transform", {"name": ACTOR_NAME, "location": [i * 10.0, 0.0, 0.0]})
+
+def moved(changes: list) -> bool:
+    return any(change["name"] == ACTOR_NAME and change.get("transformed") for change in changes)
+
+def run_polling(editor: Client, watcher: Client, moves: int, interval: float) -> list:
+    state = watcher.send("get_actors_in_level", {"fields": ["name"], "limit": 1})
+    journal, version = state["journal"], state["version"]
+    latencies = []
+    for i in range(moves):
+        move(editor, i)
+        moved_at = time.perf_counter()
+        while True:
+            result = watcher.send("get_level_changes_since", {"journal": journal, "version": version, "fields": ["name"]})
+            version = result["version"]
+            if moved(result["changes"]):
+                latencies.append((time.perf_counter() - moved_at) * 1000)
+                break
+            time.sleep(interval)
+    return latencies
+
+def run_push(editor: Client, watcher: Client, moves: int) -> list:
+    latencies = []
+    for i in range(moves):
+        move(editor, i)
+        moved_at = time.perf_counter()
+        while True:
+            received_at, notification = watcher.wait_notification(5.0)
+            if moved(notification.get("actors", {}).get("changes", [])):
+                latencies.append((received_at - moved_at) * 1000)
+                break
+    return latencies
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare polling with pushed actor change notifications")
+    parser.add_argument("--moves", type=int, default=50, help="Moves watched per approach")
+    parser.add_argument("--poll-interval", type=float, default=0.05, help="Seconds between polls")
+    parser.add_argument("--burst", type=int, default=200, help="Moves in the coalescing check")
+    args = parser.parse_args()
+
+    editor = Client()
+    watcher = Client()
+    try:
+        editor.send("spawn_actor", {"type": "StaticMeshActor", "name": ACTOR_NAME})
+
+        sent = watcher.requests
+        latencies = run_polling(editor, watcher, args.moves, args.poll_interval)
+        logger.info(f"polling: median {statistics.median(latencies):7.1f} ms to notice a move, {watcher.requests - sent} requests")
+
+        subscription = watcher.send("subscribe", {"events": ["actors"], "fields": ["name"]})
+        logger.info(f"Subscribed: {subscription}")
+        sent = watcher.requests
+        latencies = run_push(editor, watcher, args.moves)
+        logger.info(f"push:    median {statistics.median(latencies):7.1f} ms to notice a move, {watcher.requests - sent} requests")
+
+        # A burst of moves should arrive as a handful of notifications, each naming the actor once
+        for i in range(args.burst):
+            move(editor, i)
+        time.sleep(1.0)
+        watcher.send("ping", {})
+        received = watcher.notifications
+        for _, notification in received:
+            names = [change["name"] for change in notification.get("actors", {}).get("changes", [])]
+            if len(names) != len(set(names)):
+                raise Exception(f"Notification {notification['sequence']} repeats an actor")
+        logger.info(f"burst:   {args.burst} moves arrived as {len(received)} notifications "
+                    f"at most {subscription['max_rate']} per second")
+
+        watcher.send("unsubscribe", {})
+    except Exception as e:
+        logger.error(f"Test failed: {e}")
+        sys.exit(1)
+    finally:
+        try:
+            editor.send("delete_actor", {"name": ACTOR_NAME})
+        finally:
+            editor.close()
+            watcher.close()
+
+if __name__ == "__main__":
+    main()
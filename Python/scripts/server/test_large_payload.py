@@ -0,0 +1,96 @@
+#!/usr/bin/env python
+"""
+Large payload test for the Unreal MCP socket server.
+
+Sends a `ping` whose `echo` parameter carries a multi-megabyte string over a
+single newline-framed connection and checks that the server returns it
+unchanged. Run it against an editor with the UnrealMCP plugin loaded. The
+payload must fit under the Max Message Size project setting (64 MB by default).
+"""
+
+import sys
+import time
+import socket
+import json
+import logging
+import argparse
+import random
+import string
+
+# Set up logging
+logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(name)s - %(levelname)s - %(message)s')
+logger = logging.getLogger("TestLargePayload")
+
+HOST = "127.0.0.1"
+PORT = 55557
+
+def make_payload(size_mb: int) -> str:
+    """Build a printable payload of roughly size_mb megabytes."""
+    block = ''.join(random.choice(string.ascii_letters + string.digits) for _ in range(4096))
+    repeats = (size_mb * 1024 * 1024) // len(block)
+    return block * repeats
+
+def receive_line(sock: socket.socket) -> bytes:
+    """Read one newline-terminated response without rescanning the whole buffer."""
+    buffer = bytearray()
+    while True:
+        chunk = sock.recv(1024 * 1024)
+        if not chunk:
+            raise Exception("Connection closed before the response completed")
+        scan_from = len(buffer)
+        buffer += chunk
+        delimiter = buffer.find(b'\n', scan_from)
+        if delimiter >= 0:
+            return bytes(buffer[:delimiter])
+
+def round_trip(payload: str, timeout: float) -> bool:
+    """Send the payload and verify the echo, returning True on success."""
+    request = json.dumps({"type": "ping", "params": {"echo": payload}}).encode('utf-8') + b'\n'
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    sock.settimeout(timeout)
+    try:
+        sock.connect((HOST, PORT))
+
+        start = time.perf_counter()
+        sock.sendall(request)
+        sent = time.perf_counter()
+        data = receive_line(sock)
+        done = time.perf_counter()
+    finally:
+        sock.close()
+
+    response = json.loads(data.decode('utf-8'))
+    if response.get("status") != "success":
+        logger.error(f"Server returned an error: {response.get('error')}")
+        return False
+
+    echo = response.get("result", {}).get("echo")
+    if echo != payload:
+        logger.error(f"Echo mismatch: sent {len(payload)} chars, received {len(echo or '')}")
+        return False
+
+    logger.info(f"Request {len(request) / (1024 * 1024):.1f} MB sent in {(sent - start) * 1000:.0f} ms, "
+                f"response {len(data) / (1024 * 1024):.1f} MB received in {(done - sent) * 1000:.0f} ms")
+    return True
+
+def main():
+    parser = argparse.ArgumentParser(description="Round-trip a large payload through the MCP server")
+    parser.add_argument("--size-mb", type=int, default=50, help="Payload size in megabytes")
+    parser.add_argument("--iterations", type=int, default=1, help="Number of round trips")
+    parser.add_argument("--timeout", type=float, default=60.0, help="Socket timeout in seconds")
+    args = parser.parse_args()
+
+    payload = make_payload(args.size_mb)
+    for i in range(args.iterations):
+        try:
+            if not round_trip(payload, args.timeout):
+                sys.exit(1)
+        except Exception as e:
+            logger.error(f"Round trip {i + 1} failed: {e}")
+            sys.exit(1)
+
+    logger.info(f"{args.iterations} round trip(s) of {args.size_mb} MB succeeded")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,98 @@
+#!/usr/bin/env python
+"""
+Latency test for the Unreal MCP socket server.
+
+Sends a series of `ping` commands and reports p50/p99 round-trip times.
+Run it against an editor with the UnrealMCP plugin loaded to compare
+server changes before and after.
+"""
+
+import sys
+import time
+import socket
+import json
+import logging
+import argparse
+from typing import List
+
+# Set up logging
+logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(name)s - %(levelname)s - %(message)s')
+logger = logging.getLogger("TestPingLatency")
+
+HOST = "127.0.0.1"
+PORT = 55557
+
+def ping_once() -> float:
+    """Send a single ping and return the round-trip time in milliseconds."""
+    start = time.perf_counter()
+    sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    sock.settimeout(5)
+    try:
+        sock.connect((HOST, PORT))
+        sock.sendall(json.dumps({"type": "ping", "params": {}}).encode('utf-8'))
+
+        chunks = []
+        while True:
+            chunk = sock.recv(4096)
+            if not chunk:
+                break
+            chunks.append(chunk)
+            try:
+                json.loads(b''.join(chunks).decode('utf-8'))
+                break
+            except json.JSONDecodeError:
+                continue
+    finally:
+        sock.close()
+    return (time.perf_counter() - start) * 1000.0
+
+def ping_persistent(count: int) -> List[float]:
+    """Send pings over a single newline-framed connection, returning each round-trip in milliseconds."""
+    samples = []
+    sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    sock.settimeout(5)
+    try:
+        sock.connect((HOST, PORT))
+        buffer = b''
+        for _ in range(count):
+            start = time.perf_counter()
+            sock.sendall(json.dumps({"type": "ping", "params": {}}).encode('utf-8') + b'\n')
+            while b'\n' not in buffer:
+                chunk = sock.recv(4096)
+                if not chunk:
+                    raise Exception("Connection closed by server")
+                buffer += chunk
+            _, _, buffer = buffer.partition(b'\n')
+            samples.append((time.perf_counter() - start) * 1000.0)
+    finally:
+        sock.close()
+    return samples
+
+def percentile(samples: List[float], pct: float) -> float:
+    """Return the given percentile (0-100) of the samples."""
+    ordered = sorted(samples)
+    index = min(len(ordered) - 1, int(round(pct / 100.0 * (len(ordered) - 1))))
+    return ordered[index]
+
+def main():
+    parser = argparse.ArgumentParser(description="Measure ping round-trip latency")
+    parser.add_argument("--count", type=int, default=200, help="Number of pings to send")
+    parser.add_argument("--persistent", action="store_true", help="Reuse one connection for every ping")
+    args = parser.parse_args()
+
+    try:
+        if args.persistent:
+            samples = ping_persistent(args.count)
+        else:
+            samples = [ping_once() for _ in range(args.count)]
+    except Exception as e:
+        logger.error(f"Ping failed: {e}")
+        sys.exit(1)
+
+    logger.info(f"ping x{len(samples)}: p50={percentile(samples, 50):.2f} ms, "
+                f"p99={percentile(samples, 99):.2f} ms, max={max(samples):.2f} ms")
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,90 @@
+#!/usr/bin/env python
+"""
+Pipelining test for the Unreal MCP socket server.
+
+Writes a burst of `ping` requests tagged with ids on one connection without
+waiting for replies, then reads the responses and matches them back up by id.
+Compares the total time against sending the same requests one at a time.
+Run it against an editor with the UnrealMCP plugin loaded.
+"""
+
+import sys
+import time
+import socket
+import json
+import logging
+import argparse
+
+# Set up logging
+logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(name)s - %(levelname)s - %(message)s')
+logger = logging.getLogger("TestPipelining")
+
+HOST = "127.0.0.1"
+PORT = 55557
+
+class LineReader:
+    """Reads newline-delimited responses off a socket."""
+
+    def __init__(self, sock: socket.socket):
+        self.sock = sock
+        self.buffer = b''
+
+    def read(self) -> dict:
+        while b'\n' not in self.buffer:
+            chunk = self.sock.recv(65536)
+            if not chunk:
+                raise Exception("Connection closed by server")
+            self.buffer += chunk
+        line, _, self.buffer = self.buffer.partition(b'\n')
+        return json.loads(line.decode('utf-8'))
+
+def request(request_id: int) -> bytes:
+    return json.dumps({"id": request_id, "type": "ping", "params": {"echo": str(request_id)}}).encode('utf-8') + b'\n'
+
+def run_sequential(sock: socket.socket, reader: LineReader, count: int) -> float:
+    start = time.perf_counter()
+    for i in range(count):
+        sock.sendall(request(i))
+        response = reader.read()
+        if response.get("id") != i:
+            raise Exception(f"Expected response {i}, got {response.get('id')}")
+    return time.perf_counter() - start
+
+def run_pipelined(sock: socket.socket, reader: LineReader, count: int) -> float:
+    start = time.perf_counter()
+    sock.sendall(b''.join(request(count + i) for i in range(count)))
+
+    pending = set(range(count, count * 2))
+    while pending:
+        response = reader.read()
+        response_id = response.get("id")
+        if response_id not in pending:
+            raise Exception(f"Unexpected response id {response_id}")
+        if response.get("result", {}).get("echo") != str(response_id):
+            raise Exception(f"Response {response_id} carries the wrong result")
+        pending.remove(response_id)
+    return time.perf_counter() - start
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare pipelined and sequential requests")
+    parser.add_argument("--count", type=int, default=200, help="Number of requests in each run")
+    args = parser.parse_args()
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    sock.settimeout(10)
+    try:
+        sock.connect((HOST, PORT))
+        reader = LineReader(sock)
+        sequential = run_sequential(sock, reader, args.count)
+        pipelined = run_pipelined(sock, reader, args.count)
+    except Exception as e:
+        logger.error(f"Test failed: {e}")
+        sys.exit(1)
+    finally:
+        sock.close()
+
+    logger.info(f"{args.count} requests: sequential {sequential * 1000:.1f} ms, pipelined {pipelined * 1000:.1f} ms")
+
+if __name__ == "__main__":
+    main()
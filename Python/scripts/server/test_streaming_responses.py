@@ -0,0 +1,178 @@
+#!/usr/bin/env python
+"""
+Streamed response test for the Unreal MCP socket server.
+
+Requests a large get_actors_in_level page (and optionally get_all_nodes for a
+Blueprint) twice: once streamed as the command writes it, and once with
+"stream": false so the server builds the whole response before sending it.
+Reports time to first byte, total time and response size for each, and with
+psutil installed, how far the editor's resident memory rose above where it
+started during the request. Both responses are checked to hold the same data.
+Throwaway actors are spawned first when --spawn is given and deleted at the
+end. Run it against an editor with the UnrealMCP plugin loaded and a level
+open.
+"""
+
+import sys
+import time
+import socket
+import json
+import logging
+import argparse
+import threading
+
+try:
+    import psutil
+except ImportError:
+    psutil = None
+
+# Set up logging
+logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(name)s - %(levelname)s - %(message)s')
+logger = logging.getLogger("TestStreamingResponses")
+
+HOST = "127.0.0.1"
+PORT = 55557
+ACTOR_PREFIX = "MCPStreamBench_"
+
+def send(sock: socket.socket, command: str, params: dict, stream: bool = True) -> tuple:
+    """Send one request and return (response, seconds to first byte, seconds to last byte, bytes)."""
+    request = {"type": command, "params": params}
+    if not stream:
+        request["stream"] = False
+    start = time.perf_counter()
+    sock.sendall(json.dumps(request).encode('utf-8') + b'\n')
+
+    buffer = bytearray()
+    first_byte = None
+    while True:
+        chunk = sock.recv(1024 * 1024)
+        if not chunk:
+            raise Exception("Connection closed before the response completed")
+        if first_byte is None:
+            first_byte = time.perf_counter()
+        scan_from = len(buffer)
+        buffer += chunk
+        if buffer.find(b'\n', scan_from) >= 0:
+            break
+    done = time.perf_counter()
+
+    response = json.loads(buffer.decode('utf-8'))
+    if response.get("status") != "success":
+        raise Exception(f"{command} failed: {response.get('error')}")
+    return response["result"], first_byte - start, done - start, len(buffer)
+
+class MemorySampler:
+    """Samples the editor's resident memory in the background while a request runs."""
+
+    def __init__(self, process):
+        self.process = process
+        self.peak = 0
+        self.running = False
+        self.thread = None
+
+    def __enter__(self):
+        self.baseline = self.process.memory_info().rss
+        self.peak = self.baseline
+        self.running = True
+        self.thread = threading.Thread(target=self._run, daemon=True)
+        self.thread.start()
+        return self
+
+    def __exit__(self, *args):
+        self.running = False
+        self.thread.join()
+
+    def _run(self):
+        while self.running:
+            self.peak = max(self.peak, self.process.memory_info().rss)
+            time.sleep(0.001)
+
+    @property
+    def rise_mb(self) -> float:
+        return (self.peak - self.baseline) / (1024 * 1024)
+
+def find_editor():
+    """The process listening on the MCP port, if psutil can see it."""
+    if psutil is None:
+        return None
+    try:
+        for connection in psutil.net_connections(kind='tcp'):
+            if connection.laddr and connection.laddr.port == PORT and connection.status == psutil.CONN_LISTEN and connection.pid:
+                return psutil.Process(connection.pid)
+    except psutil.AccessDenied:
+        pass
+    return None
+
+def compare(sock: socket.socket, editor, command: str, params: dict, runs: int):
+    """Run a command streamed and unstreamed, alternating, and log the best of each."""
+    results = {}
+    for _ in range(runs):
+        for stream in (False, True):
+            if editor:
+                with MemorySampler(editor) as sampler:
+                    result, first, total, size = send(sock, command, params, stream)
+                rise = sampler.rise_mb
+            else:
+                result, first, total, size = send(sock, command, params, stream)
+                rise = None
+            best = results.get(stream)
+            if best is None or total < best["total"]:
+                results[stream] = {"result": result, "first": first, "total": total, "size": size,
+                                   "rise": rise if best is None or rise is None else min(rise, best["rise"])}
+            elif rise is not None:
+                best["rise"] = min(rise, best["rise"])
+
+    # Only the journal version may move between the two requests
+    whole, streamed = results[False]["result"], results[True]["result"]
+    whole.pop("version", None)
+    streamed.pop("version", None)
+    if whole != streamed:
+        raise Exception(f"{command}: streamed and whole responses differ")
+
+    for stream, label in ((False, "whole   "), (True, "streamed")):
+        entry = results[stream]
+        memory = f", editor memory +{entry['rise']:7.1f} MB" if entry["rise"] is not None else ""
+        logger.info(f"{command} {label}: first byte {entry['first'] * 1000:8.1f} ms, "
+                    f"total {entry['total'] * 1000:8.1f} ms, {entry['size'] / (1024 * 1024):7.2f} MB{memory}")
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare streamed and whole responses for large results")
+    parser.add_argument("--limit", type=int, default=10000, help="Actors per get_actors_in_level page")
+    parser.add_argument("--fields", default="all", help="Comma separated actor fields, or 'all'")
+    parser.add_argument("--spawn", type=int, default=0, help="Throwaway actors to spawn first")
+    parser.add_argument("--blueprint", help="Blueprint whose event graph get_all_nodes should list")
+    parser.add_argument("--runs", type=int, default=3, help="Requests per mode, the best is reported")
+    args = parser.parse_args()
+
+    editor = find_editor()
+    if editor is None:
+        logger.info("psutil unavailable or the editor process not found, memory use won't be reported")
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+    sock.settimeout(120)
+    spawned = []
+    try:
+        sock.connect((HOST, PORT))
+
+        if args.spawn:
+            commands = [{"type": "spawn_actor", "params": {"type": "StaticMeshActor", "name": f"{ACTOR_PREFIX}{i}",
+                                                          "location": [i * 100.0, 0.0, 0.0]}} for i in range(args.spawn)]
+            send(sock, "batch", {"commands": commands})
+            spawned = [command["params"]["name"] for command in commands]
+            logger.info(f"Spawned {len(spawned)} actors")
+
+        fields = args.fields.split(",") if args.fields != "all" else ["all"]
+        compare(sock, editor, "get_actors_in_level", {"limit": args.limit, "fields": fields}, args.runs)
+        if args.blueprint:
+            compare(sock, editor, "get_all_nodes", {"blueprint_name": args.blueprint}, args.runs)
+    except Exception as e:
+        logger.error(f"Test failed: {e}")
+        sys.exit(1)
+    finally:
+        if spawned:
+            send(sock, "batch", {"commands": [{"type": "delete_actor", "params": {"name": name}} for name in spawned]})
+        sock.close()
+
+if __name__ == "__main__":
+    main()
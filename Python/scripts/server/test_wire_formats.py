@@ -0,0 +1,147 @@
+#!/usr/bin/env python
+"""
+Wire format benchmark for the Unreal MCP socket server.
+
+Runs the same read-only commands over a JSON connection and a MessagePack
+connection and compares round-trip time, bytes on the wire, and the client's
+cost to encode requests and decode responses. get_all_nodes is only measured
+when --blueprint names an existing blueprint.
+Run it against an editor with the UnrealMCP plugin loaded; requires the
+msgpack package (pip install msgpack).
+"""
+
+import sys
+import time
+import socket
+import struct
+import json
+import logging
+import argparse
+
+import msgpack
+
+# Set up logging
+logging.basicConfig(level=logging.INFO, format='%(asctime)s - %(name)s - %(levelname)s - %(message)s')
+logger = logging.getLogger("TestWireFormats")
+
+HOST = "127.0.0.1"
+PORT = 55557
+BINARY_HANDSHAKE = b'\xc1'
+
+class Client:
+    """Minimal client for either wire format that counts bytes and codec time."""
+
+    def __init__(self, binary: bool):
+        self.binary = binary
+        self.buffer = b''
+        self.bytes_sent = 0
+        self.bytes_received = 0
+        self.encode_seconds = 0.0
+        self.decode_seconds = 0.0
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        self.sock.settimeout(30)
+        self.sock.connect((HOST, PORT))
+        if binary:
+            self.sock.sendall(BINARY_HANDSHAKE)
+            if self.sock.recv(1) != BINARY_HANDSHAKE:
+                raise Exception("Server did not accept the binary wire format")
+
+    def fill(self, size: int):
+        while len(self.buffer) < size:
+            chunk = self.sock.recv(1 << 20)
+            if not chunk:
+                raise Exception("Connection closed by server")
+            self.buffer += chunk
+
+    def read_raw(self) -> bytes:
+        if self.binary:
+            self.fill(4)
+            (length,) = struct.unpack('>I', self.buffer[:4])
+            self.fill(4 + length)
+            data, self.buffer = self.buffer[4:4 + length], self.buffer[4 + length:]
+            self.bytes_received += 4 + length
+            return data
+        while b'\n' not in self.buffer:
+            chunk = self.sock.recv(1 << 20)
+            if not chunk:
+                raise Exception("Connection closed by server")
+            self.buffer += chunk
+        line, _, self.buffer = self.buffer.partition(b'\n')
+        self.bytes_received += len(line) + 1
+        return line
+
+    def send(self, command: str, params: dict) -> dict:
+        request = {"id": 1, "type": command, "params": params}
+
+        start = time.perf_counter()
+        if self.binary:
+            payload = msgpack.packb(request, use_bin_type=True)
+            data = struct.pack('>I', len(payload)) + payload
+        else:
+            data = json.dumps(request).encode('utf-8') + b'\n'
+        self.encode_seconds += time.perf_counter() - start
+
+        self.sock.sendall(data)
+        self.bytes_sent += len(data)
+        raw = self.read_raw()
+
+        start = time.perf_counter()
+        response = msgpack.unpackb(raw, raw=False) if self.binary else json.loads(raw.decode('utf-8'))
+        self.decode_seconds += time.perf_counter() - start
+
+        if response.get("status") != "success":
+            raise Exception(f"{command} failed: {response.get('error')}")
+        return response
+
+    def close(self):
+        self.sock.close()
+
+def measure(binary: bool, command: str, params: dict, iterations: int) -> dict:
+    client = Client(binary)
+    try:
+        # Warm up so the first call's one-off costs don't skew the average
+        client.send(command, params)
+        client.bytes_sent = client.bytes_received = 0
+        client.encode_seconds = client.decode_seconds = 0.0
+
+        start = time.perf_counter()
+        for _ in range(iterations):
+            client.send(command, params)
+        elapsed = time.perf_counter() - start
+    finally:
+        client.close()
+
+    return {
+        "round_trip_ms": elapsed * 1000 / iterations,
+        "bytes_per_response": client.bytes_received / iterations,
+        "bytes_per_request": client.bytes_sent / iterations,
+        "encode_us": client.encode_seconds * 1e6 / iterations,
+        "decode_us": client.decode_seconds * 1e6 / iterations,
+    }
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare the JSON and MessagePack wire formats")
+    parser.add_argument("--iterations", type=int, default=50, help="Requests per command and format")
+    parser.add_argument("--blueprint", default="", help="Blueprint to dump with get_all_nodes")
+    args = parser.parse_args()
+
+    commands = [("get_actors_in_level", {})]
+    if args.blueprint:
+        commands.append(("get_all_nodes", {"blueprint_name": args.blueprint}))
+
+    try:
+        for command, params in commands:
+            results = {name: measure(name == "msgpack", command, params, args.iterations) for name in ("json", "msgpack")}
+            for name, result in results.items():
+                logger.info(f"{command} [{name:7}] round trip {result['round_trip_ms']:.2f} ms, "
+                            f"response {result['bytes_per_response']:.0f} B, request {result['bytes_per_request']:.0f} B, "
+                            f"client encode {result['encode_us']:.1f} us, decode {result['decode_us']:.1f} us")
+            ratio = results["msgpack"]["bytes_per_response"] / max(results["json"]["bytes_per_response"], 1)
+            logger.info(f"{command}: MessagePack responses are {ratio:.0%} the size of JSON")
+    except Exception as e:
+        logger.error(f"Test failed: {e}")
+        sys.exit(1)
+
+if __name__ == "__main__":
+    main()
@@ -283,6 +283,53 @@ def register_blueprint_tools(mcp: FastMCP):
             logger.error(error_msg)
             return {"success": False, "message": error_msg}
 
+    @mcp.tool()
+    def compile_blueprints(
+        ctx: Context,
+        blueprints: List[str] = None,
+        path: str = None,
+        mode: str = "batched"
+    ) -> Dict[str, Any]:
+        """
+        Compile several Blueprints in dependency order with one request.
+        
+        Args:
+            blueprints: Names of the Blueprints to compile
+            path: Package path pattern like "/Game/Generated/BP_*", or a folder
+            mode: "batched" to compile them together, "sequential" to time each one
+            
+        Returns:
+            Per-Blueprint status, errors and warnings in compile order
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            
+            params = {"mode": mode}
+            if blueprints:
+                params["blueprints"] = blueprints
+            if path:
+                params["path"] = path
+            
+            logger.info(f"Compiling blueprints: {blueprints or path}")
+            response = unreal.send_command("compile_blueprints", params)
+            
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "message": "No response from Unreal Engine"}
+            
+            logger.info(f"Compile blueprints response: {response}")
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error compiling blueprints: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+
     @mcp.tool()
     def set_blueprint_property(
         ctx: Context,
@@ -15,65 +15,322 @@ def register_editor_tools(mcp: FastMCP):
     """Register editor tools with the MCP server."""
     
     @mcp.tool()
-    def get_actors_in_level(ctx: Context) -> List[Dict[str, Any]]:
-        """Get a list of all actors in the current level."""
+    def get_actors_in_level(
+        ctx: Context,
+        limit: int = 1000,
+        cursor: str = "",
+        class_name: str = "",
+        tag: str = "",
+        folder: str = "",
+        bounds_min: List[float] = None,
+        bounds_max: List[float] = None,
+        fields: List[str] = None
+    ) -> Dict[str, Any]:
+        """
+        Get the actors in the current level, one page at a time.
+        
+        Args:
+            limit: Actors per page (1-10000)
+            cursor: The "next_cursor" returned by the previous page
+            class_name: Only actors of this class or a subclass, e.g. "PointLight"
+            tag: Only actors with this tag
+            folder: Only actors in this outliner folder or its subfolders
+            bounds_min: Together with bounds_max, only actors located inside this box
+            bounds_max: See bounds_min
+            fields: Fields to return per actor: name, class, location, rotation, scale,
+                    transform, label, folder, tags, components, properties or all
+                    (default: name, class, transform)
+            
+        Returns:
+            Dict with "actors", "total" matching actors, and "next_cursor" when more pages follow
+        """
         from unreal_mcp_server import get_unreal_connection
         
         try:
             unreal = get_unreal_connection()
             if not unreal:
                 logger.warning("Failed to connect to Unreal Engine")
-                return []
+                return {"actors": [], "total": 0}
+            
+            params = {"limit": limit}
+            if cursor:
+                params["cursor"] = cursor
+            if class_name:
+                params["class"] = class_name
+            if tag:
+                params["tag"] = tag
+            if folder:
+                params["folder"] = folder
+            if bounds_min and bounds_max:
+                params["bounds"] = {"min": bounds_min, "max": bounds_max}
+            if fields:
+                params["fields"] = fields
                 
-            response = unreal.send_command("get_actors_in_level", {})
+            response = unreal.send_command("get_actors_in_level", params)
             
             if not response:
                 logger.warning("No response from Unreal Engine")
-                return []
-                
-            # Log the complete response for debugging
-            logger.info(f"Complete response from Unreal: {response}")
-            
-            # Check response format
-            if "result" in response and "actors" in response["result"]:
-                actors = response["result"]["actors"]
-                logger.info(f"Found {len(actors)} actors in level")
-                return actors
-            elif "actors" in response:
-                actors = response["actors"]
-                logger.info(f"Found {len(actors)} actors in level")
-                return actors
-                
-            logger.warning(f"Unexpected response format: {response}")
-            return []
+                return {"actors": [], "total": 0}
+            
+            if response.get("status") == "error":
+                return {"actors": [], "total": 0, "error": response.get("error")}
+            
+            result = response.get("result", response)
+            logger.info(f"Received {len(result.get('actors', []))} of {result.get('total', 0)} actors")
+            return result
             
         except Exception as e:
             logger.error(f"Error getting actors: {e}")
-            return []
+            return {"actors": [], "total": 0, "error": str(e)}
 
     @mcp.tool()
-    def find_actors_by_name(ctx: Context, pattern: str) -> List[str]:
-        """Find actors by name pattern."""
+    def get_level_changes_since(
+        ctx: Context,
+        version: int,
+        journal: str = "",
+        fields: List[str] = None
+    ) -> Dict[str, Any]:
+        """
+        Get the actors added, removed or modified since an earlier level version.
+        
+        Args:
+            version: The "version" returned by get_actors_in_level or a previous call
+            journal: The "journal" returned with that version
+            fields: Fields to return per actor, as for get_actors_in_level
+            
+        Returns:
+            Dict with the current "journal" and "version", "changes" with one entry per actor,
+            and "resync" if the changes are no longer known and the level must be reloaded
+        """
         from unreal_mcp_server import get_unreal_connection
         
         try:
             unreal = get_unreal_connection()
             if not unreal:
                 logger.warning("Failed to connect to Unreal Engine")
-                return []
-                
-            response = unreal.send_command("find_actors_by_name", {
-                "pattern": pattern
-            })
+                return {"changes": []}
+            
+            params = {"version": version}
+            if journal:
+                params["journal"] = journal
+            if fields:
+                params["fields"] = fields
+            
+            response = unreal.send_command("get_level_changes_since", params)
             
             if not response:
-                return []
-                
-            return response.get("actors", [])
+                return {"changes": []}
+            
+            if response.get("status") == "error":
+                return {"changes": [], "error": response.get("error")}
+            
+            return response.get("result", response)
+            
+        except Exception as e:
+            logger.error(f"Error getting level changes: {e}")
+            return {"changes": [], "error": str(e)}
+
+    @mcp.tool()
+    def find_actors_by_name(
+        ctx: Context,
+        pattern: str,
+        mode: str = "contains",
+        case_sensitive: bool = False,
+        match: List[str] = None,
+        class_name: str = "",
+        limit: int = 1000,
+        fields: List[str] = None
+    ) -> Dict[str, Any]:
+        """
+        Find actors by name, label, folder or tag.
+        
+        Args:
+            pattern: Text to look for
+            mode: "contains", "prefix", "exact", "glob" (* and ?) or "regex". Prefix searches on
+                  names and labels are served from an index and stay fast on huge levels
+            case_sensitive: Match case exactly
+            match: What to match against, any of "name", "label", "folder", "tag" (default: name)
+            class_name: Only actors of this class or a subclass
+            limit: Maximum number of actors to return (1-10000)
+            fields: Fields to return per actor, as for get_actors_in_level
+            
+        Returns:
+            Dict with the matching "actors" and "truncated" if there were more than limit
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.warning("Failed to connect to Unreal Engine")
+                return {"actors": []}
+            
+            params = {"pattern": pattern, "mode": mode, "case_sensitive": case_sensitive, "limit": limit}
+            if match:
+                params["match"] = match
+            if class_name:
+                params["class"] = class_name
+            if fields:
+                params["fields"] = fields
+            
+            response = unreal.send_command("find_actors_by_name", params)
+            
+            if not response:
+                return {"actors": []}
+            
+            if response.get("status") == "error":
+                return {"actors": [], "error": response.get("error")}
+            
+            return response.get("result", response)
             
         except Exception as e:
             logger.error(f"Error finding actors: {e}")
-            return []
+            return {"actors": [], "error": str(e)}
+    
+    @mcp.tool()
+    def run_spatial_query(command: str, params: Dict[str, Any]) -> Dict[str, Any]:
+        """Send a spatial query and return its result, or an empty actor list on failure."""
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.warning("Failed to connect to Unreal Engine")
+                return {"actors": []}
+            
+            response = unreal.send_command(command, params)
+            
+            if not response:
+                logger.warning("No response from Unreal Engine")
+                return {"actors": []}
+            
+            if response.get("status") == "error":
+                return {"actors": [], "error": response.get("error")}
+            
+            return response.get("result", response)
+            
+        except Exception as e:
+            logger.error(f"Error running {command}: {e}")
+            return {"actors": [], "error": str(e)}
+    
+    def add_query_filters(params: Dict[str, Any], class_name: str, fields: Optional[List[str]]) -> Dict[str, Any]:
+        if class_name:
+            params["class"] = class_name
+        if fields:
+            params["fields"] = fields
+        return params
+    
+    @mcp.tool()
+    def find_actors_in_radius(
+        ctx: Context,
+        center: List[float],
+        radius: float,
+        class_name: str = "",
+        limit: int = 1000,
+        fields: List[str] = None
+    ) -> Dict[str, Any]:
+        """
+        Find the actors whose bounds come within a radius of a point.
+        
+        Args:
+            center: The [x, y, z] point to search around
+            radius: Search radius in world units
+            class_name: Only actors of this class or a subclass, e.g. "StaticMeshActor"
+            limit: Maximum number of actors to return (1-10000)
+            fields: Fields to return per actor, as for get_actors_in_level
+            
+        Returns:
+            Dict with "actors" nearest first, each with a "distance", and the "total" number found
+        """
+        params = {"center": center, "radius": radius, "limit": limit}
+        return run_spatial_query("find_actors_in_radius", add_query_filters(params, class_name, fields))
+    
+    @mcp.tool()
+    def find_actors_in_box(
+        ctx: Context,
+        min: List[float],
+        max: List[float],
+        contained: bool = False,
+        class_name: str = "",
+        limit: int = 1000,
+        fields: List[str] = None
+    ) -> Dict[str, Any]:
+        """
+        Find the actors whose bounds overlap an axis-aligned box.
+        
+        Args:
+            min: The [x, y, z] minimum corner of the box
+            max: The [x, y, z] maximum corner of the box
+            contained: Only actors whose bounds lie entirely inside the box
+            class_name: Only actors of this class or a subclass
+            limit: Maximum number of actors to return (1-10000)
+            fields: Fields to return per actor, as for get_actors_in_level
+            
+        Returns:
+            Dict with "actors" in name order and the "total" number found
+        """
+        params = {"min": min, "max": max, "contained": contained, "limit": limit}
+        return run_spatial_query("find_actors_in_box", add_query_filters(params, class_name, fields))
+    
+    @mcp.tool()
+    def find_nearest_actors(
+        ctx: Context,
+        location: List[float],
+        count: int = 1,
+        max_distance: float = 0.0,
+        exclude: List[str] = None,
+        class_name: str = "",
+        fields: List[str] = None
+    ) -> Dict[str, Any]:
+        """
+        Find the actors nearest to a point.
+        
+        Args:
+            location: The [x, y, z] point to measure from
+            count: Number of actors to return
+            max_distance: Ignore actors further away than this, 0 for no limit
+            exclude: Actor names to leave out, e.g. the actor whose neighbours you want
+            class_name: Only actors of this class or a subclass
+            fields: Fields to return per actor, as for get_actors_in_level
+            
+        Returns:
+            Dict with "actors" nearest first, each with the "distance" to its bounds
+        """
+        params = {"location": location, "count": count}
+        if max_distance > 0:
+            params["max_distance"] = max_distance
+        if exclude:
+            params["exclude"] = exclude
+        return run_spatial_query("find_nearest_actors", add_query_filters(params, class_name, fields))
+    
+    @mcp.tool()
+    def find_actors_on_ray(
+        ctx: Context,
+        origin: List[float],
+        direction: List[float],
+        max_distance: float = 1000000.0,
+        limit: int = 1,
+        class_name: str = "",
+        fields: List[str] = None
+    ) -> Dict[str, Any]:
+        """
+        Find the actors whose bounds a ray passes through, nearest first.
+        
+        Tests actor bounding boxes, not collision, so it is a quick placement check rather than a line trace.
+        
+        Args:
+            origin: The [x, y, z] start of the ray
+            direction: The [x, y, z] direction of the ray, need not be normalized
+            max_distance: How far along the ray to look
+            limit: Maximum number of actors to return, 1 for only the first
+            class_name: Only actors of this class or a subclass
+            fields: Fields to return per actor, as for get_actors_in_level
+            
+        Returns:
+            Dict with "actors" in the order the ray enters them, each with "distance" and "hit_location"
+        """
+        params = {"origin": origin, "direction": direction, "max_distance": max_distance, "limit": limit}
+        return run_spatial_query("find_actors_on_ray", add_query_filters(params, class_name, fields))
     
     @mcp.tool()
     def spawn_actor(
@@ -192,9 +449,250 @@ def register_editor_tools(mcp: FastMCP):
             logger.error(f"Error setting transform: {e}")
             return {}
     
+    def send_bulk_actor_command(
+        command: str,
+        actors: Optional[List[Dict[str, Any]]],
+        names: Optional[List[str]],
+        transforms: Optional[List[float]],
+        locations: Optional[List[float]],
+        extra: Dict[str, Any]
+    ) -> Dict[str, Any]:
+        """Send spawn_actors or set_actor_transforms with either per-actor objects or packed arrays."""
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            
+            params = dict(extra)
+            if actors is not None:
+                params["actors"] = actors
+            elif names is not None:
+                params["names"] = names
+                if transforms is not None:
+                    params["transforms"] = [float(value) for value in transforms]
+                elif locations is not None:
+                    params["locations"] = [float(value) for value in locations]
+            else:
+                return {"success": False, "message": "Pass either 'actors' or 'names'"}
+            
+            response = unreal.send_command(command, params)
+            return response or {}
+            
+        except Exception as e:
+            logger.error(f"Error running {command}: {e}")
+            return {"success": False, "message": str(e)}
+    
+    @mcp.tool()
+    def spawn_actors(
+        ctx: Context,
+        type: str = "StaticMeshActor",
+        actors: List[Dict[str, Any]] = None,
+        names: List[str] = None,
+        transforms: List[float] = None,
+        locations: List[float] = None
+    ) -> Dict[str, Any]:
+        """
+        Spawn many actors in one request and one undo step.
+        
+        Either pass "actors" as a list of {"name", "type", "location", "rotation", "scale"} objects,
+        or pass "names" with packed "transforms" (9 numbers per name: location xyz, rotation
+        pitch/yaw/roll, scale xyz) or packed "locations" (3 numbers per name). The packed form is
+        much cheaper to send and parse for thousands of actors.
+        
+        Args:
+            type: Actor type for entries that don't give their own (StaticMeshActor, PointLight, SpotLight, DirectionalLight, CameraActor)
+            actors: Per-actor objects
+            names: Actor names for the packed form
+            transforms: Packed transforms, 9 numbers per name
+            locations: Packed locations, 3 numbers per name
+            
+        Returns:
+            Dict with "spawned" and "failed" counts and an "errors" list of {index, name, error}
+        """
+        return send_bulk_actor_command("spawn_actors", actors, names, transforms, locations, {"type": type})
+    
     @mcp.tool()
-    def get_actor_properties(ctx: Context, name: str) -> Dict[str, Any]:
-        """Get all properties of an actor."""
+    def set_actor_transforms(
+        ctx: Context,
+        actors: List[Dict[str, Any]] = None,
+        names: List[str] = None,
+        transforms: List[float] = None,
+        locations: List[float] = None
+    ) -> Dict[str, Any]:
+        """
+        Set the transforms of many actors in one request and one undo step.
+        
+        Either pass "actors" as a list of {"name", "location", "rotation", "scale"} objects, where
+        omitted parts are left unchanged, or pass "names" with packed "transforms" (9 numbers per
+        name) or packed "locations" (3 numbers per name).
+        
+        Args:
+            actors: Per-actor objects
+            names: Actor names for the packed form
+            transforms: Packed transforms, 9 numbers per name
+            locations: Packed locations, 3 numbers per name
+            
+        Returns:
+            Dict with "updated" and "failed" counts and an "errors" list of {index, name, error}
+        """
+        return send_bulk_actor_command("set_actor_transforms", actors, names, transforms, locations, {})
+    
+    def send_instance_command(command: str, params: Dict[str, Any]) -> Dict[str, Any]:
+        """Send one of the mesh instance commands and return its response."""
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            
+            response = unreal.send_command(command, params)
+            return response or {}
+            
+        except Exception as e:
+            logger.error(f"Error running {command}: {e}")
+            return {"success": False, "message": str(e)}
+    
+    def add_instance_transforms(
+        params: Dict[str, Any],
+        instances: Optional[List[Dict[str, Any]]],
+        transforms: Optional[List[float]],
+        locations: Optional[List[float]]
+    ) -> Dict[str, Any]:
+        if instances is not None:
+            params["instances"] = instances
+        elif transforms is not None:
+            params["transforms"] = [float(value) for value in transforms]
+        elif locations is not None:
+            params["locations"] = [float(value) for value in locations]
+        return params
+    
+    @mcp.tool()
+    def add_mesh_instances(
+        ctx: Context,
+        actor_name: str,
+        static_mesh: str,
+        transforms: List[float] = None,
+        locations: List[float] = None,
+        instances: List[Dict[str, Any]] = None,
+        world_space: bool = True
+    ) -> Dict[str, Any]:
+        """
+        Place many copies of a static mesh as instances on a single actor.
+        
+        Much cheaper than one actor per copy for scattering props. The actor is created if it
+        doesn't exist, and each mesh gets its own instanced component on it.
+        
+        Args:
+            actor_name: Actor holding the instances, created if missing
+            static_mesh: Mesh asset path, e.g. "/Game/Props/SM_Rock"
+            transforms: Packed transforms, 9 numbers per instance (location, rotation, scale)
+            locations: Packed locations, 3 numbers per instance
+            instances: Or a list of {"location", "rotation", "scale"} objects
+            world_space: Transforms are in world space rather than relative to the actor
+            
+        Returns:
+            Dict with the "indices" of the new instances and the "instance_count" of the mesh
+        """
+        params = {"actor_name": actor_name, "static_mesh": static_mesh, "world_space": world_space}
+        return send_instance_command("add_mesh_instances", add_instance_transforms(params, instances, transforms, locations))
+    
+    @mcp.tool()
+    def update_mesh_instances(
+        ctx: Context,
+        actor_name: str,
+        indices: List[int],
+        transforms: List[float] = None,
+        locations: List[float] = None,
+        instances: List[Dict[str, Any]] = None,
+        static_mesh: str = "",
+        world_space: bool = True
+    ) -> Dict[str, Any]:
+        """
+        Set the transforms of mesh instances by index.
+        
+        Args:
+            actor_name: Actor holding the instances
+            indices: Instance indices to update, one per transform
+            transforms: Packed transforms, 9 numbers per index
+            locations: Packed locations, 3 numbers per index
+            instances: Or a list of {"location", "rotation", "scale"} objects, omitted parts are kept
+            static_mesh: Which mesh's instances, needed only when the actor has several
+            world_space: Transforms are in world space rather than relative to the actor
+            
+        Returns:
+            Dict with "updated" and "failed" counts and an "errors" list
+        """
+        params = {"actor_name": actor_name, "indices": indices, "world_space": world_space}
+        if static_mesh:
+            params["static_mesh"] = static_mesh
+        return send_instance_command("update_mesh_instances", add_instance_transforms(params, instances, transforms, locations))
+    
+    @mcp.tool()
+    def remove_mesh_instances(
+        ctx: Context,
+        actor_name: str,
+        indices: List[int],
+        static_mesh: str = ""
+    ) -> Dict[str, Any]:
+        """
+        Remove mesh instances by index. Instances past the new end move into the freed slots.
+        
+        Args:
+            actor_name: Actor holding the instances
+            indices: Instance indices to remove
+            static_mesh: Which mesh's instances, needed only when the actor has several
+            
+        Returns:
+            Dict with "removed" and "failed" counts, an "errors" list, a "moved" list of
+            {"from", "to"} index changes and the remaining "instance_count"
+        """
+        params = {"actor_name": actor_name, "indices": indices}
+        if static_mesh:
+            params["static_mesh"] = static_mesh
+        return send_instance_command("remove_mesh_instances", params)
+    
+    @mcp.tool()
+    def get_mesh_instances(
+        ctx: Context,
+        actor_name: str,
+        static_mesh: str = "",
+        offset: int = 0,
+        limit: int = 1000,
+        world_space: bool = True
+    ) -> Dict[str, Any]:
+        """
+        Read the transforms of an actor's mesh instances, a page at a time.
+        
+        Args:
+            actor_name: Actor holding the instances
+            static_mesh: Which mesh's instances, needed only when the actor has several
+            offset: Index of the first instance to return
+            limit: Number of instances to return (1-10000)
+            world_space: Return world space transforms rather than relative to the actor
+            
+        Returns:
+            Dict with "instance_count" and packed "transforms", 9 numbers per instance starting at "offset"
+        """
+        params = {"actor_name": actor_name, "offset": offset, "limit": limit, "world_space": world_space}
+        if static_mesh:
+            params["static_mesh"] = static_mesh
+        return send_instance_command("get_mesh_instances", params)
+    
+    @mcp.tool()
+    def get_actor_properties(ctx: Context, name: str, fields: List[str] = None) -> Dict[str, Any]:
+        """
+        Get the details of an actor.
+        
+        Args:
+            name: Name of the actor
+            fields: Fields to return, as for get_actors_in_level (default: all, including
+                    components and every editable property as text)
+        """
         from unreal_mcp_server import get_unreal_connection
         
         try:
@@ -203,9 +701,10 @@ def register_editor_tools(mcp: FastMCP):
                 logger.error("Failed to connect to Unreal Engine")
                 return {"success": False, "message": "Failed to connect to Unreal Engine"}
                 
-            response = unreal.send_command("get_actor_properties", {
-                "name": name
-            })
+            params = {"name": name}
+            if fields:
+                params["fields"] = fields
+            response = unreal.send_command("get_actor_properties", params)
             return response or {}
             
         except Exception as e:
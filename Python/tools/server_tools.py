@@ -0,0 +1,238 @@
+"""
+Server Tools for Unreal MCP.
+
+This module provides tools that operate on the MCP connection itself rather than
+on a specific editor subsystem, such as running several commands at once.
+"""
+
+import logging
+from typing import Dict, List, Any
+from mcp.server.fastmcp import FastMCP, Context
+
+# Get logger
+logger = logging.getLogger("UnrealMCP")
+
+def register_server_tools(mcp: FastMCP):
+    """Register server tools with the MCP server."""
+    
+    @mcp.tool()
+    def batch_commands(
+        ctx: Context,
+        commands: List[Dict[str, Any]],
+        stop_on_error: bool = True,
+        priority: str = ""
+    ) -> Dict[str, Any]:
+        """
+        Run several commands in a single round trip to the editor.
+        
+        Commands execute in order on the game thread. A long batch is spread over
+        several editor frames so the editor stays responsive. A string parameter
+        of the form "$<index>.<path>" is replaced by a value from the result of an
+        earlier command, e.g. "$0.node_id" or "$2.nodes.0.id".
+        
+        Args:
+            commands: List of {"type": <command>, "params": {...}} entries
+            stop_on_error: Stop at the first failing command (default: True)
+            priority: "interactive" to run ahead of other queued bulk work, or "bulk" (the default for batches)
+            
+        Returns:
+            Dict with a "results" list holding one response per executed command
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            
+            params = {
+                "commands": commands,
+                "stop_on_error": stop_on_error
+            }
+            
+            logger.info(f"Running batch of {len(commands)} commands")
+            response = unreal.send_command("batch", params, priority=priority or None)
+            
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "message": "No response from Unreal Engine"}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error running batch: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+    
+    @mcp.tool()
+    def list_commands(ctx: Context, category: str = "") -> Dict[str, Any]:
+        """
+        List the commands the Unreal editor can execute.
+        
+        Args:
+            category: Only list commands in this category (editor, blueprint, blueprint_node, project, umg, server)
+            
+        Returns:
+            Dict with a "commands" list of {name, category, description, read_only, thread}
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            
+            params = {"category": category} if category else {}
+            response = unreal.send_command("list_commands", params)
+            
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "message": "No response from Unreal Engine"}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error listing commands: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+    
+    @mcp.tool()
+    def get_queue_stats(ctx: Context) -> Dict[str, Any]:
+        """
+        Report how the editor's game thread command queue is keeping up.
+        
+        Returns:
+            Dict with queue depths per lane, wait times, and frame budget usage
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            
+            response = unreal.send_command("get_queue_stats", {})
+            
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "message": "No response from Unreal Engine"}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error getting queue stats: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+    
+    @mcp.tool()
+    def subscribe_editor_events(
+        ctx: Context,
+        events: List[str] = None,
+        max_rate: float = 0,
+        fields: List[str] = None
+    ) -> Dict[str, Any]:
+        """
+        Have the editor push notifications of editor events, instead of polling for them.
+        
+        Notifications arrive on the open connection and are collected with get_editor_events,
+        which doesn't need a round trip to the editor. Events between notifications are merged,
+        so a burst of edits arrives as one notification. Subscriptions end if the connection drops.
+        
+        Args:
+            events: Streams to receive, any of "actors", "blueprint_compiled", "asset_saved", "pie" (default: all)
+            max_rate: Most notifications per second (default: the editor's Max Event Rate setting)
+            fields: Fields of each changed actor in actor notifications, as for get_actors_in_level
+            
+        Returns:
+            Dict with the "subscription" id, and the level "journal" and "version" actor notifications continue from
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            
+            params = {}
+            if events:
+                params["events"] = events
+            if max_rate > 0:
+                params["max_rate"] = max_rate
+            if fields:
+                params["fields"] = fields
+            response = unreal.send_command("subscribe", params)
+            
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "message": "No response from Unreal Engine"}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error subscribing to editor events: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+    
+    @mcp.tool()
+    def get_editor_events(ctx: Context) -> Dict[str, Any]:
+        """
+        Collect the editor event notifications received since the last call.
+        
+        Returns:
+            Dict with "notifications", oldest first. Each has the "subscription" id, a "sequence" number,
+            and one field per stream with events: "actors" (as returned by get_level_changes_since),
+            "blueprint_compiled", "asset_saved" and "pie"
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            
+            return {"notifications": unreal.poll_notifications()}
+            
+        except Exception as e:
+            error_msg = f"Error collecting editor events: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+    
+    @mcp.tool()
+    def unsubscribe_editor_events(ctx: Context, subscription: int = 0) -> Dict[str, Any]:
+        """
+        Stop event notifications.
+        
+        Args:
+            subscription: Subscription id returned by subscribe_editor_events, or 0 for all of them
+            
+        Returns:
+            Dict with the number of subscriptions "unsubscribed"
+        """
+        from unreal_mcp_server import get_unreal_connection
+        
+        try:
+            unreal = get_unreal_connection()
+            if not unreal:
+                logger.error("Failed to connect to Unreal Engine")
+                return {"success": False, "message": "Failed to connect to Unreal Engine"}
+            
+            params = {"subscription": subscription} if subscription else {}
+            response = unreal.send_command("unsubscribe", params)
+            
+            if not response:
+                logger.error("No response from Unreal Engine")
+                return {"success": False, "message": "No response from Unreal Engine"}
+            
+            return response
+            
+        except Exception as e:
+            error_msg = f"Error unsubscribing from editor events: {e}"
+            logger.error(error_msg)
+            return {"success": False, "message": error_msg}
+    
+    logger.info("Server tools registered successfully")
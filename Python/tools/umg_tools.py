@@ -30,7 +30,8 @@ def register_umg_tools(mcp: FastMCP):
             path: Content browser path where the widget should be created
             
         Returns:
-            Dict containing success status and widget path
+            Dict containing success status, widget path and a handle that
+            other UMG tools accept in place of the widget name
         """
         from unreal_mcp_server import get_unreal_connection
         
@@ -5,11 +5,14 @@ A simple MCP server for interacting with Unreal Engine.
 """
 
 import logging
+import os
 import socket
+import struct
 import sys
 import json
+from collections import deque
 from contextlib import asynccontextmanager
-from typing import AsyncIterator, Dict, Any, Optional
+from typing import AsyncIterator, Dict, Any, List, Optional
 from mcp.server.fastmcp import FastMCP
 
 # Configure logging with more detailed format
@@ -27,6 +30,20 @@ logger = logging.getLogger("UnrealMCP")
 UNREAL_HOST = "127.0.0.1"
 UNREAL_PORT = 55557
 
+# "msgpack" switches to the binary wire format (requires the msgpack package), anything else uses JSON
+UNREAL_WIRE_FORMAT = os.environ.get("UNREAL_MCP_WIRE_FORMAT", "json").lower()
+
+# Sent as the first byte of a connection to request the binary wire format, echoed back by the server to accept
+BINARY_HANDSHAKE = b'\xc1'
+
+# Event notifications kept until a tool collects them; older ones are dropped first
+MAX_BUFFERED_NOTIFICATIONS = 1000
+
+try:
+    import msgpack
+except ImportError:
+    msgpack = None
+
 class UnrealConnection:
     """Connection to an Unreal Engine instance."""
     
@@ -34,6 +51,10 @@ class UnrealConnection:
         """Initialize the connection."""
         self.socket = None
         self.connected = False
+        self.buffer = bytearray()
+        self.next_request_id = 1
+        self.binary = False
+        self.notifications = deque(maxlen=MAX_BUFFERED_NOTIFICATIONS)
     
     def connect(self) -> bool:
         """Connect to the Unreal Engine instance."""
@@ -60,6 +81,12 @@ class UnrealConnection:
             
             self.socket.connect((UNREAL_HOST, UNREAL_PORT))
             self.connected = True
+            self.buffer = bytearray()
+            self.binary = False
+            # Subscriptions belong to the old connection and ended with it
+            self.notifications.clear()
+            if UNREAL_WIRE_FORMAT == "msgpack":
+                self.negotiate_binary()
             logger.info("Connected to Unreal Engine")
             return True
             
@@ -68,6 +95,26 @@ class UnrealConnection:
             self.connected = False
             return False
     
+    def negotiate_binary(self):
+        """Ask the server for the MessagePack wire format, staying on JSON if it doesn't answer."""
+        if msgpack is None:
+            logger.warning("UNREAL_MCP_WIRE_FORMAT=msgpack but the msgpack package is not installed, using JSON")
+            return
+        self.socket.sendall(BINARY_HANDSHAKE)
+        try:
+            self.socket.settimeout(1)
+            ack = self.socket.recv(1)
+        except socket.timeout:
+            # Older servers skip the byte as whitespace between messages, so the connection still works as JSON
+            logger.warning("Server did not accept the binary wire format, using JSON")
+            return
+        finally:
+            self.socket.settimeout(5)
+        if ack != BINARY_HANDSHAKE:
+            raise Exception(f"Unexpected reply to the binary handshake: {ack!r}")
+        self.binary = True
+        logger.info("Using the MessagePack wire format")
+
     def disconnect(self):
         """Disconnect from the Unreal Engine instance."""
         if self.socket:
@@ -77,86 +124,192 @@ class UnrealConnection:
                 pass
         self.socket = None
         self.connected = False
+        self.buffer = bytearray()
 
-    def receive_full_response(self, sock, buffer_size=4096) -> bytes:
-        """Receive a complete response from Unreal, handling chunked data."""
-        chunks = []
+    def receive_full_response(self, sock, buffer_size=65536) -> bytes:
+        """Receive one newline-terminated (or, in binary mode, length-prefixed) response from Unreal."""
         sock.settimeout(5)  # 5 second timeout
         try:
-            while True:
+            if self.binary:
+                return self.receive_frame(sock, buffer_size)
+
+            # Only scan the newly received bytes for the delimiter so large responses stay linear
+            delimiter = self.buffer.find(b'\n')
+            while delimiter < 0:
                 chunk = sock.recv(buffer_size)
                 if not chunk:
-                    if not chunks:
-                        raise Exception("Connection closed before receiving data")
-                    break
-                chunks.append(chunk)
-                
-                # Process the data received so far
-                data = b''.join(chunks)
-                decoded_data = data.decode('utf-8')
-                
-                # Try to parse as JSON to check if complete
-                try:
-                    json.loads(decoded_data)
-                    logger.info(f"Received complete response ({len(data)} bytes)")
-                    return data
-                except json.JSONDecodeError:
-                    # Not complete JSON yet, continue reading
-                    logger.debug(f"Received partial response, waiting for more data...")
-                    continue
-                except Exception as e:
-                    logger.warning(f"Error processing response chunk: {str(e)}")
-                    continue
+                    raise Exception("Connection closed before receiving a complete response")
+                scan_from = len(self.buffer)
+                self.buffer += chunk
+                delimiter = self.buffer.find(b'\n', scan_from)
+
+            # Keep anything after the delimiter for the next response
+            data = bytes(self.buffer[:delimiter])
+            del self.buffer[:delimiter + 1]
+            logger.info(f"Received complete response ({len(data)} bytes)")
+            return data
         except socket.timeout:
             logger.warning("Socket timeout during receive")
-            if chunks:
-                # If we have some data already, try to use it
-                data = b''.join(chunks)
-                try:
-                    json.loads(data.decode('utf-8'))
-                    logger.info(f"Using partial response after timeout ({len(data)} bytes)")
-                    return data
-                except:
-                    pass
-            raise Exception("Timeout receiving Unreal response")
+            raise TimeoutError("Timeout receiving Unreal response")
         except Exception as e:
             logger.error(f"Error during receive: {str(e)}")
             raise
     
-    def send_command(self, command: str, params: Dict[str, Any] = None) -> Optional[Dict[str, Any]]:
-        """Send a command to Unreal Engine and get the response."""
-        # Always reconnect for each command, since Unreal closes the connection after each command
-        # This is different from Unity which keeps connections alive
-        if self.socket:
+    def receive_frame(self, sock, buffer_size) -> bytes:
+        """Receive one length-prefixed binary frame."""
+        def fill(size: int):
+            while len(self.buffer) < size:
+                chunk = sock.recv(max(buffer_size, size - len(self.buffer)))
+                if not chunk:
+                    raise Exception("Connection closed before receiving a complete response")
+                self.buffer += chunk
+
+        fill(4)
+        (length,) = struct.unpack('>I', self.buffer[:4])
+        fill(4 + length)
+        data = bytes(self.buffer[4:4 + length])
+        del self.buffer[:4 + length]
+        logger.info(f"Received complete binary response ({length} bytes)")
+        return data
+
+    def pop_buffered_frame(self) -> Optional[bytes]:
+        """Take one complete message out of the receive buffer without reading the socket."""
+        if self.binary:
+            if len(self.buffer) < 4:
+                return None
+            (length,) = struct.unpack('>I', self.buffer[:4])
+            if len(self.buffer) < 4 + length:
+                return None
+            data = bytes(self.buffer[4:4 + length])
+            del self.buffer[:4 + length]
+            return data
+        delimiter = self.buffer.find(b'\n')
+        if delimiter < 0:
+            return None
+        data = bytes(self.buffer[:delimiter])
+        del self.buffer[:delimiter + 1]
+        return data
+
+    @staticmethod
+    def is_notification(data: bytes) -> bool:
+        """True for event notifications, which the server always starts with their "notification" field."""
+        # Cheaper than decoding every response twice; responses start with "id" or "status"
+        return b'notification' in data[:32]
+
+    def receive_reply(self, sock) -> bytes:
+        """Receive the next response, setting aside any event notifications that arrive before it."""
+        while True:
+            data = self.receive_full_response(sock)
+            if not self.is_notification(data):
+                return data
+            self.notifications.append(self.decode_response(data))
+
+    def poll_notifications(self) -> List[Dict[str, Any]]:
+        """Return the notifications received so far, oldest first, reading whatever the socket has without waiting."""
+        if self.connected and self.socket:
             try:
-                self.socket.close()
-            except:
+                self.socket.setblocking(False)
+                while True:
+                    chunk = self.socket.recv(65536)
+                    if not chunk:
+                        raise ConnectionError("Connection closed by Unreal")
+                    self.buffer += chunk
+            except (BlockingIOError, InterruptedError):
                 pass
-            self.socket = None
-            self.connected = False
+            except Exception as e:
+                logger.warning(f"Connection lost while polling notifications: {e}")
+                self.disconnect()
+            finally:
+                if self.socket:
+                    self.socket.settimeout(5)
+
+            # No request is waiting, so every complete message is a notification
+            while self.connected:
+                data = self.pop_buffered_frame()
+                if data is None:
+                    break
+                self.notifications.append(self.decode_response(data))
+
+        notifications = list(self.notifications)
+        self.notifications.clear()
+        return notifications
+
+    def encode_request(self, command_obj: Dict[str, Any]) -> bytes:
+        """Frame a request for the wire format in use."""
+        if self.binary:
+            payload = msgpack.packb(command_obj, use_bin_type=True)
+            return struct.pack('>I', len(payload)) + payload
+        # Messages are newline-delimited JSON objects
+        return json.dumps(command_obj).encode('utf-8') + b'\n'
+
+    def decode_response(self, data: bytes) -> Dict[str, Any]:
+        if self.binary:
+            return msgpack.unpackb(data, raw=False)
+        return json.loads(data.decode('utf-8'))
+
+    def send_command(self, command: str, params: Dict[str, Any] = None, priority: Optional[str] = None) -> Optional[Dict[str, Any]]:
+        """Send a command to Unreal Engine and get the response.
+
+        The connection is kept open between commands. If it turns out to have
+        dropped, the command is retried once on a fresh connection. Timeouts are
+        not retried since the command may already be executing.
+
+        priority selects the editor's queue lane, "interactive" or "bulk". By
+        default batches are bulk and everything else is interactive.
+        """
+        # Tag each request; the server echoes the id back in the response
+        request_id = self.next_request_id
+        self.next_request_id += 1
+        command_obj = {
+            "id": request_id,
+            "type": command,
+            "params": params or {}
+        }
+        if priority:
+            command_obj["priority"] = priority
         
-        if not self.connect():
-            logger.error("Failed to connect to Unreal Engine for command")
-            return None
+        for attempt in range(2):
+            if not self.connected and not self.connect():
+                logger.error("Failed to connect to Unreal Engine for command")
+                return None
+            
+            try:
+                # Encoded per attempt since a fresh connection may have negotiated a different format
+                request_data = self.encode_request(command_obj)
+                logger.info(f"Sending command: {command} ({len(request_data)} bytes)")
+                self.socket.sendall(request_data)
+                response_data = self.receive_reply(self.socket)
+                break
+            except TimeoutError as e:
+                self.disconnect()
+                return {
+                    "status": "error",
+                    "error": str(e)
+                }
+            except Exception as e:
+                logger.warning(f"Connection error on attempt {attempt + 1}: {e}")
+                self.disconnect()
+                if attempt == 1:
+                    return {
+                        "status": "error",
+                        "error": str(e)
+                    }
         
         try:
-            # Match Unity's command format exactly
-            command_obj = {
-                "type": command,  # Use "type" instead of "command"
-                "params": params or {}  # Use Unity's params or {} pattern
-            }
+            response = self.decode_response(response_data)
             
-            # Send without newline, exactly like Unity
-            command_json = json.dumps(command_obj)
-            logger.info(f"Sending command: {command_json}")
-            self.socket.sendall(command_json.encode('utf-8'))
-            
-            # Read response using improved handler
-            response_data = self.receive_full_response(self.socket)
-            response = json.loads(response_data.decode('utf-8'))
+            # Only one request is in flight at a time, so a different id means the stream is out of sync
+            response_id = response.pop("id", request_id)
+            if response_id != request_id:
+                logger.error(f"Response id {response_id} does not match request {request_id}")
+                self.disconnect()
+                return {
+                    "status": "error",
+                    "error": "Response does not match the request"
+                }
             
             # Log complete response for debugging
-            logger.info(f"Complete response from Unreal: {response}")
+            logger.debug(f"Complete response from Unreal: {response}")
             
             # Check for both error formats: {"status": "error", ...} and {"success": false, ...}
             if response.get("status") == "error":
@@ -175,26 +328,10 @@ class UnrealConnection:
                     "error": error_message
                 }
             
-            # Always close the connection after command is complete
-            # since Unreal will close it on its side anyway
-            try:
-                self.socket.close()
-            except:
-                pass
-            self.socket = None
-            self.connected = False
-            
             return response
             
         except Exception as e:
-            logger.error(f"Error sending command: {e}")
-            # Always reset connection state on any error
-            self.connected = False
-            try:
-                self.socket.close()
-            except:
-                pass
-            self.socket = None
+            logger.error(f"Error parsing response: {e}")
             return {
                 "status": "error",
                 "error": str(e)
@@ -212,23 +349,13 @@ def get_unreal_connection() -> Optional[UnrealConnection]:
             if not _unreal_connection.connect():
                 logger.warning("Could not connect to Unreal Engine")
                 _unreal_connection = None
-        else:
-            # Verify connection is still valid with a ping-like test
-            try:
-                # Simple test by sending an empty buffer to check if socket is still connected
-                _unreal_connection.socket.sendall(b'\x00')
-                logger.debug("Connection verified with ping test")
-            except Exception as e:
-                logger.warning(f"Existing connection failed: {e}")
-                _unreal_connection.disconnect()
+        elif not _unreal_connection.connected:
+            # Re-establish a dropped connection; send_command also retries on failure
+            if not _unreal_connection.connect():
+                logger.warning("Could not reconnect to Unreal Engine")
                 _unreal_connection = None
-                # Try to reconnect
-                _unreal_connection = UnrealConnection()
-                if not _unreal_connection.connect():
-                    logger.warning("Could not reconnect to Unreal Engine")
-                    _unreal_connection = None
-                else:
-                    logger.info("Successfully reconnected to Unreal Engine")
+            else:
+                logger.info("Successfully reconnected to Unreal Engine")
         
         return _unreal_connection
     except Exception as e:
@@ -271,6 +398,7 @@ from tools.blueprint_tools import register_blueprint_tools
 from tools.node_tools import register_blueprint_node_tools
 from tools.project_tools import register_project_tools
 from tools.umg_tools import register_umg_tools
+from tools.server_tools import register_server_tools
 
 # Register tools
 register_editor_tools(mcp)
@@ -278,6 +406,7 @@ register_blueprint_tools(mcp)
 register_blueprint_node_tools(mcp)
 register_project_tools(mcp)
 register_umg_tools(mcp)  
+register_server_tools(mcp)
 
 @mcp.prompt()
 def info():
@@ -305,19 +434,31 @@ def info():
     - `take_screenshot(filename, show_ui, resolution)` - Capture screenshots
 
     ### Actor Management
-    - `get_actors_in_level()` - List all actors in current level
-    - `find_actors_by_name(pattern)` - Find actors by name pattern
+    - `get_actors_in_level(limit=1000, cursor="", class_name="", tag="", folder="", bounds_min=None, bounds_max=None, fields=None)` - List actors in the current level a page at a time
+    - `get_level_changes_since(version, journal="", fields=None)` - Actors added, removed or modified since a level version
+    - `find_actors_by_name(pattern, mode="contains", case_sensitive=False, match=None, class_name="", limit=1000)` - Find actors by name, label, folder or tag (contains, prefix, exact, glob or regex)
+    - `find_actors_in_radius(center, radius, class_name="", limit=1000, fields=None)` - Actors near a point, nearest first
+    - `find_actors_in_box(min, max, contained=False, class_name="", limit=1000, fields=None)` - Actors overlapping a box
+    - `find_nearest_actors(location, count=1, max_distance=0, exclude=None, class_name="", fields=None)` - The k nearest actors
+    - `find_actors_on_ray(origin, direction, max_distance=1000000, limit=1, class_name="", fields=None)` - Actors a ray passes through
     - `spawn_actor(name, type, location=[0,0,0], rotation=[0,0,0], scale=[1,1,1])` - Create actors
     - `delete_actor(name)` - Remove actors
+    - `spawn_actors(type, actors=None, names=None, transforms=None, locations=None)` - Spawn many actors in one undo step
     - `set_actor_transform(name, location, rotation, scale)` - Modify actor transform
-    - `get_actor_properties(name)` - Get actor properties
+    - `set_actor_transforms(actors=None, names=None, transforms=None, locations=None)` - Move many actors in one undo step
+    - `get_actor_properties(name, fields=None)` - Get actor details, including components and editable properties
+    - `add_mesh_instances(actor_name, static_mesh, transforms=None, locations=None, instances=None)` - Scatter copies of a mesh as instances on one actor
+    - `update_mesh_instances(actor_name, indices, transforms=None, locations=None, instances=None)` - Move instances by index
+    - `remove_mesh_instances(actor_name, indices)` - Remove instances by index
+    - `get_mesh_instances(actor_name, offset=0, limit=1000)` - Read instance transforms
     
     ## Blueprint Management
-    - `create_blueprint(name, parent_class)` - Create new Blueprint classes
+    - `create_blueprint(name, parent_class)` - Create new Blueprint classes; the returned `handle` can stand in for the name in later commands
     - `add_component_to_blueprint(blueprint_name, component_type, component_name)` - Add components
     - `set_static_mesh_properties(blueprint_name, component_name, static_mesh)` - Configure meshes
     - `set_physics_properties(blueprint_name, component_name)` - Configure physics
     - `compile_blueprint(blueprint_name)` - Compile Blueprint changes
+    - `compile_blueprints(blueprints, path, mode)` - Compile many Blueprints in dependency order, with per-Blueprint errors
     - `set_blueprint_property(blueprint_name, property_name, property_value)` - Set properties
     - `set_pawn_properties(blueprint_name)` - Configure Pawn settings
     - `spawn_blueprint_actor(blueprint_name, actor_name)` - Spawn Blueprint actors
@@ -335,6 +476,14 @@ def info():
     ## Project Tools
     - `create_input_mapping(action_name, key, input_type)` - Create input mappings
     
+    ## Server Tools
+    - `batch_commands(commands, stop_on_error=True, priority="")` - Run many commands in one round trip; "$<index>.<field>" references earlier results
+    - `list_commands(category="")` - List every command the editor accepts
+    - `get_queue_stats()` - Game thread queue depth, wait times and frame budget usage
+    - `subscribe_editor_events(events=None, max_rate=0, fields=None)` - Have the editor push actor changes, blueprint compiles, asset saves and PIE sessions
+    - `get_editor_events()` - Collect pushed notifications without a round trip to the editor
+    - `unsubscribe_editor_events(subscription=0)` - Stop one or all subscriptions
+    
     ## Best Practices
     
     ### UMG Widget Development
@@ -356,13 +505,16 @@ def info():
     - Keep the viewport focused on relevant actors during operations
     
     ### Blueprint Development
-    - Compile Blueprints after changes
+    - Edits are compiled after a short idle delay or at the end of a batch; call compile_blueprint to compile straight away
     - Use meaningful names for variables and functions
     - Organize nodes logically
     - Test functionality in isolation
     - Consider performance implications
     - Document complex setups
     
+    ### Performance
+    - Group related edits (e.g. building a graph node by node) into one `batch_commands` call
+    
     ### Error Handling
     - Check command responses for success
     - Handle errors gracefully